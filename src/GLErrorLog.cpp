@@ -25,8 +25,10 @@
 #include <iostream>
 #include <iomanip>
 
+#include "GLRemoteLogShipper.h"
 #include "GLResourceMain.h"
 #include "GLTimeHelper.h"
+#include "GLTimerWheel.h"
 #include "GLErrorLog.h"
 
 /******************************************************************************/
@@ -43,6 +45,13 @@ using std::chrono::system_clock;
 /*                          D A T A  M O D E L S                              */
 /******************************************************************************/
 GLErrorLogEntry::GLErrorLogEntry()
+   :
+   m_TimeStampNs(0),
+   m_ModuleId(GLCF_NON_SYSTEM_MODULE_ID),
+   m_LevelValue(0),
+   m_Serial(0),
+   m_RepeatCount(0),
+   m_LastTimeStampNs(0)
 {
 }
 
@@ -56,7 +65,12 @@ GLErrorLogEntry::GLErrorLogEntry(
    m_TimeStampNs(ts),
    m_ModuleName(mn),
    m_Error(err),
-   m_Level(lvl)
+   m_Level(lvl),
+   m_ModuleId(GLCF_NON_SYSTEM_MODULE_ID),
+   m_LevelValue(0),
+   m_Serial(0),
+   m_RepeatCount(0),
+   m_LastTimeStampNs(ts)
 {
 }
 
@@ -111,14 +125,22 @@ GLErrorLog::GLErrorLog(GLResourceMain& resource)
    :
    m_ResourceMain(resource),
    m_ErrorLog(std::make_unique<GLELLogType>()),
+   m_History(GLELHistoryBudgetBytes),
+   m_RepeatFilter(GLLFRepeatWindowNs),
+   m_FoldTimerId(GLTWInvalidTimerId),
+   m_NextSerial(1),
    m_HeadIndex(0),
    m_TailIndex(0)
 {
+   // Folds the repeats of entries whose window closed without another
+   // occurrence to do it, on any thread.
+   m_FoldTimerId = Resource().TimerWheel().Schedule(*this, GLLFRepeatWindowNs, GLLFRepeatWindowNs);
 }
 
 /******************************************************************************/
 GLErrorLog::~GLErrorLog()
 {
+   Resource().TimerWheel().Cancel(m_FoldTimerId);
 }
 
 /******************************************************************************/
@@ -145,11 +167,35 @@ bool GLErrorLog::LogError(
       const char* error,
       GLELErrorLevels level)
 {
+   bool success = false;
+   uint64_t tsns = Resource().TimeHelper().GetTimeInNs();
+   GL_LOG_REPEAT_TYPE foldRepeats;
+
+   // Repeats within the window are only counted in this thread's table; the
+   // mutex is taken just to fold a batch of them back into the log.
+   bool suppress = m_RepeatFilter.Suppress(
+         tsns,
+         moduleId,
+         error,
+         static_cast<uint8_t>(level),
+         foldRepeats);
+
+   if (suppress && foldRepeats.repeatCount == 0)
+   {
+      return success;
+   }
+
    std::lock_guard<std::mutex> lock(m_ErrorMutex);
 
-   bool success = false;
+   if (foldRepeats.repeatCount > 0)
+   {
+      FoldRepeats(foldRepeats);
+   }
 
-   uint64_t tsns = Resource().TimeHelper().GetTimeInNs();
+   if (suppress)
+   {
+      return success;
+   }
    std::string moduleName =
          GLErrorLogEntry::GetFixedWidthString(
                m_theModuleNameMap.at(moduleId),
@@ -165,11 +211,26 @@ bool GLErrorLog::LogError(
 
    GLErrorLogEntry newEntry(tsns, moduleName, errorText, errorLevel);
 
+   newEntry.m_ModuleId = moduleId;
+   newEntry.m_LevelValue = static_cast<uint8_t>(level);
+   newEntry.m_Serial = m_NextSerial++;
    ErrorLog().at(m_HeadIndex) = newEntry;
+   m_RepeatFilter.TrackEntry(m_HeadIndex, newEntry.m_Serial);
+
+   for (GLLogRingPtr& logRing : m_LogRings)
+   {
+      logRing->Append(tsns, moduleId, static_cast<uint8_t>(level), error);
+   }
+
+   if (GLELRemoteLoggingEnabled)
+   {
+      SendLogErrorEntryToRemoteLogger(tsns, moduleId, error, static_cast<uint8_t>(level));
+   }
 
    IncrementBufferPointer(m_HeadIndex, GLELErrorLogSize);
    if (m_HeadIndex == m_TailIndex)
    {  // Tail should point at the oldest available message
+      SpillEntry(ErrorLog()[m_TailIndex]);
       IncrementBufferPointer(m_TailIndex, GLELErrorLogSize);
    }
 
@@ -181,6 +242,18 @@ void GLErrorLog::PrintErrorLogEntries()
 {
    std::lock_guard<std::mutex> lock(m_ErrorMutex);
 
+   GL_LOG_REPEAT_TYPE foldRepeats;
+   while (m_RepeatFilter.TakePendingRepeats(foldRepeats))
+   {
+      FoldRepeats(foldRepeats);
+   }
+
+   if (m_History.EntryCount() > 0)
+   {
+      printf("\n\n***** ERROR LOG HISTORY *****\n");
+      PrintHistoryEntries(0, GLLHAllTimeNs);
+   }
+
    uint32_t tailIndex = m_TailIndex;
 
    printf("\n\n***** ERROR LOG *****\n");
@@ -188,15 +261,54 @@ void GLErrorLog::PrintErrorLogEntries()
    {
       std::string entryString = GetEntryString(ErrorLog()[tailIndex]);
       printf("%s\n", entryString.c_str());
-      if (GLELRemoteLoggingEnabled)
-      {
-         SendLogErrorEntryToRemoteLogger(entryString);
-      }
       IncrementBufferPointer(tailIndex, GLELErrorLogSize);
    }
    printf("\n\n\n");
 }
 
+/******************************************************************************/
+void GLErrorLog::PrintErrorLogHistory(uint64_t fromNs, uint64_t toNs)
+{
+   std::lock_guard<std::mutex> lock(m_ErrorMutex);
+
+   printf("\n\n***** ERROR LOG HISTORY *****\n");
+   PrintHistoryEntries(fromNs, toNs);
+   printf("\n\n\n");
+}
+
+/******************************************************************************/
+void GLErrorLog::PrintHistoryEntries(uint64_t fromNs, uint64_t toNs)
+{
+   // Called with the mutex held.
+   m_History.VisitEntries(fromNs, toNs, [this](const GL_LOG_HISTORY_ENTRY_TYPE& historyEntry)
+         {
+            auto moduleName = m_theModuleNameMap.find(
+                  static_cast<GLCFModuleIds>(historyEntry.m_ModuleId));
+
+            GLErrorLogEntry entry(
+                  historyEntry.m_TimeStampNs,
+                  GLErrorLogEntry::GetFixedWidthString(
+                        (moduleName != m_theModuleNameMap.end()) ? moduleName->second : GLCFUnknownModuleName,
+                        GLEL_MODULE_NAME),
+                  GLErrorLogEntry::GetFixedWidthString(
+                        std::string(historyEntry.m_Text),
+                        GLEL_ERROR_STR),
+                  GLErrorLogEntry::GetFixedWidthString(
+                        std::to_string(historyEntry.m_Level),
+                        GLEL_ERROR_LEVEL_STR));
+            entry.m_RepeatCount = historyEntry.m_RepeatCount;
+            entry.m_LastTimeStampNs = historyEntry.m_LastTimeStampNs;
+
+            std::string entryString = GetEntryString(entry);
+            printf("%s\n", entryString.c_str());
+         });
+
+   if (m_History.DroppedEntries() > 0)
+   {
+      printf("(%lu older entries dropped from the history)\n", m_History.DroppedEntries());
+   }
+}
+
 /******************************************************************************/
 std::shared_ptr<std::vector<GLErrorLogEntry*>> GLErrorLog::GetTempErrorEntries()
 {
@@ -227,9 +339,87 @@ const std::string GLErrorLog::GetEntryString(GLErrorLogEntry& entry)
          GLErrorLogEntry::GetFixedWidthString(entry.m_Error, GLEL_ERROR_STR) +
          GLErrorLogEntry::GetFixedWidthString(entry.m_Level, GLEL_ERROR_LEVEL_STR);
 
+   if (entry.m_RepeatCount > 0)
+   {
+      entryString += " [repeated " + std::to_string(entry.m_RepeatCount) +
+         " times, last " + TimeHelper().ConvertNsIntoTimeStampUs(entry.m_LastTimeStampNs) + "]";
+   }
+
    return entryString;
 }
 
+/******************************************************************************/
+void GLErrorLog::SpillEntry(GLErrorLogEntry& entry)
+{
+   // Called with the mutex held when the entry drops out of the ring.  The
+   // stored text is padded to the print width; only the message is kept.
+   std::string_view text(entry.m_Error);
+   text = text.substr(0, text.find_last_not_of(' ') + 1);
+
+   m_History.Append(
+         entry.m_TimeStampNs,
+         static_cast<uint16_t>(entry.m_ModuleId),
+         entry.m_LevelValue,
+         text,
+         entry.m_RepeatCount,
+         entry.m_LastTimeStampNs);
+}
+
+/******************************************************************************/
+void GLErrorLog::FoldRepeats(GL_LOG_REPEAT_TYPE& foldRepeats)
+{
+   // Called with the mutex held.  The entry may have been overwritten since
+   // the repeats were counted, then they age out together with it.
+   GLErrorLogEntry& entry = ErrorLog().at(foldRepeats.entryIndex);
+   if (entry.m_Serial == foldRepeats.entrySerial)
+   {
+      entry.m_RepeatCount += foldRepeats.repeatCount;
+      entry.m_LastTimeStampNs = foldRepeats.lastTimeStampNs;
+   }
+}
+
+/******************************************************************************/
+bool GLErrorLog::OpenMappedLog(const std::string& path, uint32_t capacity)
+{
+   std::lock_guard<std::mutex> lock(m_ErrorMutex);
+
+   auto logRing = std::make_unique<GLLogRing>();
+   bool success = logRing->MapFile(path, capacity, GLLR_SOURCE_ERROR_LOG);
+   if (success)
+   {
+      m_LogRings.push_back(std::move(logRing));
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+bool GLErrorLog::OpenSharedLog(const std::string& name, uint32_t capacity)
+{
+   std::lock_guard<std::mutex> lock(m_ErrorMutex);
+
+   auto logRing = std::make_unique<GLLogRing>();
+   bool success = logRing->MapSharedMemory(name, capacity, GLLR_SOURCE_ERROR_LOG);
+   if (success)
+   {
+      m_LogRings.push_back(std::move(logRing));
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+void GLErrorLog::CloseLogRings()
+{
+   std::lock_guard<std::mutex> lock(m_ErrorMutex);
+
+   for (GLLogRingPtr& logRing : m_LogRings)
+   {
+      logRing->Flush();
+   }
+   m_LogRings.clear();
+}
+
 /******************************************************************************/
 void GLErrorLog::IncrementBufferPointer(
       uint32_t& bufferPointer,
@@ -246,33 +436,32 @@ void GLErrorLog::IncrementBufferPointer(
 }
 
 /******************************************************************************/
-bool GLErrorLog::SendLogErrorEntryToRemoteLogger(std::string& entryString)
+bool GLErrorLog::SendLogErrorEntryToRemoteLogger(
+      uint64_t timeStampNs,
+      GLCFModuleIds moduleId,
+      const char* text,
+      uint8_t level)
 {
-   bool success = false;
-
-#ifdef nodef
-   std::array<uint8_t, IONW_SOCKET_FIXED_MESSAGE_LEN>& buffer =
-         TcpHelper().BufferOut();
-   buffer.fill(0x00);
+   // Queued for the shipper thread; the network is never touched here.
+   return Resource().RemoteLogShipper().QueueEntry(
+         GLRL_SOURCE_ERROR_LOG,
+         timeStampNs,
+         moduleId,
+         level,
+         text);
+}
+/******************************************************************************/
+/*               T I M E R  W H E E L  I N T F  M E T H O D S                 */
+/******************************************************************************/
+void GLErrorLog::EventTimerExpired(GLTimerId, uint64_t)
+{
+   std::lock_guard<std::mutex> lock(m_ErrorMutex);
 
-   if (entryString.size() < IONW_SOCKET_FIXED_MESSAGE_LEN - 2)
+   GL_LOG_REPEAT_TYPE foldRepeats;
+   while (m_RepeatFilter.TakeExpiredRepeats(TimeHelper().GetTimeInNs(), foldRepeats))
    {
-      buffer[0] = entryString.size() + 1;
-      std::strcpy((char*)&buffer[1], entryString.c_str());
-      success = TcpHelper().SendToServer(buffer);
-
-      if (!success)
-      {
-         printf("ERROR: SendTraceLogEntryToRemoteLogger() send failed.\n");
-      }
+      FoldRepeats(foldRepeats);
    }
-   else
-   {
-      printf("ERROR: SendTraceLogEntryToRemoteLogger -> buffer too small.");
-   }
-
-#endif
-
-   return success;
 }
+
 /******************************************************************************/
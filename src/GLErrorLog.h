@@ -28,6 +28,10 @@
 
 #include "GLConfigureDomains.h"
 #include "GLConfigureSystemModules.h"
+#include "GLLogHistory.h"
+#include "GLLogRepeatFilter.h"
+#include "GLLogRing.h"
+#include "GLTimerWheelIntf.h"
 #include "GLTypedefs.h"
 
 namespace MDN
@@ -68,6 +72,19 @@ const uint32_t GLELLogSize = 100;
 
 const uint16_t GLELErrorLogSize = 100;
 
+// Crash survivable copy of the error log kept in a memory mapped file.
+const bool GLELMappedLogEnabled = false;
+const uint32_t GLELMappedLogSize = 2048;
+static const std::string GLELMappedLogFilePath("ucrp_error_log.ring");
+
+// Compact history of the entries aged out of the error log.
+const size_t GLELHistoryBudgetBytes = 24 * 1024;
+
+// Copy of the error log published in POSIX shared memory for ucrp-tail.
+const bool GLELSharedLogEnabled = true;
+const uint32_t GLELSharedLogSize = 512;
+static const std::string GLELSharedLogName("/ucrp_error_log");
+
 /******************************************************************************/
 /*                         D E C L A R A T I O N S                            */
 /******************************************************************************/
@@ -94,13 +111,18 @@ class GLErrorLogEntry
       std::string m_ModuleName;
       std::string m_Error;
       std::string m_Level;
+      GLCFModuleIds m_ModuleId;
+      uint8_t m_LevelValue;
+      uint64_t m_Serial;
+      uint32_t m_RepeatCount;
+      uint64_t m_LastTimeStampNs;
 };
 
 using GLELLogType = std::array<GLErrorLogEntry, GLELLogSize>;
 using GLELLogPtrType = std::unique_ptr<GLELLogType>;
 
 /******************************************************************************/
-class GLErrorLog
+class GLErrorLog : public GLTimerWheelIntf
 {
    public:
       GLErrorLog(GLResourceMain& resource);
@@ -112,20 +134,39 @@ class GLErrorLog
             GLELErrorLevels level);
       const std::string GetEntryString(GLErrorLogEntry& entry);
       void PrintErrorLogEntries();
+      void PrintErrorLogHistory(uint64_t fromNs, uint64_t toNs);
       std::shared_ptr<std::vector<GLErrorLogEntry*>> GetTempErrorEntries();
+      bool OpenMappedLog(const std::string& path, uint32_t capacity);
+      bool OpenSharedLog(const std::string& name, uint32_t capacity);
+      void CloseLogRings();
+
+      // T I M E R  W H E E L  I N T E R F A C E
+      void EventTimerExpired(GLTimerId timerId, uint64_t context) override;
 
    private:
       void IncrementBufferPointer(
             uint32_t& bufferPointer,
             const uint32_t bufferLen);
-      bool SendLogErrorEntryToRemoteLogger(std::string& entryString);
-
+      bool SendLogErrorEntryToRemoteLogger(
+            uint64_t timeStampNs,
+            GLCFModuleIds moduleId,
+            const char* text,
+            uint8_t level);
+
+      void FoldRepeats(GL_LOG_REPEAT_TYPE& foldRepeats);
+      void SpillEntry(GLErrorLogEntry& entry);
+      void PrintHistoryEntries(uint64_t fromNs, uint64_t toNs);
       GLResourceMain& Resource();
       GLTimeHelper& TimeHelper();
       GLELLogType& ErrorLog();
 
       GLResourceMain& m_ResourceMain;
       GLELLogPtrType m_ErrorLog;
+      std::vector<GLLogRingPtr> m_LogRings;
+      GLLogHistory m_History;
+      GLLogRepeatFilter m_RepeatFilter;
+      GLTimerId m_FoldTimerId;
+      uint64_t m_NextSerial;
       uint32_t m_HeadIndex;
       uint32_t m_TailIndex;
       std::mutex m_ErrorMutex;
@@ -27,6 +27,10 @@
 
 #include "GLConfigureDomains.h"
 #include "GLConfigureSystemModules.h"
+#include "GLLogHistory.h"
+#include "GLLogRepeatFilter.h"
+#include "GLLogRing.h"
+#include "GLTimerWheelIntf.h"
 #include "GLTypedefs.h"
 
 /******************************************************************************/
@@ -71,6 +75,19 @@ const uint32_t GLEVEventLogGetEntryStringMaxSize = 255;
 const uint32_t GLEVLogSize = 200;
 
 const uint16_t GLEVEventLogSize = 200;
+
+// Crash survivable copy of the event log kept in a memory mapped file.
+const bool GLEVMappedLogEnabled = false;
+const uint32_t GLEVMappedLogSize = 4096;
+static const std::string GLEVMappedLogFilePath("ucrp_event_log.ring");
+
+// Compact history of the entries aged out of the event log.
+const size_t GLEVHistoryBudgetBytes = 48 * 1024;
+
+// Copy of the event log published in POSIX shared memory for ucrp-tail.
+const bool GLEVSharedLogEnabled = true;
+const uint32_t GLEVSharedLogSize = 1024;
+static const std::string GLEVSharedLogName("/ucrp_event_log");
 }
 
 /******************************************************************************/
@@ -102,13 +119,18 @@ class GLEventLogEntry
       std::string m_ModuleName;
       std::string m_Event;
       std::string m_Level;
+      GLCFModuleIds m_ModuleId;
+      uint8_t m_LevelValue;
+      uint64_t m_Serial;
+      uint32_t m_RepeatCount;
+      uint64_t m_LastTimeStampNs;
 };
 
 using GLEVLogType = std::array<GLEventLogEntry, GLEVLogSize>;
 using GLEVLogPtrType = std::unique_ptr<GLEVLogType>;
 
 /******************************************************************************/
-class GLEventLog
+class GLEventLog : public GLTimerWheelIntf
 {
    public:
       GLEventLog(GLResourceMain& resource);
@@ -120,21 +142,39 @@ class GLEventLog
             GLEVEventLevels level);
       const std::string GetEntryString(GLEventLogEntry& entry);
       void PrintEventLogEntries();
+      void PrintEventLogHistory(uint64_t fromNs, uint64_t toNs);
       std::shared_ptr<std::vector<GLEventLogEntry*>> GetTempEventEntries();
+      bool OpenMappedLog(const std::string& path, uint32_t capacity);
+      bool OpenSharedLog(const std::string& name, uint32_t capacity);
+      void CloseLogRings();
 
+      // T I M E R  W H E E L  I N T E R F A C E
+      void EventTimerExpired(GLTimerId timerId, uint64_t context) override;
 
    private:
-      bool SendEventLogEntryToRemoteLogger(std::string& entryString);
+      bool SendEventLogEntryToRemoteLogger(
+            uint64_t timeStampNs,
+            GLCFModuleIds moduleId,
+            const char* text,
+            uint8_t level);
       void IncrementBufferPointer(
             uint32_t& bufferPointer,
             const uint32_t bufferLen);
 
+      void FoldRepeats(GL_LOG_REPEAT_TYPE& foldRepeats);
+      void SpillEntry(GLEventLogEntry& entry);
+      void PrintHistoryEntries(uint64_t fromNs, uint64_t toNs);
       GLResourceMain& Resource();
       GLTimeHelper& TimeHelper();
       GLEVLogType& EventLog();
 
       GLResourceMain& m_ResourceMain;
       GLEVLogPtrType m_EventLog;
+      std::vector<GLLogRingPtr> m_LogRings;
+      GLLogHistory m_History;
+      GLLogRepeatFilter m_RepeatFilter;
+      GLTimerId m_FoldTimerId;
+      uint64_t m_NextSerial;
       uint32_t m_HeadIndex;
       uint32_t m_TailIndex;
       std::mutex m_Mutex;
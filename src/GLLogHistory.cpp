@@ -0,0 +1,425 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogHistory.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the compact log history.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+
+#include "GLLogHistory.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint64_t GLLHFlagNewKey = 0x01;
+static const uint64_t GLLHFlagRepeats = 0x02;
+static const uint64_t GLLHFlagArguments = 0x04;
+static const uint32_t GLLHFlagBits = 3;
+static const uint32_t GLLHNoKey = UINT32_MAX;
+static const uint32_t GLLHKeyPrefixBytes = 3;
+
+// Stands in for a number taken out of the text into the entry itself.
+static const char GLLHArgumentMarker = '\x1F';
+static const size_t GLLHMaximumArgumentDigits = 18;
+static const uint32_t GLLHMaximumVarintBytes = 10;
+
+// Worst case encoded entry without arguments: header, key id, repeat count,
+// repeat delta and argument count.
+static const uint32_t GLLHMaximumEntryBytes = 10 + 5 + 5 + 10 + 5;
+
+// Lookup map node and bucket, on top of the key record itself.
+static const size_t GLLHKeyOverheadBytes = 48;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static void PutVarint(std::vector<uint8_t>& bytes, uint64_t value)
+{
+   while (value >= 0x80)
+   {
+      bytes.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+   }
+   bytes.push_back(static_cast<uint8_t>(value));
+}
+
+/******************************************************************************/
+static uint64_t GetVarint(const uint8_t*& cursor)
+{
+   uint64_t value = 0;
+   uint32_t shift = 0;
+
+   while (*cursor & 0x80)
+   {
+      value |= static_cast<uint64_t>(*cursor++ & 0x7F) << shift;
+      shift += 7;
+   }
+   value |= static_cast<uint64_t>(*cursor++) << shift;
+
+   return value;
+}
+
+/******************************************************************************/
+static uint64_t ZigZag(int64_t value)
+{
+   // Log calls take their timestamp before the log mutex, so two threads can
+   // store entries slightly out of order.
+   return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/******************************************************************************/
+static int64_t UnZigZag(uint64_t value)
+{
+   return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLLogHistory::GLLogHistory(size_t budgetBytes)
+   :
+   m_BudgetBytes(budgetBytes),
+   m_KeyBytes(0),
+   m_PreviousTimeStampUs(0),
+   m_PreviousKeyId(GLLHNoKey),
+   m_EntryCount(0),
+   m_DroppedEntries(0)
+{
+}
+
+/******************************************************************************/
+GLLogHistory::~GLLogHistory()
+{
+}
+
+/******************************************************************************/
+void GLLogHistory::BuildKey(
+      uint16_t moduleId,
+      uint8_t level,
+      std::string_view text)
+{
+   // The scratch buffers keep their capacity, so this does not allocate once
+   // they have grown.  Decimal numbers are taken out of the text so messages
+   // that only differ in an id or a count share one key.  Numbers with a
+   // leading zero stay in the text to keep it exact.
+   m_KeyScratch.assign(1, static_cast<char>(moduleId >> 8));
+   m_KeyScratch.push_back(static_cast<char>(moduleId & 0xFF));
+   m_KeyScratch.push_back(static_cast<char>(level));
+   m_Arguments.clear();
+
+   if (text.find(GLLHArgumentMarker) != std::string_view::npos)
+   {
+      m_KeyScratch.append(text);
+      return;
+   }
+
+   size_t index = 0;
+   while (index < text.size())
+   {
+      size_t end = index;
+      while (end < text.size() && text[end] >= '0' && text[end] <= '9')
+      {
+         end++;
+      }
+
+      size_t digits = end - index;
+      if (digits > 0 &&
+         digits <= GLLHMaximumArgumentDigits &&
+         (text[index] != '0' || digits == 1))
+      {
+         uint64_t value = 0;
+         for (size_t digit = index; digit < end; digit++)
+         {
+            value = value * 10 + static_cast<uint64_t>(text[digit] - '0');
+         }
+         m_Arguments.push_back(value);
+         m_KeyScratch.push_back(GLLHArgumentMarker);
+         index = end;
+      }
+      else if (digits > 0)
+      {
+         m_KeyScratch.append(text.substr(index, digits));
+         index = end;
+      }
+      else
+      {
+         m_KeyScratch.push_back(text[index++]);
+      }
+   }
+}
+
+/******************************************************************************/
+uint32_t GLLogHistory::InternKey()
+{
+   uint32_t keyId;
+   auto iter = m_KeyIds.find(std::string_view(m_KeyScratch));
+   if (iter != m_KeyIds.end())
+   {
+      keyId = iter->second;
+   }
+   else
+   {
+      if (!m_FreeKeyIds.empty())
+      {
+         keyId = m_FreeKeyIds.back();
+         m_FreeKeyIds.pop_back();
+      }
+      else
+      {
+         keyId = static_cast<uint32_t>(m_Keys.size());
+         m_Keys.emplace_back();
+      }
+
+      GL_LOG_HISTORY_KEY_TYPE& key = m_Keys[keyId];
+      key.key = m_KeyScratch;
+      key.refCount = 0;
+      m_KeyIds.emplace(std::string_view(key.key), keyId);
+      m_KeyBytes += sizeof(GL_LOG_HISTORY_KEY_TYPE) + key.key.capacity() + GLLHKeyOverheadBytes;
+   }
+
+   m_Keys[keyId].refCount++;
+
+   return keyId;
+}
+
+/******************************************************************************/
+void GLLogHistory::ReleaseKey(uint32_t keyId)
+{
+   GL_LOG_HISTORY_KEY_TYPE& key = m_Keys[keyId];
+
+   if (--key.refCount == 0)
+   {
+      m_KeyIds.erase(std::string_view(key.key));
+      m_KeyBytes -= sizeof(GL_LOG_HISTORY_KEY_TYPE) + key.key.capacity() + GLLHKeyOverheadBytes;
+      std::string().swap(key.key);
+      m_FreeKeyIds.push_back(keyId);
+   }
+}
+
+/******************************************************************************/
+void GLLogHistory::StartBlock(uint64_t timeStampUs)
+{
+   m_Blocks.emplace_back();
+
+   GL_LOG_HISTORY_BLOCK_TYPE& block = m_Blocks.back();
+   block.firstTimeStampUs = timeStampUs;
+   block.minimumTimeStampUs = timeStampUs;
+   block.maximumTimeStampUs = timeStampUs;
+   block.entryCount = 0;
+   block.bytes.reserve(GLLHBlockSizeBytes);
+
+   m_PreviousTimeStampUs = timeStampUs;
+   m_PreviousKeyId = GLLHNoKey;
+}
+
+/******************************************************************************/
+void GLLogHistory::DropOldestBlock()
+{
+   GL_LOG_HISTORY_BLOCK_TYPE& block = m_Blocks.front();
+
+   DecodeBlock(block, [this](uint32_t keyId, uint64_t, uint32_t, uint64_t)
+         {
+            ReleaseKey(keyId);
+         });
+
+   m_DroppedEntries += block.entryCount;
+   m_EntryCount -= block.entryCount;
+   m_Blocks.pop_front();
+}
+
+/******************************************************************************/
+template <typename Visitor>
+void GLLogHistory::DecodeBlock(GL_LOG_HISTORY_BLOCK_TYPE& block, Visitor visit)
+{
+   const uint8_t* cursor = block.bytes.data();
+   uint64_t timeStampUs = block.firstTimeStampUs;
+   uint32_t keyId = GLLHNoKey;
+
+   for (uint32_t index = 0; index < block.entryCount; index++)
+   {
+      uint64_t header = GetVarint(cursor);
+      timeStampUs += UnZigZag(header >> GLLHFlagBits);
+
+      if (header & GLLHFlagNewKey)
+      {
+         keyId = static_cast<uint32_t>(GetVarint(cursor));
+      }
+
+      uint32_t repeatCount = 0;
+      uint64_t lastTimeStampUs = timeStampUs;
+      if (header & GLLHFlagRepeats)
+      {
+         repeatCount = static_cast<uint32_t>(GetVarint(cursor));
+         lastTimeStampUs += GetVarint(cursor);
+      }
+
+      m_Arguments.clear();
+      if (header & GLLHFlagArguments)
+      {
+         uint64_t argumentCount = GetVarint(cursor);
+         for (uint64_t argument = 0; argument < argumentCount; argument++)
+         {
+            m_Arguments.push_back(GetVarint(cursor));
+         }
+      }
+
+      visit(keyId, timeStampUs, repeatCount, lastTimeStampUs);
+   }
+}
+
+/******************************************************************************/
+void GLLogHistory::Append(
+      uint64_t timeStampNs,
+      uint16_t moduleId,
+      uint8_t level,
+      std::string_view text,
+      uint32_t repeatCount,
+      uint64_t lastTimeStampNs)
+{
+   // The log prints microseconds, so nothing visible is lost here.
+   uint64_t timeStampUs = timeStampNs / 1000;
+   uint64_t lastTimeStampUs = lastTimeStampNs / 1000;
+
+   BuildKey(moduleId, level, text);
+
+   size_t entryBytes = GLLHMaximumEntryBytes + m_Arguments.size() * GLLHMaximumVarintBytes;
+   if (m_Blocks.empty() ||
+      m_Blocks.back().bytes.size() + entryBytes > GLLHBlockSizeBytes)
+   {
+      StartBlock(timeStampUs);
+   }
+
+   GL_LOG_HISTORY_BLOCK_TYPE& block = m_Blocks.back();
+   uint32_t keyId = InternKey();
+   uint64_t header = ZigZag(static_cast<int64_t>(timeStampUs - m_PreviousTimeStampUs)) << GLLHFlagBits;
+
+   if (keyId != m_PreviousKeyId)
+   {
+      header |= GLLHFlagNewKey;
+   }
+   if (repeatCount > 0)
+   {
+      header |= GLLHFlagRepeats;
+   }
+   if (!m_Arguments.empty())
+   {
+      header |= GLLHFlagArguments;
+   }
+
+   PutVarint(block.bytes, header);
+   if (header & GLLHFlagNewKey)
+   {
+      PutVarint(block.bytes, keyId);
+   }
+   if (header & GLLHFlagRepeats)
+   {
+      PutVarint(block.bytes, repeatCount);
+      PutVarint(block.bytes, (lastTimeStampUs > timeStampUs) ? lastTimeStampUs - timeStampUs : 0);
+   }
+   if (header & GLLHFlagArguments)
+   {
+      PutVarint(block.bytes, m_Arguments.size());
+      for (uint64_t argument : m_Arguments)
+      {
+         PutVarint(block.bytes, argument);
+      }
+   }
+
+   block.entryCount++;
+   block.minimumTimeStampUs = std::min(block.minimumTimeStampUs, timeStampUs);
+   block.maximumTimeStampUs = std::max(block.maximumTimeStampUs, timeStampUs);
+   m_PreviousTimeStampUs = timeStampUs;
+   m_PreviousKeyId = keyId;
+   m_EntryCount++;
+
+   // The block being filled is always kept, whatever its keys cost.
+   while (m_Blocks.size() > 1 && MemoryBytes() > m_BudgetBytes)
+   {
+      DropOldestBlock();
+   }
+}
+
+/******************************************************************************/
+void GLLogHistory::VisitEntries(
+      uint64_t fromNs,
+      uint64_t toNs,
+      const std::function<void(const GL_LOG_HISTORY_ENTRY_TYPE&)>& visitor)
+{
+   uint64_t fromUs = fromNs / 1000;
+   uint64_t toUs = toNs / 1000;
+
+   for (GL_LOG_HISTORY_BLOCK_TYPE& block : m_Blocks)
+   {
+      if (block.maximumTimeStampUs < fromUs || block.minimumTimeStampUs > toUs)
+      {
+         continue;
+      }
+
+      DecodeBlock(block, [&](uint32_t keyId, uint64_t timeStampUs, uint32_t repeatCount, uint64_t lastTimeStampUs)
+            {
+               if (timeStampUs < fromUs || timeStampUs > toUs)
+               {
+                  return;
+               }
+
+               const std::string& key = m_Keys[keyId].key;
+               m_TextScratch.clear();
+               size_t argument = 0;
+               for (size_t index = GLLHKeyPrefixBytes; index < key.size(); index++)
+               {
+                  if (key[index] == GLLHArgumentMarker && argument < m_Arguments.size())
+                  {
+                     m_TextScratch.append(std::to_string(m_Arguments[argument++]));
+                  }
+                  else
+                  {
+                     m_TextScratch.push_back(key[index]);
+                  }
+               }
+
+               GL_LOG_HISTORY_ENTRY_TYPE entry;
+               entry.m_TimeStampNs = timeStampUs * 1000;
+               entry.m_ModuleId = static_cast<uint16_t>(
+                     (static_cast<uint8_t>(key[0]) << 8) | static_cast<uint8_t>(key[1]));
+               entry.m_Level = static_cast<uint8_t>(key[2]);
+               entry.m_Text = m_TextScratch;
+               entry.m_RepeatCount = repeatCount;
+               entry.m_LastTimeStampNs = lastTimeStampUs * 1000;
+               visitor(entry);
+            });
+   }
+}
+
+/******************************************************************************/
+uint64_t GLLogHistory::EntryCount()
+{
+   return m_EntryCount;
+}
+
+/******************************************************************************/
+uint64_t GLLogHistory::DroppedEntries()
+{
+   return m_DroppedEntries;
+}
+
+/******************************************************************************/
+size_t GLLogHistory::MemoryBytes()
+{
+   return m_Blocks.size() * (sizeof(GL_LOG_HISTORY_BLOCK_TYPE) + GLLHBlockSizeBytes) + m_KeyBytes;
+}
+
+/******************************************************************************/
@@ -0,0 +1,153 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogHistory.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the compact log history.  Entries
+   that age out of the event / error log rings are spilled here and kept in
+   a fixed memory budget.
+
+   Every distinct (module, level, text) is interned once as a key, with the
+   decimal numbers in the text replaced by a marker and stored with the
+   entry instead.  An entry is then encoded into a block as a varint holding
+   the zigzag timestamp delta to the previous entry in microseconds plus
+   three flag bits, followed by the key id only when it differs from the
+   previous entry, and by the repeat count and numbers when it has any.  A
+   steady stream of entries costs two to four bytes each.  When the budget
+   is exceeded the oldest block is dropped together with keys nobody uses.
+*/
+/******************************************************************************/
+#ifndef gl_log_history_h
+#define gl_log_history_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GLConfigureSystemModules.h"
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const uint32_t GLLHBlockSizeBytes = 2048;
+const uint64_t GLLHAllTimeNs = UINT64_MAX;
+
+}
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+namespace MDN
+{
+
+// Handed to the visitor of VisitEntries().  m_Text is only valid during the
+// call.
+typedef struct gl_log_history_entry_struct
+{
+   uint64_t m_TimeStampNs;
+   uint16_t m_ModuleId;
+   uint8_t m_Level;
+   std::string_view m_Text;
+   uint32_t m_RepeatCount;
+   uint64_t m_LastTimeStampNs;
+} GL_LOG_HISTORY_ENTRY_TYPE;
+
+typedef struct gl_log_history_key_struct
+{
+   // Module id (2 bytes), level (1 byte) and then the text.  The lookup map
+   // holds views into this string, so it is never moved once interned.
+   std::string key;
+   uint32_t refCount;
+} GL_LOG_HISTORY_KEY_TYPE;
+
+typedef struct gl_log_history_block_struct
+{
+   uint64_t firstTimeStampUs;
+   uint64_t minimumTimeStampUs;
+   uint64_t maximumTimeStampUs;
+   uint32_t entryCount;
+   std::vector<uint8_t> bytes;
+} GL_LOG_HISTORY_BLOCK_TYPE;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class GLLogHistory
+{
+   public:
+      GLLogHistory(size_t budgetBytes);
+      ~GLLogHistory();
+
+      // Not thread safe; the owning log calls these with its mutex held.
+      void Append(
+            uint64_t timeStampNs,
+            uint16_t moduleId,
+            uint8_t level,
+            std::string_view text,
+            uint32_t repeatCount,
+            uint64_t lastTimeStampNs);
+
+      // Visits the entries with fromNs <= timestamp <= toNs, oldest first.
+      void VisitEntries(
+            uint64_t fromNs,
+            uint64_t toNs,
+            const std::function<void(const GL_LOG_HISTORY_ENTRY_TYPE&)>& visitor);
+
+      uint64_t EntryCount();
+      uint64_t DroppedEntries();
+      size_t MemoryBytes();
+
+   private:
+      void BuildKey(uint16_t moduleId, uint8_t level, std::string_view text);
+      uint32_t InternKey();
+      void ReleaseKey(uint32_t keyId);
+      void StartBlock(uint64_t timeStampUs);
+      void DropOldestBlock();
+
+      template <typename Visitor>
+      void DecodeBlock(GL_LOG_HISTORY_BLOCK_TYPE& block, Visitor visit);
+
+      const size_t m_BudgetBytes;
+      size_t m_KeyBytes;
+      std::deque<GL_LOG_HISTORY_BLOCK_TYPE> m_Blocks;
+      std::deque<GL_LOG_HISTORY_KEY_TYPE> m_Keys;
+      std::vector<uint32_t> m_FreeKeyIds;
+      std::unordered_map<std::string_view, uint32_t> m_KeyIds;
+      std::string m_KeyScratch;
+      std::string m_TextScratch;
+      std::vector<uint64_t> m_Arguments;
+      uint64_t m_PreviousTimeStampUs;
+      uint32_t m_PreviousKeyId;
+      uint64_t m_EntryCount;
+      uint64_t m_DroppedEntries;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_log_history_h */
@@ -0,0 +1,273 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogRepeatFilter.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the log repeat filter.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <set>
+
+#include "GLLogRepeatFilter.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint64_t GLLFHashOffsetBasis = 0xcbf29ce484222325;
+static const uint64_t GLLFHashPrime = 0x100000001b3;
+
+/******************************************************************************/
+/*                          D A T A  M O D E L S                              */
+/******************************************************************************/
+typedef struct gl_log_repeat_slot_struct
+{
+   uint64_t ownerId;
+   uint64_t hash;
+   uint64_t firstTimeStampNs;
+   uint64_t lastTimeStampNs;
+   uint32_t pendingRepeats;
+   uint32_t entryIndex;
+   uint64_t entrySerial;
+   bool tracked;
+} GL_LOG_REPEAT_SLOT_TYPE;
+
+using GLLFThreadSlotsType = std::array<GL_LOG_REPEAT_SLOT_TYPE, GLLFThreadSlots>;
+
+// The slots of one thread for one filter.  The mutex is taken by the owning
+// thread and by a reader draining the repeats of all threads.
+struct GLLogRepeatFilter::gl_log_repeat_table_struct
+{
+   std::mutex mutex;
+   GLLFThreadSlotsType slots{};
+   GL_LOG_REPEAT_SLOT_TYPE* lastSlot = nullptr;
+};
+
+typedef struct gl_log_repeat_thread_struct
+{
+   uint64_t ownerId = 0;
+   void* table = nullptr;
+} GL_LOG_REPEAT_THREAD_TYPE;
+
+/******************************************************************************/
+/*       G L O B A L  V A R S                                                 */
+/******************************************************************************/
+static std::atomic<uint64_t> m_theNextFilterId(1);
+
+// The filters alive; a thread drops its entries of the others.
+static std::mutex m_theLiveFiltersMutex;
+static std::set<uint64_t> m_theLiveFilters;
+
+// This thread's table of each filter (event log, error log, ... of every
+// GLResourceMain), owned by the filter.
+static thread_local std::vector<GL_LOG_REPEAT_THREAD_TYPE> m_theThreadTables;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static void TakeSlotRepeats(
+      GL_LOG_REPEAT_SLOT_TYPE& slot,
+      GL_LOG_REPEAT_TYPE& foldRepeats)
+{
+   foldRepeats.entryIndex = slot.entryIndex;
+   foldRepeats.entrySerial = slot.entrySerial;
+   foldRepeats.repeatCount = slot.pendingRepeats;
+   foldRepeats.lastTimeStampNs = slot.lastTimeStampNs;
+   slot.pendingRepeats = 0;
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLLogRepeatFilter::GLLogRepeatFilter(uint64_t windowNs)
+   :
+   m_FilterId(m_theNextFilterId.fetch_add(1)),
+   m_WindowNs(windowNs)
+{
+   std::lock_guard<std::mutex> lock(m_theLiveFiltersMutex);
+   m_theLiveFilters.insert(m_FilterId);
+}
+
+/******************************************************************************/
+GLLogRepeatFilter::~GLLogRepeatFilter()
+{
+   std::lock_guard<std::mutex> lock(m_theLiveFiltersMutex);
+   m_theLiveFilters.erase(m_FilterId);
+}
+
+/******************************************************************************/
+uint64_t GLLogRepeatFilter::EntryHash(
+      GLCFModuleIds moduleId,
+      const char* text,
+      uint8_t level)
+{
+   uint64_t hash = GLLFHashOffsetBasis;
+
+   hash = (hash ^ static_cast<uint64_t>(moduleId)) * GLLFHashPrime;
+   hash = (hash ^ level) * GLLFHashPrime;
+   while (*text != '\0')
+   {
+      hash = (hash ^ static_cast<uint8_t>(*text++)) * GLLFHashPrime;
+   }
+
+   return hash;
+}
+
+/******************************************************************************/
+GLLogRepeatFilter::gl_log_repeat_table_struct& GLLogRepeatFilter::ThreadTable()
+{
+   for (const GL_LOG_REPEAT_THREAD_TYPE& thread : m_theThreadTables)
+   {
+      if (thread.ownerId == m_FilterId)
+      {
+         return *static_cast<gl_log_repeat_table_struct*>(thread.table);
+      }
+   }
+
+   // First entry of this thread for this filter.  The tables of destroyed
+   // filters went with them.
+   {
+      std::lock_guard<std::mutex> lock(m_theLiveFiltersMutex);
+      m_theThreadTables.erase(
+            std::remove_if(
+                  m_theThreadTables.begin(),
+                  m_theThreadTables.end(),
+                  [](const GL_LOG_REPEAT_THREAD_TYPE& thread)
+                  {
+                     return (m_theLiveFilters.count(thread.ownerId) == 0);
+                  }),
+            m_theThreadTables.end());
+   }
+
+   GL_LOG_REPEAT_THREAD_TYPE thread;
+   {
+      std::lock_guard<std::mutex> lock(m_TablesMutex);
+      m_Tables.push_back(std::make_unique<gl_log_repeat_table_struct>());
+      thread.ownerId = m_FilterId;
+      thread.table = m_Tables.back().get();
+   }
+   m_theThreadTables.push_back(thread);
+
+   return *static_cast<gl_log_repeat_table_struct*>(thread.table);
+}
+
+/******************************************************************************/
+bool GLLogRepeatFilter::Suppress(
+      uint64_t timeStampNs,
+      GLCFModuleIds moduleId,
+      const char* text,
+      uint8_t level,
+      GL_LOG_REPEAT_TYPE& foldRepeats)
+{
+   bool suppress = false;
+   uint64_t hash = EntryHash(moduleId, text, level);
+   uint64_t ownerId = m_FilterId;
+   gl_log_repeat_table_struct& table = ThreadTable();
+   std::lock_guard<std::mutex> lock(table.mutex);
+   GL_LOG_REPEAT_SLOT_TYPE& slot = table.slots[hash & (GLLFThreadSlots - 1)];
+
+   foldRepeats.repeatCount = 0;
+
+   if (slot.ownerId == ownerId &&
+      slot.hash == hash &&
+      slot.tracked &&
+      timeStampNs - slot.firstTimeStampNs <= m_WindowNs)
+   {
+      slot.pendingRepeats++;
+      slot.lastTimeStampNs = timeStampNs;
+      if (slot.pendingRepeats >= GLLFFoldThresholdRepeats)
+      {
+         // Keeps the count visible in the log during a long flood.
+         TakeSlotRepeats(slot, foldRepeats);
+      }
+      suppress = true;
+   }
+   else
+   {
+      // The window for this entry is over or the slot is taken by another
+      // entry; either way its repeats go back to the log before reuse.
+      if (slot.ownerId == ownerId && slot.tracked && slot.pendingRepeats > 0)
+      {
+         TakeSlotRepeats(slot, foldRepeats);
+      }
+
+      slot.ownerId = ownerId;
+      slot.hash = hash;
+      slot.firstTimeStampNs = timeStampNs;
+      slot.lastTimeStampNs = timeStampNs;
+      slot.pendingRepeats = 0;
+      slot.tracked = false;
+      table.lastSlot = &slot;
+   }
+
+   return (suppress);
+}
+
+/******************************************************************************/
+void GLLogRepeatFilter::TrackEntry(uint32_t entryIndex, uint64_t entrySerial)
+{
+   gl_log_repeat_table_struct& table = ThreadTable();
+   std::lock_guard<std::mutex> lock(table.mutex);
+   GL_LOG_REPEAT_SLOT_TYPE* slot = table.lastSlot;
+
+   if (slot != nullptr && slot->ownerId == m_FilterId)
+   {
+      slot->entryIndex = entryIndex;
+      slot->entrySerial = entrySerial;
+      slot->tracked = true;
+      table.lastSlot = nullptr;
+   }
+}
+
+/******************************************************************************/
+bool GLLogRepeatFilter::TakePendingRepeats(GL_LOG_REPEAT_TYPE& foldRepeats)
+{
+   return TakeRepeats(UINT64_MAX, foldRepeats);
+}
+
+/******************************************************************************/
+bool GLLogRepeatFilter::TakeExpiredRepeats(uint64_t nowNs, GL_LOG_REPEAT_TYPE& foldRepeats)
+{
+   return TakeRepeats((nowNs > m_WindowNs) ? nowNs - m_WindowNs : 0, foldRepeats);
+}
+
+/******************************************************************************/
+bool GLLogRepeatFilter::TakeRepeats(uint64_t closedBeforeNs, GL_LOG_REPEAT_TYPE& foldRepeats)
+{
+   std::lock_guard<std::mutex> tablesLock(m_TablesMutex);
+
+   for (std::unique_ptr<gl_log_repeat_table_struct>& table : m_Tables)
+   {
+      std::lock_guard<std::mutex> lock(table->mutex);
+
+      for (GL_LOG_REPEAT_SLOT_TYPE& slot : table->slots)
+      {
+         if (slot.ownerId == m_FilterId &&
+            slot.tracked &&
+            slot.pendingRepeats > 0 &&
+            slot.firstTimeStampNs < closedBeforeNs)
+         {
+            TakeSlotRepeats(slot, foldRepeats);
+            return (true);
+         }
+      }
+   }
+
+   return (false);
+}
+
+/******************************************************************************/
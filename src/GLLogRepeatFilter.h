@@ -0,0 +1,114 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogRepeatFilter.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the log repeat filter.  Identical
+   (module, message, level) log entries arriving within a time window are
+   counted in a small per-thread table instead of being logged again, and the
+   count is later folded into the entry that opened the window.
+
+   The per-thread tables belong to the filter, which keeps a list of them,
+   so a reader can drain the repeats counted on every thread.  Each table
+   has a mutex of its own that only such a reader contends with.
+*/
+/******************************************************************************/
+#ifndef gl_log_repeat_filter_h
+#define gl_log_repeat_filter_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "GLConfigureSystemModules.h"
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const uint64_t GLLFRepeatWindowNs = 1000000000;   // 1 second
+const uint32_t GLLFFoldThresholdRepeats = 64;
+const uint32_t GLLFThreadSlots = 16;               // power of two
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+// Repeats that were suppressed for an entry still to be updated in the log.
+typedef struct gl_log_repeat_struct
+{
+   uint32_t entryIndex;
+   uint64_t entrySerial;
+   uint32_t repeatCount;
+   uint64_t lastTimeStampNs;
+} GL_LOG_REPEAT_TYPE;
+
+class GLLogRepeatFilter
+{
+   public:
+      GLLogRepeatFilter(uint64_t windowNs);
+      ~GLLogRepeatFilter();
+
+      // Only the calling thread's table is touched.  Returns true when the
+      // entry is a repeat and must not be logged.  Whenever
+      // foldRepeats.repeatCount is non zero on return the caller has to fold
+      // those repeats into the referenced entry.
+      bool Suppress(
+            uint64_t timeStampNs,
+            GLCFModuleIds moduleId,
+            const char* text,
+            uint8_t level,
+            GL_LOG_REPEAT_TYPE& foldRepeats);
+
+      // Binds the entry just logged for a non suppressed call to the
+      // calling thread's table.
+      void TrackEntry(uint32_t entryIndex, uint64_t entrySerial);
+
+      // Hand back the pending repeats of all threads one at a time: all of
+      // them, or those whose window closed before nowNs.
+      bool TakePendingRepeats(GL_LOG_REPEAT_TYPE& foldRepeats);
+      bool TakeExpiredRepeats(uint64_t nowNs, GL_LOG_REPEAT_TYPE& foldRepeats);
+
+   private:
+      struct gl_log_repeat_table_struct;
+
+      gl_log_repeat_table_struct& ThreadTable();
+      bool TakeRepeats(uint64_t closedBeforeNs, GL_LOG_REPEAT_TYPE& foldRepeats);
+
+      static uint64_t EntryHash(
+            GLCFModuleIds moduleId,
+            const char* text,
+            uint8_t level);
+
+      // Unique for the life of the process so the thread tables never
+      // mistake slots left behind by a destroyed filter for a live one.
+      const uint64_t m_FilterId;
+      const uint64_t m_WindowNs;
+      std::vector<std::unique_ptr<gl_log_repeat_table_struct>> m_Tables;
+      std::mutex m_TablesMutex;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_log_repeat_filter_h */
@@ -0,0 +1,405 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogRing.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the memory mapped log ring.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "GLLogRing.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                          D A T A  M O D E L S                              */
+/******************************************************************************/
+GLLogRingEntry::GLLogRingEntry()
+   :
+   m_Sequence(0),
+   m_Generation(0),
+   m_TimeStampNs(0),
+   m_ModuleId(0),
+   m_Level(0)
+{
+}
+
+/******************************************************************************/
+GLLogRingEntry::~GLLogRingEntry()
+{
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLLogRing::GLLogRing()
+   :
+   m_Header(nullptr),
+   m_Records(nullptr),
+   m_MappingSizeBytes(0),
+   m_Generation(0),
+   m_Writable(false)
+{
+}
+
+/******************************************************************************/
+GLLogRing::~GLLogRing()
+{
+   Unmap();
+}
+
+/******************************************************************************/
+size_t GLLogRing::MappingSizeBytes(uint32_t capacity)
+{
+   return sizeof(GL_LOG_RING_HEADER_TYPE) +
+         static_cast<size_t>(capacity) * sizeof(GL_LOG_RING_RECORD_TYPE);
+}
+
+/******************************************************************************/
+bool GLLogRing::Mapped()
+{
+   return (m_Header != nullptr);
+}
+
+/******************************************************************************/
+bool GLLogRing::MapFile(
+      const std::string& path,
+      uint32_t capacity,
+      GLLRSourceType source)
+{
+   bool success = false;
+
+   if (!Mapped() && capacity > 0)
+   {
+      int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+      if (fd >= 0)
+      {
+         success = MapDescriptor(fd, true, capacity, source);
+         close(fd);
+      }
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+bool GLLogRing::MapFileReadOnly(const std::string& path)
+{
+   bool success = false;
+
+   if (!Mapped())
+   {
+      int fd = open(path.c_str(), O_RDONLY);
+      if (fd >= 0)
+      {
+         success = MapDescriptor(fd, false, 0, GLLR_SOURCE_UNKNOWN);
+         close(fd);
+      }
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+bool GLLogRing::MapSharedMemory(
+      const std::string& name,
+      uint32_t capacity,
+      GLLRSourceType source)
+{
+   bool success = false;
+
+   if (!Mapped() && capacity > 0)
+   {
+      // The segment is left in place at exit so readers can stay attached
+      // across a server restart.
+      int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+      if (fd >= 0)
+      {
+         success = MapDescriptor(fd, true, capacity, source);
+         close(fd);
+      }
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+bool GLLogRing::MapSharedMemoryReadOnly(const std::string& name)
+{
+   bool success = false;
+
+   if (!Mapped())
+   {
+      int fd = shm_open(name.c_str(), O_RDONLY, 0);
+      if (fd >= 0)
+      {
+         success = MapDescriptor(fd, false, 0, GLLR_SOURCE_UNKNOWN);
+         close(fd);
+      }
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+bool GLLogRing::MapDescriptor(
+      int fd,
+      bool writable,
+      uint32_t capacity,
+      GLLRSourceType source)
+{
+   bool success = false;
+   struct stat st;
+
+   if (fstat(fd, &st) != 0)
+   {
+      return (false);
+   }
+
+   size_t existingSize = static_cast<size_t>(st.st_size);
+   size_t mappingSize = writable ? MappingSizeBytes(capacity) : existingSize;
+
+   if (writable && existingSize != mappingSize)
+   {
+      // A new or resized ring starts out empty.
+      if (ftruncate(fd, 0) != 0 || ftruncate(fd, mappingSize) != 0)
+      {
+         return (false);
+      }
+   }
+
+   if (mappingSize < sizeof(GL_LOG_RING_HEADER_TYPE))
+   {
+      return (false);
+   }
+
+   void* base = mmap(
+         nullptr,
+         mappingSize,
+         writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+         MAP_SHARED,
+         fd,
+         0);
+
+   if (base != MAP_FAILED)
+   {
+      m_Header = static_cast<GL_LOG_RING_HEADER_TYPE*>(base);
+      m_Records = reinterpret_cast<GL_LOG_RING_RECORD_TYPE*>(
+            static_cast<uint8_t*>(base) + sizeof(GL_LOG_RING_HEADER_TYPE));
+      m_MappingSizeBytes = mappingSize;
+      m_Writable = writable;
+
+      if (writable)
+      {
+         if (!HeaderValid(capacity))
+         {
+            InitializeHeader(capacity, source);
+         }
+         m_Generation = m_Header->generation.fetch_add(1) + 1;
+         success = true;
+      }
+      else
+      {
+         success = HeaderValid(m_Header->capacity);
+         m_Generation = success ? m_Header->generation.load() : 0;
+      }
+
+      if (!success)
+      {
+         Unmap();
+      }
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+bool GLLogRing::HeaderValid(uint32_t capacity)
+{
+   return (m_Header->magic == GLLRRingMagic &&
+         m_Header->layoutVersion == GLLRRingLayoutVersion &&
+         m_Header->recordSizeBytes == sizeof(GL_LOG_RING_RECORD_TYPE) &&
+         m_Header->capacity == capacity &&
+         capacity > 0 &&
+         MappingSizeBytes(capacity) <= m_MappingSizeBytes);
+}
+
+/******************************************************************************/
+void GLLogRing::InitializeHeader(uint32_t capacity, GLLRSourceType source)
+{
+   std::memset(static_cast<void*>(m_Header), 0, m_MappingSizeBytes);
+
+   m_Header->magic = GLLRRingMagic;
+   m_Header->layoutVersion = GLLRRingLayoutVersion;
+   m_Header->source = source;
+   m_Header->capacity = capacity;
+   m_Header->recordSizeBytes = sizeof(GL_LOG_RING_RECORD_TYPE);
+   m_Header->generation.store(0);
+   m_Header->nextSequence.store(0);
+}
+
+/******************************************************************************/
+void GLLogRing::Unmap()
+{
+   if (Mapped())
+   {
+      munmap(static_cast<void*>(m_Header), m_MappingSizeBytes);
+      m_Header = nullptr;
+      m_Records = nullptr;
+      m_MappingSizeBytes = 0;
+   }
+}
+
+/******************************************************************************/
+bool GLLogRing::Flush()
+{
+   bool success = false;
+
+   if (Mapped() && m_Writable)
+   {
+      success = (msync(static_cast<void*>(m_Header), m_MappingSizeBytes, MS_ASYNC) == 0);
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+void GLLogRing::Append(
+      uint64_t timeStampNs,
+      GLCFModuleIds moduleId,
+      uint8_t level,
+      const char* text)
+{
+   if (!Mapped() || !m_Writable)
+   {
+      return;
+   }
+
+   uint64_t sequence = m_Header->nextSequence.load(std::memory_order_relaxed);
+   GL_LOG_RING_RECORD_TYPE& record = m_Records[sequence % m_Header->capacity];
+
+   record.beginSequence.store(sequence + 1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+
+   size_t textLength = strnlen(text, GLLRRecordTextMaximumLengthChars);
+   record.generation = m_Generation;
+   record.timeStampNs = timeStampNs;
+   record.moduleId = static_cast<uint16_t>(moduleId);
+   record.level = level;
+   record.textLength = static_cast<uint8_t>(textLength);
+   std::memcpy(record.text, text, textLength);
+
+   record.endSequence.store(sequence + 1, std::memory_order_release);
+   m_Header->nextSequence.store(sequence + 1, std::memory_order_release);
+}
+
+/******************************************************************************/
+bool GLLogRing::CopyRecord(GL_LOG_RING_RECORD_TYPE& record, GLLogRingEntry& entry)
+{
+   uint64_t endSequence = record.endSequence.load(std::memory_order_acquire);
+
+   entry.m_Generation = record.generation;
+   entry.m_TimeStampNs = record.timeStampNs;
+   entry.m_ModuleId = record.moduleId;
+   entry.m_Level = record.level;
+   uint8_t textLength = std::min<uint8_t>(
+         record.textLength,
+         GLLRRecordTextMaximumLengthChars);
+   entry.m_Text.assign(record.text, textLength);
+
+   std::atomic_thread_fence(std::memory_order_acquire);
+   uint64_t beginSequence = record.beginSequence.load(std::memory_order_relaxed);
+
+   entry.m_Sequence = endSequence - 1;
+
+   return (endSequence != 0 && beginSequence == endSequence);
+}
+
+/******************************************************************************/
+bool GLLogRing::ReadRecord(uint64_t sequence, GLLogRingEntry& entry)
+{
+   bool success = false;
+
+   if (Mapped())
+   {
+      GL_LOG_RING_RECORD_TYPE& record = m_Records[sequence % m_Header->capacity];
+      success = CopyRecord(record, entry) && entry.m_Sequence == sequence;
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+std::shared_ptr<std::vector<GLLogRingEntry>> GLLogRing::RecoverEntries()
+{
+   // This is temporary data.  The ownership of the shared_ptr will be passed
+   // to the calling function when this method returns.
+   auto entries = std::make_shared<std::vector<GLLogRingEntry>>();
+
+   if (Mapped())
+   {
+      uint32_t capacity = m_Header->capacity;
+      entries->reserve(capacity);
+
+      for (uint32_t index = 0; index < capacity; index++)
+      {
+         GLLogRingEntry entry;
+         if (CopyRecord(m_Records[index], entry))
+         {
+            entries->push_back(entry);
+         }
+      }
+
+      // The sequence number carries the order across generations and torn
+      // records have already been discarded.
+      std::sort(entries->begin(), entries->end(),
+            [](const GLLogRingEntry& a, const GLLogRingEntry& b)
+            {
+               return a.m_Sequence < b.m_Sequence;
+            });
+   }
+
+   return entries;
+}
+
+/******************************************************************************/
+uint64_t GLLogRing::NextSequence()
+{
+   return Mapped() ? m_Header->nextSequence.load(std::memory_order_acquire) : 0;
+}
+
+/******************************************************************************/
+uint64_t GLLogRing::Generation()
+{
+   return m_Generation;
+}
+
+/******************************************************************************/
+uint32_t GLLogRing::Capacity()
+{
+   return Mapped() ? m_Header->capacity : 0;
+}
+
+/******************************************************************************/
+GLLRSourceType GLLogRing::Source()
+{
+   return Mapped() ? static_cast<GLLRSourceType>(m_Header->source) : GLLR_SOURCE_UNKNOWN;
+}
+
+/******************************************************************************/
@@ -0,0 +1,177 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogRing.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the memory mapped log ring.  The
+   ring holds fixed size log records in a file mapping so the most recent
+   entries survive a crash of the application and can be recovered offline,
+   or in a POSIX shared memory segment so external readers can follow the
+   log of a running server.
+
+   Every record is written seqlock style: beginSequence is stored first,
+   then the payload, then endSequence.  A reader copies the record and only
+   accepts it when both match the sequence it asked for.  Readers map the
+   ring read only, so they never write anything the server looks at.
+*/
+/******************************************************************************/
+#ifndef gl_log_ring_h
+#define gl_log_ring_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GLConfigureSystemModules.h"
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                              T Y P E D E F S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef enum
+{
+   GLLR_SOURCE_UNKNOWN = 0,
+   GLLR_SOURCE_EVENT_LOG,
+   GLLR_SOURCE_ERROR_LOG,
+} GLLRSourceType;
+
+}
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const uint32_t GLLRRingMagic = 0x474C4C52; // "GLLR"
+const uint16_t GLLRRingLayoutVersion = 1;
+const uint32_t GLLRRecordTextMaximumLengthChars = 100;
+
+}
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+namespace MDN
+{
+
+// The header and records are shared with other processes through the file
+// or shared memory segment, so they must stay plain fixed layout data.
+typedef struct gl_log_ring_header_struct
+{
+   uint32_t magic;
+   uint16_t layoutVersion;
+   uint16_t source;
+   uint32_t capacity;
+   uint32_t recordSizeBytes;
+   std::atomic<uint64_t> generation;    // incremented every time the ring is opened
+   std::atomic<uint64_t> nextSequence;  // published after a record is committed
+} GL_LOG_RING_HEADER_TYPE;
+
+typedef struct gl_log_ring_record_struct
+{
+   // A record is valid only when beginSequence == endSequence != 0.  Both hold
+   // the record sequence number + 1.  A torn write leaves them different.
+   std::atomic<uint64_t> beginSequence;
+   uint64_t generation;
+   uint64_t timeStampNs;
+   uint16_t moduleId;
+   uint8_t  level;
+   uint8_t  textLength;
+   char     text[GLLRRecordTextMaximumLengthChars];
+   std::atomic<uint64_t> endSequence;
+} GL_LOG_RING_RECORD_TYPE;
+
+class GLLogRingEntry
+{
+   public:
+      GLLogRingEntry();
+      ~GLLogRingEntry();
+
+      uint64_t m_Sequence;
+      uint64_t m_Generation;
+      uint64_t m_TimeStampNs;
+      uint16_t m_ModuleId;
+      uint8_t  m_Level;
+      std::string m_Text;
+};
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class GLLogRing
+{
+   public:
+      GLLogRing();
+      ~GLLogRing();
+
+      bool MapFile(
+            const std::string& path,
+            uint32_t capacity,
+            GLLRSourceType source);
+      bool MapFileReadOnly(const std::string& path);
+      bool MapSharedMemory(
+            const std::string& name,
+            uint32_t capacity,
+            GLLRSourceType source);
+      bool MapSharedMemoryReadOnly(const std::string& name);
+      void Unmap();
+      bool Flush();
+      bool Mapped();
+
+      // Called with the owning log's mutex held; never issues a system call.
+      void Append(
+            uint64_t timeStampNs,
+            GLCFModuleIds moduleId,
+            uint8_t level,
+            const char* text);
+
+      bool ReadRecord(uint64_t sequence, GLLogRingEntry& entry);
+      std::shared_ptr<std::vector<GLLogRingEntry>> RecoverEntries();
+
+      uint64_t NextSequence();
+      uint64_t Generation();
+      uint32_t Capacity();
+      GLLRSourceType Source();
+
+   private:
+      bool MapDescriptor(int fd, bool writable, uint32_t capacity, GLLRSourceType source);
+      bool HeaderValid(uint32_t capacity);
+      void InitializeHeader(uint32_t capacity, GLLRSourceType source);
+      bool CopyRecord(GL_LOG_RING_RECORD_TYPE& record, GLLogRingEntry& entry);
+      static size_t MappingSizeBytes(uint32_t capacity);
+
+      GL_LOG_RING_HEADER_TYPE* m_Header;
+      GL_LOG_RING_RECORD_TYPE* m_Records;
+      size_t m_MappingSizeBytes;
+      uint64_t m_Generation;
+      bool m_Writable;
+};
+
+using GLLogRingPtr = std::unique_ptr<GLLogRing>;
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_log_ring_h */
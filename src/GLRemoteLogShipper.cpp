@@ -0,0 +1,348 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLRemoteLogShipper.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the remote log shipper.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "GLRemoteLogShipper.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const int GLRLInvalidSocket = -1;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static void AppendBigEndian(std::vector<uint8_t>& frame, uint64_t value, uint32_t bytes)
+{
+   while (bytes > 0)
+   {
+      bytes--;
+      frame.push_back(static_cast<uint8_t>(value >> (bytes * 8)));
+   }
+}
+
+/******************************************************************************/
+static void WriteBigEndian(uint8_t* location, uint64_t value, uint32_t bytes)
+{
+   while (bytes > 0)
+   {
+      bytes--;
+      *location++ = static_cast<uint8_t>(value >> (bytes * 8));
+   }
+}
+
+/******************************************************************************/
+static uint64_t SteadyTimeNs()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLRemoteLogShipper::GLRemoteLogShipper()
+   :
+   m_State(GLRL_STATE_INACTIVE),
+   m_Sockfd(GLRLInvalidSocket),
+   m_CollectorPort(0),
+   m_QueueHead(0),
+   m_QueueCount(0),
+   m_DroppedEntries(0),
+   m_StopRequested(false),
+   m_FrameSequence(0),
+   m_EntrySequence(0),
+   m_FramesSent(0),
+   m_EntriesDroppedTotal(0),
+   m_RateTokens(GLRLRateLimitBurstDatagrams),
+   m_RateLastRefillNs(0)
+{
+}
+
+/******************************************************************************/
+GLRemoteLogShipper::~GLRemoteLogShipper()
+{
+   Stop();
+}
+
+/******************************************************************************/
+bool GLRemoteLogShipper::Active()
+{
+   return (m_State == GLRL_STATE_ACTIVE);
+}
+
+/******************************************************************************/
+uint64_t GLRemoteLogShipper::FramesSent()
+{
+   return m_FramesSent.load();
+}
+
+/******************************************************************************/
+uint64_t GLRemoteLogShipper::EntriesDropped()
+{
+   std::lock_guard<std::mutex> lock(m_QueueMutex);
+   return m_EntriesDroppedTotal.load() + m_DroppedEntries;
+}
+
+/******************************************************************************/
+bool GLRemoteLogShipper::Start(const std::string& collectorIpAddress, uint16_t collectorPort)
+{
+   bool success = false;
+
+   if (!Active())
+   {
+      m_Sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+      if (m_Sockfd != GLRLInvalidSocket)
+      {
+         m_CollectorIpAddress = collectorIpAddress;
+         m_CollectorPort = collectorPort;
+         m_StopRequested = false;
+         m_RateLastRefillNs = SteadyTimeNs();
+         m_State = GLRL_STATE_ACTIVE;
+         m_Thread = std::thread(&GLRemoteLogShipper::ShipperThread, this);
+         success = true;
+      }
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+void GLRemoteLogShipper::Stop()
+{
+   if (Active())
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_QueueMutex);
+         m_StopRequested = true;
+      }
+      m_QueueCondition.notify_one();
+      m_Thread.join();
+
+      close(m_Sockfd);
+      m_Sockfd = GLRLInvalidSocket;
+      m_State = GLRL_STATE_INACTIVE;
+   }
+}
+
+/******************************************************************************/
+bool GLRemoteLogShipper::QueueEntry(
+      GLRLSourceType source,
+      uint64_t timeStampNs,
+      GLCFModuleIds moduleId,
+      uint8_t level,
+      const char* text)
+{
+   bool success = false;
+   bool wakeShipper = false;
+
+   {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+
+      if (m_QueueCount < GLRLQueueSize)
+      {
+         GL_REMOTE_LOG_ENTRY_TYPE& entry =
+               m_Queue[(m_QueueHead + m_QueueCount) % GLRLQueueSize];
+         size_t textLength = strnlen(text, GLRLEntryTextMaximumLengthChars);
+
+         entry.timeStampNs = timeStampNs;
+         entry.moduleId = static_cast<uint16_t>(moduleId);
+         entry.source = static_cast<uint8_t>(source);
+         entry.level = level;
+         entry.textLength = static_cast<uint8_t>(textLength);
+         std::memcpy(entry.text, text, textLength);
+
+         m_QueueCount++;
+         wakeShipper = (m_QueueCount == GLRLFlushThresholdEntries);
+         success = true;
+      }
+      else
+      {
+         m_DroppedEntries++;
+      }
+   }
+
+   if (wakeShipper)
+   {
+      m_QueueCondition.notify_one();
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+void GLRemoteLogShipper::ShipperThread()
+{
+   bool stopping = false;
+
+   while (!stopping)
+   {
+      {
+         std::unique_lock<std::mutex> lock(m_QueueMutex);
+         m_QueueCondition.wait_for(
+               lock,
+               std::chrono::milliseconds(GLRLFlushIntervalMs),
+               [this] { return m_StopRequested || m_QueueCount >= GLRLFlushThresholdEntries; });
+         stopping = m_StopRequested;
+      }
+
+      // Whatever is still queued at shutdown is flushed regardless of the
+      // rate limit.
+      ShipQueuedEntries(stopping);
+   }
+}
+
+/******************************************************************************/
+void GLRemoteLogShipper::ShipQueuedEntries(bool ignoreRateLimit)
+{
+   std::vector<uint8_t> frame;
+   frame.reserve(GLRLMaximumDatagramBytes);
+
+   while (true)
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_QueueMutex);
+         if (m_QueueCount == 0 && m_DroppedEntries == 0)
+         {
+            break;
+         }
+      }
+
+      // While rate limited, entries stay queued; once the queue is full new
+      // entries are dropped and reported in the next frame.
+      if (!TakeRateToken() && !ignoreRateLimit)
+      {
+         break;
+      }
+
+      BuildFrame(frame);
+      SendFrame(frame);
+   }
+}
+
+/******************************************************************************/
+uint16_t GLRemoteLogShipper::BuildFrame(std::vector<uint8_t>& frame)
+{
+   uint16_t entryCount = 0;
+   uint32_t droppedEntries = 0;
+
+   frame.clear();
+   AppendBigEndian(frame, GLRLFrameMagic, 2);
+   AppendBigEndian(frame, GLRLFrameVersion, 1);
+   AppendBigEndian(frame, 0, 1);
+   AppendBigEndian(frame, m_FrameSequence, 4);
+   AppendBigEndian(frame, m_EntrySequence, 4);
+   AppendBigEndian(frame, 0, 2);  // entry count, filled in below
+   AppendBigEndian(frame, 0, 2);  // dropped entries, filled in below
+
+   {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+
+      while (m_QueueCount > 0)
+      {
+         GL_REMOTE_LOG_ENTRY_TYPE& entry = m_Queue[m_QueueHead];
+         if (frame.size() + GLRLEntryHeaderSizeBytes + entry.textLength >
+               GLRLMaximumDatagramBytes)
+         {
+            break;
+         }
+
+         AppendBigEndian(frame, entry.timeStampNs, 8);
+         AppendBigEndian(frame, entry.moduleId, 2);
+         AppendBigEndian(frame, entry.source, 1);
+         AppendBigEndian(frame, entry.level, 1);
+         AppendBigEndian(frame, entry.textLength, 1);
+         frame.insert(frame.end(), entry.text, entry.text + entry.textLength);
+
+         m_QueueHead = (m_QueueHead + 1) % GLRLQueueSize;
+         m_QueueCount--;
+         entryCount++;
+      }
+
+      droppedEntries = std::min<uint32_t>(m_DroppedEntries, UINT16_MAX);
+      m_DroppedEntries -= droppedEntries;
+   }
+
+   WriteBigEndian(&frame[12], entryCount, 2);
+   WriteBigEndian(&frame[14], droppedEntries, 2);
+
+   m_FrameSequence++;
+   m_EntrySequence += entryCount;
+   m_EntriesDroppedTotal += droppedEntries;
+
+   return (entryCount);
+}
+
+/******************************************************************************/
+bool GLRemoteLogShipper::SendFrame(std::vector<uint8_t>& frame)
+{
+   bool success = false;
+   struct sockaddr_in targetAddr;
+
+   std::memset(&targetAddr, 0, sizeof(targetAddr));
+   targetAddr.sin_family = AF_INET;
+   targetAddr.sin_addr.s_addr = inet_addr(m_CollectorIpAddress.c_str());
+   targetAddr.sin_port = htons(m_CollectorPort);
+
+   ssize_t sendresult = sendto(
+         m_Sockfd,
+         frame.data(),
+         frame.size(),
+         MSG_DONTWAIT,
+         (struct sockaddr*)&targetAddr,
+         sizeof(targetAddr));
+
+   if (sendresult == static_cast<ssize_t>(frame.size()))
+   {
+      m_FramesSent++;
+      success = true;
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+bool GLRemoteLogShipper::TakeRateToken()
+{
+   uint64_t nowNs = SteadyTimeNs();
+   double elapsedSec = static_cast<double>(nowNs - m_RateLastRefillNs) / 1.0e9;
+
+   m_RateLastRefillNs = nowNs;
+   m_RateTokens = std::min<double>(
+         GLRLRateLimitBurstDatagrams,
+         m_RateTokens + elapsedSec * GLRLRateLimitDatagramsPerSecond);
+
+   bool success = (m_RateTokens >= 1.0);
+   if (success)
+   {
+      m_RateTokens -= 1.0;
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
@@ -0,0 +1,163 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLRemoteLogShipper.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the remote log shipper.  Event and
+   error log entries are queued without blocking the caller and a background
+   thread packs them into compact binary frames, several entries per UDP
+   datagram, which are sent to a remote log collector.
+*/
+/******************************************************************************/
+#ifndef gl_remote_log_shipper_h
+#define gl_remote_log_shipper_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GLConfigureSystemModules.h"
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                              T Y P E D E F S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef enum
+{
+   GLRL_SOURCE_EVENT_LOG = 1,
+   GLRL_SOURCE_ERROR_LOG,
+} GLRLSourceType;
+
+typedef enum
+{
+   GLRL_STATE_INACTIVE,
+   GLRL_STATE_ACTIVE,
+} GLRLStateType;
+
+}
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+static const std::string GLRLCollectorIpAddress("127.0.0.1");
+const uint16_t GLRLCollectorPort = 49160;
+
+const uint32_t GLRLQueueSize = 1024;
+const uint32_t GLRLEntryTextMaximumLengthChars = 100;
+const uint32_t GLRLMaximumDatagramBytes = 1400;
+const uint32_t GLRLFlushIntervalMs = 50;
+const uint32_t GLRLFlushThresholdEntries = 32;
+const uint32_t GLRLRateLimitDatagramsPerSecond = 200;
+const uint32_t GLRLRateLimitBurstDatagrams = 20;
+
+// Frame layout, all fields big endian:
+//   frame header: magic(2) version(1) flags(1) frameSequence(4)
+//                 firstEntrySequence(4) entryCount(2) droppedEntries(2)
+//   each entry:   timeStampNs(8) moduleId(2) source(1) level(1)
+//                 textLength(1) text(textLength)
+const uint16_t GLRLFrameMagic = 0x524C; // "RL"
+const uint8_t GLRLFrameVersion = 1;
+const uint32_t GLRLFrameHeaderSizeBytes = 16;
+const uint32_t GLRLEntryHeaderSizeBytes = 13;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef struct gl_remote_log_entry_struct
+{
+   uint64_t timeStampNs;
+   uint16_t moduleId;
+   uint8_t  source;
+   uint8_t  level;
+   uint8_t  textLength;
+   char     text[GLRLEntryTextMaximumLengthChars];
+} GL_REMOTE_LOG_ENTRY_TYPE;
+
+/******************************************************************************/
+class GLRemoteLogShipper
+{
+   public:
+      GLRemoteLogShipper();
+      ~GLRemoteLogShipper();
+
+      bool Start(const std::string& collectorIpAddress, uint16_t collectorPort);
+      void Stop();
+      bool Active();
+
+      // Never blocks on the network.  Entries are dropped and counted when
+      // the queue is full.
+      bool QueueEntry(
+            GLRLSourceType source,
+            uint64_t timeStampNs,
+            GLCFModuleIds moduleId,
+            uint8_t level,
+            const char* text);
+
+      uint64_t FramesSent();
+      uint64_t EntriesDropped();
+
+   private:
+      void ShipperThread();
+      void ShipQueuedEntries(bool ignoreRateLimit);
+      uint16_t BuildFrame(std::vector<uint8_t>& frame);
+      bool SendFrame(std::vector<uint8_t>& frame);
+      bool TakeRateToken();
+
+      GLRLStateType m_State;
+      int32_t m_Sockfd;
+      std::string m_CollectorIpAddress;
+      uint16_t m_CollectorPort;
+
+      std::array<GL_REMOTE_LOG_ENTRY_TYPE, GLRLQueueSize> m_Queue;
+      uint32_t m_QueueHead;
+      uint32_t m_QueueCount;
+      uint32_t m_DroppedEntries;
+      std::mutex m_QueueMutex;
+      std::condition_variable m_QueueCondition;
+
+      std::thread m_Thread;
+      bool m_StopRequested;
+
+      // Owned by the shipper thread.
+      uint32_t m_FrameSequence;
+      uint32_t m_EntrySequence;
+      std::atomic<uint64_t> m_FramesSent;
+      std::atomic<uint64_t> m_EntriesDroppedTotal;
+      double m_RateTokens;
+      uint64_t m_RateLastRefillNs;
+};
+
+using GLRemoteLogShipperPtr = std::unique_ptr<GLRemoteLogShipper>;
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_remote_log_shipper_h */
@@ -19,14 +19,19 @@
 /*       I N C L U D E S                                                      */
 /******************************************************************************/
 #include <stdio.h>
+#include <stdlib.h>
 #include <iostream>
 #include <unistd.h>
 #include "limits.h"
 
 #include "GLTimeHelper.h"
+#include "GLTimerWheel.h"
 #include "GLErrorLog.h"
 #include "GLEventLog.h"
+#include "GLRemoteLogShipper.h"
+#include "GLTelemetrySampler.h"
 #include "IONetworkControlInterfaceManager.h"
+#include "IONetworkTransport.h"
 #include "PRProtocolDomainManager.h"
 #include "GLResourceMain.h"
 
@@ -43,15 +48,60 @@ const GLRMThreadModeType
 /******************************************************************************/
 GLResourceMain::GLResourceMain()
    :
+   GLResourceMain(
+      std::make_unique<GLTimeHelper>(GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START),
+      nullptr,
+      false)
+{
+}
+
+/******************************************************************************/
+GLResourceMain::GLResourceMain(
+      GLVirtualClock& virtualClock,
+      IONetworkTransportPtr transport)
+   :
+   GLResourceMain(
+      std::make_unique<GLTimeHelper>(GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START, virtualClock),
+      std::move(transport),
+      true)
+{
+}
+
+/******************************************************************************/
+GLResourceMain::GLResourceMain(
+      GLTimeHelperPtr timeHelper,
+      IONetworkTransportPtr transport,
+      bool simulation)
+   :
    m_DomainId(GLCF_GLOBAL_DOMAIN_ID),
    m_ModuleId(GLCF_GL_RESOURCE_MAIN_ID),
    m_State(GLRM_STATE_APP_INACTIVE),
-   m_TimeHelper(std::make_unique<GLTimeHelper>(GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START)),
+   m_Simulation(simulation),
+   m_TimeHelper(std::move(timeHelper)),
+   m_TimerWheel(std::make_unique<GLTimerWheel>(*m_TimeHelper)),
    m_ErrorLog(std::make_unique<GLErrorLog>(*this)),
    m_EventLog(std::make_unique<GLEventLog>(*this)),
-   m_IONetworkControlInterfaceMgr(std::make_unique<IONetworkControlInterfaceManager>(*this)),
+   m_RemoteLogShipper(std::make_unique<GLRemoteLogShipper>()),
+   m_TelemetrySampler(std::make_unique<GLTelemetrySampler>()),
+   m_IONetworkControlInterfaceMgr(
+      std::make_unique<IONetworkControlInterfaceManager>(*this, std::move(transport))),
    m_ProtocolManager(std::make_unique<PRProtocolDomainManager>(*this))
 {
+   if (!Simulation())
+   {
+      OpenMappedLogs();
+      StartRemoteLogging();
+      StartTelemetrySampler();
+   }
+
+   if (TimerWheel().TimerFd() < 0)
+   {
+      ErrorLog().LogError(
+         ModuleId(),
+         "GLResourceMain(): Timer wheel timerfd FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
+
    EventLog().LogEvent(
       MDN::GLCF_GL_RESOURCE_MAIN_ID,
       "GLResourceMain:: Constructor.",
@@ -61,6 +111,81 @@ GLResourceMain::GLResourceMain()
 /******************************************************************************/
 GLResourceMain::~GLResourceMain()
 {
+   TelemetrySampler().Stop();
+   RemoteLogShipper().Stop();
+   EventLog().CloseLogRings();
+   ErrorLog().CloseLogRings();
+}
+
+/******************************************************************************/
+void GLResourceMain::OpenMappedLogs()
+{
+   if (GLEVMappedLogEnabled &&
+      !EventLog().OpenMappedLog(GLEVMappedLogFilePath, GLEVMappedLogSize))
+   {
+      ErrorLog().LogError(
+         ModuleId(),
+         "OpenMappedLogs(): Event log mapping FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
+
+   if (GLELMappedLogEnabled &&
+      !ErrorLog().OpenMappedLog(GLELMappedLogFilePath, GLELMappedLogSize))
+   {
+      ErrorLog().LogError(
+         ModuleId(),
+         "OpenMappedLogs(): Error log mapping FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
+
+   if (GLEVSharedLogEnabled &&
+      !EventLog().OpenSharedLog(GLEVSharedLogName, GLEVSharedLogSize))
+   {
+      ErrorLog().LogError(
+         ModuleId(),
+         "OpenMappedLogs(): Event log shared memory FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
+
+   if (GLELSharedLogEnabled &&
+      !ErrorLog().OpenSharedLog(GLELSharedLogName, GLELSharedLogSize))
+   {
+      ErrorLog().LogError(
+         ModuleId(),
+         "OpenMappedLogs(): Error log shared memory FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
+}
+
+/******************************************************************************/
+void GLResourceMain::StartRemoteLogging()
+{
+   if ((GLEVRemoteLoggingEnabled || GLELRemoteLoggingEnabled) &&
+      !RemoteLogShipper().Start(GLRLCollectorIpAddress, GLRLCollectorPort))
+   {
+      ErrorLog().LogError(
+         ModuleId(),
+         "StartRemoteLogging(): Start FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
+}
+
+/******************************************************************************/
+void GLResourceMain::StartTelemetrySampler()
+{
+   if (!GLTLSSamplerEnabled)
+   {
+      return;
+   }
+
+   const char* root = getenv(GLTLSSysfsRootVariable);
+   if (!TelemetrySampler().Start((root != nullptr) ? root : GLTLSSysfsRoot, GLTLSSampleIntervalMs))
+   {
+      ErrorLog().LogError(
+         ModuleId(),
+         "StartTelemetrySampler(): Start FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
 }
 
 /******************************************************************************/
@@ -81,6 +206,12 @@ const std::string& GLResourceMain::ModuleName()
    return m_theModuleNameMap.at(ModuleId());
 }
 
+/******************************************************************************/
+bool GLResourceMain::Simulation()
+{
+   return m_Simulation;
+}
+
 /******************************************************************************/
 GLRMStateType GLResourceMain::State()
 {
@@ -135,6 +266,12 @@ GLTimeHelper& GLResourceMain::TimeHelper()
    return *m_TimeHelper;
 }
 
+/******************************************************************************/
+GLTimerWheel& GLResourceMain::TimerWheel()
+{
+   return *m_TimerWheel;
+}
+
 /******************************************************************************/
 GLErrorLog& GLResourceMain::ErrorLog()
 {
@@ -147,6 +284,18 @@ GLEventLog& GLResourceMain::EventLog()
    return *m_EventLog;
 }
 
+/******************************************************************************/
+GLRemoteLogShipper& GLResourceMain::RemoteLogShipper()
+{
+   return *m_RemoteLogShipper;
+}
+
+/******************************************************************************/
+GLTelemetrySampler& GLResourceMain::TelemetrySampler()
+{
+   return *m_TelemetrySampler;
+}
+
 /******************************************************************************/
 IONetworkControlInterfaceManager& GLResourceMain::InterfaceManager()
 {
@@ -40,13 +40,22 @@ namespace MDN
 /******************************************************************************/
 class GLErrorLog;
 class GLEventLog;
+class GLRemoteLogShipper;
+class GLTelemetrySampler;
 class GLTimeHelper;
+class GLTimerWheel;
+class GLVirtualClock;
+class IONetworkTransport;
 class IONetworkControlInterfaceManager;
 class PRProtocolDomainManager;
 
 using GLTimeHelperPtr = std::unique_ptr<GLTimeHelper>;
+using GLTimerWheelPtr = std::unique_ptr<GLTimerWheel>;
+using IONetworkTransportPtr = std::unique_ptr<IONetworkTransport>;
 using GLErrorLogPtr = std::unique_ptr<GLErrorLog>;
 using GLEventLogPtr = std::unique_ptr<GLEventLog>;
+using GLRemoteLogShipperPtr = std::unique_ptr<GLRemoteLogShipper>;
+using GLTelemetrySamplerPtr = std::unique_ptr<GLTelemetrySampler>;
 using IONetworkControlInterfaceManagerPtr = std::unique_ptr<IONetworkControlInterfaceManager>;
 using ProtocolDomainManagerPtr = std::unique_ptr<PRProtocolDomainManager>;
 
@@ -75,13 +84,22 @@ class GLResourceMain
 {
    public:
       GLResourceMain();
+      // Simulated run: time comes from virtualClock and datagrams from
+      // transport.  The logs are not published to files, shared memory or a
+      // collector, so a simulation can run next to a live server.
+      GLResourceMain(
+            GLVirtualClock& virtualClock,
+            IONetworkTransportPtr transport);
       ~GLResourceMain();
 
       void AppStart();
       void AppStop();
       GLErrorLog& ErrorLog();
       GLEventLog& EventLog();
+      GLRemoteLogShipper& RemoteLogShipper();
+      GLTelemetrySampler& TelemetrySampler();
       GLTimeHelper& TimeHelper();
+      GLTimerWheel& TimerWheel();
       IONetworkControlInterfaceManager& InterfaceManager();
       PRProtocolDomainManager& ProtocolManager();
 
@@ -95,14 +113,27 @@ class GLResourceMain
       const std::string& ModuleName();
       const GLRMThreadModeType AppThreadMode();
 
+      bool Simulation();
+
    private:
+      GLResourceMain(
+            GLTimeHelperPtr timeHelper,
+            IONetworkTransportPtr transport,
+            bool simulation);
+      void OpenMappedLogs();
+      void StartRemoteLogging();
+      void StartTelemetrySampler();
 
       const GLCFDomainIds m_DomainId;
       const GLCFModuleIds m_ModuleId;
       GLRMStateType m_State;
+      const bool m_Simulation;
       GLTimeHelperPtr m_TimeHelper;
+      GLTimerWheelPtr m_TimerWheel;
       GLErrorLogPtr m_ErrorLog;
       GLEventLogPtr m_EventLog;
+      GLRemoteLogShipperPtr m_RemoteLogShipper;
+      GLTelemetrySamplerPtr m_TelemetrySampler;
       IONetworkControlInterfaceManagerPtr m_IONetworkControlInterfaceMgr;
       ProtocolDomainManagerPtr m_ProtocolManager;
 
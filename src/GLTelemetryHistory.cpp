@@ -0,0 +1,223 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTelemetryHistory.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the SoC telemetry history.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+
+#include "GLTelemetryHistory.h"
+#include "GLTelemetrySampler.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLTelemetryHistory::GLTelemetryHistory()
+   :
+   m_Zones(0),
+   m_Channels(0),
+   m_Metrics(0)
+{
+}
+
+/******************************************************************************/
+void GLTelemetryHistory::Reset(uint32_t zones, uint32_t channels)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   m_Zones = zones;
+   m_Channels = channels;
+   m_Metrics = zones + channels;
+   m_Values.assign(m_Metrics, GLTLSNoValue);
+
+   Allocate(m_Rings[GLTLH_RESOLUTION_RAW], 0, GLTLHRawRows);
+   Allocate(m_Rings[GLTLH_RESOLUTION_SECOND], GLTLHSecondNs, GLTLHSecondRows);
+   Allocate(m_Rings[GLTLH_RESOLUTION_MINUTE], GLTLHMinuteNs, GLTLHMinuteRows);
+}
+
+/******************************************************************************/
+void GLTelemetryHistory::Allocate(GL_HISTORY_RING_TYPE& ring, uint64_t bucketNs, uint32_t capacity)
+{
+   ring = GL_HISTORY_RING_TYPE();
+   ring.bucketNs = bucketNs;
+   ring.capacity = capacity;
+   ring.timeNs.assign(capacity, 0);
+   ring.average.assign(static_cast<size_t>(m_Metrics) * capacity, GLTLSNoValue);
+
+   if (bucketNs != 0)
+   {
+      ring.minimum.assign(static_cast<size_t>(m_Metrics) * capacity, GLTLSNoValue);
+      ring.maximum.assign(static_cast<size_t>(m_Metrics) * capacity, GLTLSNoValue);
+      ring.sum.assign(m_Metrics, 0);
+      ring.count.assign(m_Metrics, 0);
+      ring.low.assign(m_Metrics, INT32_MAX);
+      ring.high.assign(m_Metrics, INT32_MIN);
+   }
+}
+
+/******************************************************************************/
+void GLTelemetryHistory::Append(const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   if (m_Metrics == 0)
+   {
+      return;
+   }
+
+   for (uint32_t zone = 0; zone < m_Zones; zone++)
+   {
+      m_Values[zone] = (zone < snapshot.zoneCount) ? snapshot.temperatureMilliC[zone] : GLTLSNoValue;
+   }
+   for (uint32_t channel = 0; channel < m_Channels; channel++)
+   {
+      m_Values[m_Zones + channel] = (channel < snapshot.channelCount) ?
+            snapshot.voltageMilliV[channel] : GLTLSNoValue;
+   }
+
+   GL_HISTORY_RING_TYPE& raw = m_Rings[GLTLH_RESOLUTION_RAW];
+   raw.timeNs[raw.head] = snapshot.sampleTimeNs;
+   for (uint32_t metric = 0; metric < m_Metrics; metric++)
+   {
+      raw.average[static_cast<size_t>(metric) * raw.capacity + raw.head] = m_Values[metric];
+   }
+   raw.head = (raw.head + 1) % raw.capacity;
+   raw.rows = std::min(raw.rows + 1, raw.capacity);
+
+   Aggregate(m_Rings[GLTLH_RESOLUTION_SECOND], snapshot.sampleTimeNs, m_Values.data());
+   Aggregate(m_Rings[GLTLH_RESOLUTION_MINUTE], snapshot.sampleTimeNs, m_Values.data());
+}
+
+/******************************************************************************/
+void GLTelemetryHistory::Aggregate(GL_HISTORY_RING_TYPE& ring, uint64_t timeNs, const int32_t* values)
+{
+   uint64_t bucketStartNs = timeNs - timeNs % ring.bucketNs;
+
+   if (ring.bucketOpen && bucketStartNs != ring.bucketStartNs)
+   {
+      CloseBucket(ring);
+   }
+
+   ring.bucketOpen = true;
+   ring.bucketStartNs = bucketStartNs;
+
+   for (uint32_t metric = 0; metric < m_Metrics; metric++)
+   {
+      int32_t value = values[metric];
+      if (value == GLTLSNoValue)
+      {
+         continue;
+      }
+
+      ring.sum[metric] += value;
+      ring.count[metric]++;
+      ring.low[metric] = std::min(ring.low[metric], value);
+      ring.high[metric] = std::max(ring.high[metric], value);
+   }
+}
+
+/******************************************************************************/
+void GLTelemetryHistory::CloseBucket(GL_HISTORY_RING_TYPE& ring)
+{
+   ring.timeNs[ring.head] = ring.bucketStartNs;
+
+   for (uint32_t metric = 0; metric < m_Metrics; metric++)
+   {
+      size_t index = static_cast<size_t>(metric) * ring.capacity + ring.head;
+      bool valued = (ring.count[metric] > 0);
+
+      ring.minimum[index] = valued ? ring.low[metric] : GLTLSNoValue;
+      ring.maximum[index] = valued ? ring.high[metric] : GLTLSNoValue;
+      ring.average[index] = valued ?
+            static_cast<int32_t>(ring.sum[metric] / static_cast<int64_t>(ring.count[metric])) : GLTLSNoValue;
+
+      ring.sum[metric] = 0;
+      ring.count[metric] = 0;
+      ring.low[metric] = INT32_MAX;
+      ring.high[metric] = INT32_MIN;
+   }
+
+   ring.head = (ring.head + 1) % ring.capacity;
+   ring.rows = std::min(ring.rows + 1, ring.capacity);
+   ring.bucketOpen = false;
+}
+
+/******************************************************************************/
+bool GLTelemetryHistory::Range(
+      GLTLHResolutionType resolution,
+      uint64_t fromNs,
+      uint64_t toNs,
+      GL_TELEMETRY_RANGE_TYPE& range)
+{
+   if (resolution >= GLTLH_RESOLUTIONS)
+   {
+      return (false);
+   }
+
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   const GL_HISTORY_RING_TYPE& ring = m_Rings[resolution];
+   uint32_t oldest = (ring.head + ring.capacity - ring.rows) % std::max<uint32_t>(ring.capacity, 1);
+   uint32_t first = 0;
+   uint32_t last = 0;
+
+   // Rows are in time order from the oldest; find the ones in the range.
+   for (uint32_t row = 0; row < ring.rows; row++)
+   {
+      uint64_t timeNs = ring.timeNs[(oldest + row) % ring.capacity];
+      if (timeNs < fromNs)
+      {
+         first = row + 1;
+      }
+      if (timeNs <= toNs)
+      {
+         last = row + 1;
+      }
+   }
+
+   range.zones = m_Zones;
+   range.channels = m_Channels;
+   range.rows = (last > first) ? last - first : 0;
+   range.timeNs.resize(range.rows);
+   range.average.resize(static_cast<size_t>(m_Metrics) * range.rows);
+   range.minimum.resize((ring.bucketNs != 0) ? range.average.size() : 0);
+   range.maximum.resize(range.minimum.size());
+
+   for (uint32_t row = 0; row < range.rows; row++)
+   {
+      range.timeNs[row] = ring.timeNs[(oldest + first + row) % ring.capacity];
+   }
+
+   // Column by column, each a run of consecutive rows in the ring.
+   for (uint32_t metric = 0; metric < m_Metrics; metric++)
+   {
+      for (uint32_t row = 0; row < range.rows; row++)
+      {
+         size_t from = static_cast<size_t>(metric) * ring.capacity + (oldest + first + row) % ring.capacity;
+         size_t to = static_cast<size_t>(metric) * range.rows + row;
+         range.average[to] = ring.average[from];
+         if (ring.bucketNs != 0)
+         {
+            range.minimum[to] = ring.minimum[from];
+            range.maximum[to] = ring.maximum[from];
+         }
+      }
+   }
+
+   return (true);
+}
+
+/******************************************************************************/
@@ -0,0 +1,153 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTelemetryHistory.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the SoC telemetry history.  Each
+   sample of the sampler is appended to three rings of fixed size:
+
+      GLTLH_RESOLUTION_RAW     every sample          GLTLHRawRows
+      GLTLH_RESOLUTION_SECOND  1 s min / max / avg   GLTLHSecondRows
+      GLTLH_RESOLUTION_MINUTE  1 min min / max / avg GLTLHMinuteRows
+
+   The metrics are the temperature of each thermal zone followed by the
+   voltage of each channel, as the sampler found them.  A ring is stored by
+   column: one time column shared by all metrics and, per metric, a value
+   column (raw) or a minimum, maximum and average column, so a range of one
+   metric is read from consecutive memory.  The columns are allocated once,
+   by Reset(), for the sensors found; Append() never allocates.
+
+   A second or minute row is written when the first sample of the next
+   bucket arrives; its time is the start of its bucket.  Readings without a
+   value are left out of the aggregates; a bucket without any is
+   GLTLSNoValue.
+*/
+/******************************************************************************/
+#ifndef gl_telemetry_history_h
+#define gl_telemetry_history_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef enum
+{
+   GLTLH_RESOLUTION_RAW = 0,
+   GLTLH_RESOLUTION_SECOND,
+   GLTLH_RESOLUTION_MINUTE,
+   GLTLH_RESOLUTIONS
+} GLTLHResolutionType;
+
+const uint32_t GLTLHRawRows = 600;        // 10 min at 1 sample per second
+const uint32_t GLTLHSecondRows = 900;     // 15 min
+const uint32_t GLTLHMinuteRows = 1440;    // 24 h
+const uint64_t GLTLHSecondNs = 1000000000;
+const uint64_t GLTLHMinuteNs = 60 * GLTLHSecondNs;
+
+}
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+namespace MDN
+{
+
+struct gl_telemetry_snapshot_struct;
+
+// Rows of one resolution in time order, columns laid out as in the ring:
+// value or minimum, maximum, average of metric m at row r at
+// [m * rows + r].  Raw rows fill average only.
+typedef struct gl_telemetry_range_struct
+{
+   uint32_t zones = 0;
+   uint32_t channels = 0;
+   uint32_t rows = 0;
+   std::vector<uint64_t> timeNs;
+   std::vector<int32_t> minimum;
+   std::vector<int32_t> maximum;
+   std::vector<int32_t> average;
+} GL_TELEMETRY_RANGE_TYPE;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class GLTelemetryHistory
+{
+   public:
+      GLTelemetryHistory();
+
+      // Drops the history and allocates the rings for these sensors.
+      void Reset(uint32_t zones, uint32_t channels);
+      // Called on the sampler thread.
+      void Append(const gl_telemetry_snapshot_struct& snapshot);
+      // The rows of resolution from fromNs to toNs (CLOCK_MONOTONIC), both
+      // included.  False for an unknown resolution.
+      bool Range(
+            GLTLHResolutionType resolution,
+            uint64_t fromNs,
+            uint64_t toNs,
+            GL_TELEMETRY_RANGE_TYPE& range);
+
+   private:
+      typedef struct gl_history_ring_struct
+      {
+         uint64_t bucketNs = 0;                // 0 for the raw ring
+         uint32_t capacity = 0;
+         uint32_t head = 0;                    // next row written
+         uint32_t rows = 0;
+         std::vector<uint64_t> timeNs;
+         std::vector<int32_t> minimum;         // empty for the raw ring
+         std::vector<int32_t> maximum;         // empty for the raw ring
+         std::vector<int32_t> average;         // the value for the raw ring
+
+         // The bucket being aggregated, one entry per metric.
+         bool bucketOpen = false;
+         uint64_t bucketStartNs = 0;
+         std::vector<int64_t> sum;
+         std::vector<uint32_t> count;
+         std::vector<int32_t> low;
+         std::vector<int32_t> high;
+      } GL_HISTORY_RING_TYPE;
+
+      void Allocate(GL_HISTORY_RING_TYPE& ring, uint64_t bucketNs, uint32_t capacity);
+      void Aggregate(GL_HISTORY_RING_TYPE& ring, uint64_t timeNs, const int32_t* values);
+      void CloseBucket(GL_HISTORY_RING_TYPE& ring);
+
+      uint32_t m_Zones;
+      uint32_t m_Channels;
+      uint32_t m_Metrics;
+      std::array<GL_HISTORY_RING_TYPE, GLTLH_RESOLUTIONS> m_Rings;
+      std::vector<int32_t> m_Values;           // of the sample being appended
+      std::mutex m_Mutex;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_telemetry_history_h */
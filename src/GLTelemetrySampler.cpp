@@ -0,0 +1,371 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTelemetrySampler.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the SoC telemetry sampler.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "GLTelemetrySampler.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const char* GLTLSThermalDirectory = "/class/thermal";
+static const char* GLTLSHwmonDirectory = "/class/hwmon";
+static const uint32_t GLTLSMaximumTripPoints = 32;
+static const uint64_t GLTLSNanosecondsPerSecond = 1000000000;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static bool FileExists(const std::string& path)
+{
+   return (access(path.c_str(), R_OK) == 0);
+}
+
+/******************************************************************************/
+static bool ReadText(const std::string& path, char* text, size_t size)
+{
+   FILE* file = fopen(path.c_str(), "r");
+
+   if (file == nullptr)
+   {
+      return (false);
+   }
+
+   bool success = (fgets(text, static_cast<int>(size), file) != nullptr);
+   fclose(file);
+
+   return (success);
+}
+
+/******************************************************************************/
+static int32_t ReadValue(const std::string& path)
+{
+   char text[32];
+   char* end = nullptr;
+
+   if (path.empty() || !ReadText(path, text, sizeof(text)))
+   {
+      return (GLTLSNoValue);
+   }
+
+   long value = strtol(text, &end, 10);
+   if (end == text)
+   {
+      return (GLTLSNoValue);
+   }
+
+   return static_cast<int32_t>(std::max<long>(std::min<long>(value, INT32_MAX), INT32_MIN + 1));
+}
+
+/******************************************************************************/
+// Lowest of the limits that can be read, GLTLSNoValue when none can.
+static int32_t ReadLowestValue(const std::vector<std::string>& paths)
+{
+   int32_t lowest = GLTLSNoValue;
+
+   for (const std::string& path : paths)
+   {
+      int32_t value = ReadValue(path);
+      if (value != GLTLSNoValue && (lowest == GLTLSNoValue || value < lowest))
+      {
+         lowest = value;
+      }
+   }
+
+   return (lowest);
+}
+
+/******************************************************************************/
+// Numbers of the entries of directory named prefix<N>suffix, in order.
+static std::vector<uint32_t> NumberedEntries(
+      const std::string& directory,
+      const std::string& prefix,
+      const std::string& suffix)
+{
+   std::vector<uint32_t> numbers;
+   DIR* dir = opendir(directory.c_str());
+
+   if (dir == nullptr)
+   {
+      return (numbers);
+   }
+
+   struct dirent* entry;
+   while ((entry = readdir(dir)) != nullptr)
+   {
+      std::string name(entry->d_name);
+      if (name.size() <= prefix.size() + suffix.size() ||
+         name.compare(0, prefix.size(), prefix) != 0 ||
+         name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+      {
+         continue;
+      }
+
+      std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+      if (std::all_of(digits.begin(), digits.end(), ::isdigit))
+      {
+         numbers.push_back(static_cast<uint32_t>(strtoul(digits.c_str(), nullptr, 10)));
+      }
+   }
+   closedir(dir);
+
+   std::sort(numbers.begin(), numbers.end());
+
+   return (numbers);
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLTelemetrySampler::GLTelemetrySampler()
+   :
+   m_IntervalMs(GLTLSSampleIntervalMs),
+   m_Samples(0),
+   m_Sequence(0),
+   m_Listener(nullptr),
+   m_StopRequested(false)
+{
+}
+
+/******************************************************************************/
+GLTelemetrySampler::~GLTelemetrySampler()
+{
+   Stop();
+}
+
+/******************************************************************************/
+bool GLTelemetrySampler::Active()
+{
+   return (m_Thread.joinable());
+}
+
+/******************************************************************************/
+uint64_t GLTelemetrySampler::NowNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_MONOTONIC, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * GLTLSNanosecondsPerSecond +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
+/******************************************************************************/
+GLTelemetryHistory& GLTelemetrySampler::History()
+{
+   return (m_History);
+}
+
+/******************************************************************************/
+bool GLTelemetrySampler::Start(const std::string& root, uint32_t intervalMs)
+{
+   if (Active())
+   {
+      return (false);
+   }
+
+   FindSensors(root);
+   m_History.Reset(static_cast<uint32_t>(m_Zones.size()), static_cast<uint32_t>(m_Channels.size()));
+   m_IntervalMs = std::max<uint32_t>(intervalMs, 1);
+   m_StopRequested = false;
+
+   // The handlers have a snapshot from the start.
+   Sample();
+   m_Thread = std::thread(&GLTelemetrySampler::SamplerThread, this);
+
+   return (true);
+}
+
+/******************************************************************************/
+void GLTelemetrySampler::Stop()
+{
+   if (Active())
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_StopMutex);
+         m_StopRequested = true;
+      }
+      m_StopCondition.notify_all();
+      m_Thread.join();
+   }
+}
+
+/******************************************************************************/
+void GLTelemetrySampler::FindSensors(const std::string& root)
+{
+   m_Zones.clear();
+   m_Channels.clear();
+
+   std::string thermal = root + GLTLSThermalDirectory;
+   for (uint32_t number : NumberedEntries(thermal, "thermal_zone", ""))
+   {
+      if (m_Zones.size() >= GLTLSMaximumSensors)
+      {
+         break;
+      }
+
+      std::string zone = thermal + "/thermal_zone" + std::to_string(number);
+      GL_TELEMETRY_ZONE_TYPE sensor;
+      sensor.tempPath = zone + "/temp";
+      if (!FileExists(sensor.tempPath))
+      {
+         continue;
+      }
+
+      for (uint32_t trip = 0; trip < GLTLSMaximumTripPoints; trip++)
+      {
+         std::string tripPath = zone + "/trip_point_" + std::to_string(trip);
+         char type[32] = {0};
+         if (!ReadText(tripPath + "_type", type, sizeof(type)))
+         {
+            break;
+         }
+
+         std::string tripType(type);
+         if (tripType.compare(0, 8, "critical") == 0)
+         {
+            sensor.criticalTripPaths.push_back(tripPath + "_temp");
+         }
+         else if (tripType.compare(0, 7, "passive") == 0 || tripType.compare(0, 3, "hot") == 0)
+         {
+            sensor.passiveTripPaths.push_back(tripPath + "_temp");
+         }
+      }
+
+      m_Zones.push_back(sensor);
+   }
+
+   std::string hwmon = root + GLTLSHwmonDirectory;
+   for (uint32_t number : NumberedEntries(hwmon, "hwmon", ""))
+   {
+      std::string device = hwmon + "/hwmon" + std::to_string(number);
+      for (uint32_t input : NumberedEntries(device, "in", "_input"))
+      {
+         if (m_Channels.size() >= GLTLSMaximumSensors)
+         {
+            break;
+         }
+
+         std::string channel = device + "/in" + std::to_string(input);
+         GL_TELEMETRY_CHANNEL_TYPE sensor;
+         sensor.inputPath = channel + "_input";
+         sensor.minimumPath = FileExists(channel + "_min") ? channel + "_min" : "";
+         sensor.maximumPath = FileExists(channel + "_max") ? channel + "_max" : "";
+         m_Channels.push_back(sensor);
+      }
+   }
+}
+
+/******************************************************************************/
+void GLTelemetrySampler::SamplerThread()
+{
+   std::unique_lock<std::mutex> lock(m_StopMutex);
+
+   while (!m_StopRequested)
+   {
+      m_StopCondition.wait_for(lock, std::chrono::milliseconds(m_IntervalMs));
+      if (!m_StopRequested)
+      {
+         lock.unlock();
+         Sample();
+         lock.lock();
+      }
+   }
+}
+
+/******************************************************************************/
+void GLTelemetrySampler::Sample()
+{
+   GL_TELEMETRY_SNAPSHOT_TYPE snapshot;
+
+   snapshot.zoneCount = static_cast<uint8_t>(m_Zones.size());
+   for (size_t index = 0; index < m_Zones.size(); index++)
+   {
+      snapshot.temperatureMilliC[index] = ReadValue(m_Zones[index].tempPath);
+      snapshot.passiveLimitMilliC[index] = ReadLowestValue(m_Zones[index].passiveTripPaths);
+      snapshot.criticalLimitMilliC[index] = ReadLowestValue(m_Zones[index].criticalTripPaths);
+   }
+
+   snapshot.channelCount = static_cast<uint8_t>(m_Channels.size());
+   for (size_t index = 0; index < m_Channels.size(); index++)
+   {
+      snapshot.voltageMilliV[index] = ReadValue(m_Channels[index].inputPath);
+      snapshot.minimumMilliV[index] = ReadValue(m_Channels[index].minimumPath);
+      snapshot.maximumMilliV[index] = ReadValue(m_Channels[index].maximumPath);
+   }
+
+   snapshot.samples = ++m_Samples;
+   snapshot.sampleTimeNs = NowNs();
+
+   Publish(snapshot);
+   m_History.Append(snapshot);
+
+   std::lock_guard<std::mutex> lock(m_ListenerMutex);
+   if (m_Listener != nullptr)
+   {
+      m_Listener->EventTelemetrySampled(snapshot);
+   }
+}
+
+/******************************************************************************/
+void GLTelemetrySampler::SetListener(GLTelemetrySamplerIntf* listener)
+{
+   std::lock_guard<std::mutex> lock(m_ListenerMutex);
+   m_Listener = listener;
+}
+
+/******************************************************************************/
+void GLTelemetrySampler::Publish(const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot)
+{
+   uint64_t sequence = m_Sequence.load(std::memory_order_relaxed);
+
+   m_Sequence.store(sequence + 1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+
+   m_Snapshot = snapshot;
+
+   m_Sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/******************************************************************************/
+bool GLTelemetrySampler::Snapshot(GL_TELEMETRY_SNAPSHOT_TYPE& snapshot)
+{
+   uint64_t before;
+   uint64_t after;
+
+   do
+   {
+      before = m_Sequence.load(std::memory_order_acquire);
+      snapshot = m_Snapshot;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = m_Sequence.load(std::memory_order_relaxed);
+   } while ((before & 1) != 0 || before != after);
+
+   return (snapshot.samples > 0);
+}
+
+/******************************************************************************/
@@ -0,0 +1,169 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTelemetrySampler.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the SoC telemetry sampler.  A
+   background thread reads the thermal zones and the hwmon voltage inputs
+   under a sysfs root every GLTLSSampleIntervalMs and publishes them, with
+   their limits, as one snapshot.  The GET_SOC_TEMPERATURE / VOLTAGE and
+   limit handlers copy the snapshot and never touch the file system.
+
+      <root>/class/thermal/thermal_zone<N>/temp                 m°C
+      <root>/class/thermal/thermal_zone<N>/trip_point_<K>_type  passive, hot,
+      <root>/class/thermal/thermal_zone<N>/trip_point_<K>_temp  critical ...
+      <root>/class/hwmon/hwmon<N>/in<K>_input                   mV
+      <root>/class/hwmon/hwmon<N>/in<K>_min, in<K>_max          mV
+
+   The sensors are found once, at Start(), in zone and channel order.  The
+   root is /sys unless UCRP_SYSFS_ROOT names another one, e.g. a directory
+   tree of fake sensors for a test.
+
+   Every sample is also appended to the history, see GLTelemetryHistory.h.
+   A listener set with SetListener() is handed every sample on the sampler
+   thread, e.g. to evaluate alarm rules once per sample.
+
+   The snapshot is a seqlock: the sampler makes the sequence odd, writes,
+   and makes it even again; a reader copies it and retries when the
+   sequence was odd or changed meanwhile.
+*/
+/******************************************************************************/
+#ifndef gl_telemetry_sampler_h
+#define gl_telemetry_sampler_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GLTelemetryHistory.h"
+#include "GLTelemetrySamplerIntf.h"
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const bool GLTLSSamplerEnabled = true;
+static const std::string GLTLSSysfsRoot("/sys");
+static const char* const GLTLSSysfsRootVariable = "UCRP_SYSFS_ROOT";
+const uint32_t GLTLSSampleIntervalMs = 1000;
+// Thermal zones and voltage channels kept; the rest are left out.
+const uint32_t GLTLSMaximumSensors = 16;
+// A reading or limit the sysfs tree does not give.
+const int32_t GLTLSNoValue = INT32_MIN;
+
+}
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef struct gl_telemetry_snapshot_struct
+{
+   uint64_t sampleTimeNs = 0;            // CLOCK_MONOTONIC; 0 before the first
+   uint32_t samples = 0;
+   uint8_t zoneCount = 0;
+   uint8_t channelCount = 0;
+   int32_t temperatureMilliC[GLTLSMaximumSensors] = {};
+   int32_t passiveLimitMilliC[GLTLSMaximumSensors] = {};   // lowest passive or hot trip
+   int32_t criticalLimitMilliC[GLTLSMaximumSensors] = {};  // lowest critical trip
+   int32_t voltageMilliV[GLTLSMaximumSensors] = {};
+   int32_t minimumMilliV[GLTLSMaximumSensors] = {};
+   int32_t maximumMilliV[GLTLSMaximumSensors] = {};
+} GL_TELEMETRY_SNAPSHOT_TYPE;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class GLTelemetrySampler
+{
+   public:
+      GLTelemetrySampler();
+      ~GLTelemetrySampler();
+
+      // Finds the sensors under root, takes the first sample and starts the
+      // thread.  False when the thread is already running.
+      bool Start(const std::string& root, uint32_t intervalMs);
+      void Stop();
+      bool Active();
+
+      // May be called from any thread; false until the first sample.
+      bool Snapshot(GL_TELEMETRY_SNAPSHOT_TYPE& snapshot);
+      static uint64_t NowNs();
+      // May be read from any thread.
+      GLTelemetryHistory& History();
+
+      // May be called while the thread runs; nullptr removes the listener
+      // and returns once no call to it is in progress.
+      void SetListener(GLTelemetrySamplerIntf* listener);
+
+   private:
+      typedef struct gl_telemetry_zone_struct
+      {
+         std::string tempPath;
+         std::vector<std::string> passiveTripPaths;
+         std::vector<std::string> criticalTripPaths;
+      } GL_TELEMETRY_ZONE_TYPE;
+
+      typedef struct gl_telemetry_channel_struct
+      {
+         std::string inputPath;
+         std::string minimumPath;
+         std::string maximumPath;
+      } GL_TELEMETRY_CHANNEL_TYPE;
+
+      void FindSensors(const std::string& root);
+      void SamplerThread();
+      void Sample();
+      void Publish(const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot);
+
+      std::vector<GL_TELEMETRY_ZONE_TYPE> m_Zones;
+      std::vector<GL_TELEMETRY_CHANNEL_TYPE> m_Channels;
+      uint32_t m_IntervalMs;
+      uint32_t m_Samples;
+
+      std::atomic<uint64_t> m_Sequence;
+      GL_TELEMETRY_SNAPSHOT_TYPE m_Snapshot;
+      GLTelemetryHistory m_History;
+
+      GLTelemetrySamplerIntf* m_Listener;
+      std::mutex m_ListenerMutex;
+
+      std::thread m_Thread;
+      bool m_StopRequested;
+      std::mutex m_StopMutex;
+      std::condition_variable m_StopCondition;
+};
+
+using GLTelemetrySamplerPtr = std::unique_ptr<GLTelemetrySampler>;
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_telemetry_sampler_h */
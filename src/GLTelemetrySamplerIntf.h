@@ -0,0 +1,45 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTelemetrySamplerIntf.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the interface definition for the listener of the SoC
+   telemetry sampler.
+*/
+/******************************************************************************/
+#ifndef gl_telemetry_sampler_intf_h
+#define gl_telemetry_sampler_intf_h
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+struct gl_telemetry_snapshot_struct;
+
+class GLTelemetrySamplerIntf
+{
+   // Methods required to receive each sample of the GLTelemetrySampler.
+
+   public:
+      // Called on the sampler thread right after the snapshot is published.
+      // Must not block; the next sample waits for it.
+      virtual void EventTelemetrySampled(const gl_telemetry_snapshot_struct& snapshot) = 0;
+
+      virtual ~GLTelemetrySamplerIntf() {};
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_telemetry_sampler_intf_h */
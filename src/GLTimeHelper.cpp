@@ -18,7 +18,10 @@
 /*       I N C L U D E S                                                      */
 /******************************************************************************/
 #include "stdio.h"
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <ctime>
@@ -26,6 +29,8 @@
 #include <string>
 
 #include "GLTimeHelper.h"
+#include "GLTscClock.h"
+#include "GLVirtualClock.h"
 
 using namespace MDN;
 
@@ -37,11 +42,66 @@ using std::chrono::system_clock;
 /******************************************************************************/
 /*                            C O N S T A N T S                               */
 /******************************************************************************/
-const uint32_t GLTimeHelper::m_theMaximumFieldTypeWidth = 10;
 const uint64_t GLTimeHelper::m_theNanosecondsPerSecond = 1000000000;
 const uint64_t GLTimeHelper::m_theNanosecondsPerMs =
       GLTimeHelper::m_theNanosecondsPerSecond / 1000;
 
+static const uint64_t GLTHNanosecondsInAMinute = 60000000000;
+static const uint64_t GLTHNanosecondsInAnHour = 3600000000000;
+static const uint64_t GLTHNanosecondsInADay = 86400000000000;
+static const uint32_t GLTHMaximumTimeStampDays = 99999;
+static const size_t GLTHTimeStampPrefixLength = 12;   // "DDDDD:HH:MM:"
+
+/******************************************************************************/
+/*                          D A T A  M O D E L S                              */
+/******************************************************************************/
+typedef struct gl_time_stamp_prefix_struct
+{
+   uint64_t minuteStartNs;
+   uint64_t minuteEndNs;
+   char text[GLTHTimeStampPrefixLength];
+} GL_TIME_STAMP_PREFIX_TYPE;
+
+/******************************************************************************/
+/*       G L O B A L  V A R S                                                 */
+/******************************************************************************/
+// An empty range, so the first call on a thread fills it in.
+static thread_local GL_TIME_STAMP_PREFIX_TYPE m_theTimeStampPrefix = {1, 0, {}};
+
+static constexpr std::array<char, 200> MakeDigitPairs()
+{
+   std::array<char, 200> pairs{};
+
+   for (uint32_t value = 0; value < 100; value++)
+   {
+      pairs[value * 2] = static_cast<char>('0' + value / 10);
+      pairs[value * 2 + 1] = static_cast<char>('0' + value % 10);
+   }
+
+   return pairs;
+}
+
+// "000102...99", two characters per value.
+static constexpr std::array<char, 200> m_theDigitPairs = MakeDigitPairs();
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static inline char* PutDigitPair(char* out, uint32_t value)
+{
+   std::memcpy(out, &m_theDigitPairs[value * 2], 2);
+
+   return out + 2;
+}
+
+/******************************************************************************/
+static inline char* PutDigitTriple(char* out, uint32_t value)
+{
+   *out++ = static_cast<char>('0' + value / 100);
+
+   return PutDigitPair(out, value % 100);
+}
+
 /******************************************************************************/
 /*                           D A T A  M O D E L S                             */
 /******************************************************************************/
@@ -80,14 +140,71 @@ const uint64_t GLTimespecNs::Nanoseconds()
 /******************************************************************************/
 /*                      I M P L E M E N T A T I O N                           */
 /******************************************************************************/
-GLTimeHelper::GLTimeHelper(GLTHTimeStampModeType mode)
+GLTimeHelper::GLTimeHelper(
+      GLTHTimeStampModeType mode,
+      GLTHClockSourceType source)
+   :
+   m_SystemStartTime(GetSystemTime()),
+   m_MeasurementStartTime(m_SystemStartTime),
+   m_LinuxSystemStartTimeNs(0),
+   m_LinuxMeasurementStartTimeNs(0),
+   m_TimeStampMode(mode),
+   m_ClockSource(SelectClockSource(source)),
+   m_ClockId(CLOCK_REALTIME),
+   m_TscClock(nullptr),
+   m_VirtualClock(nullptr),
+   m_EpochOffsetNs(0)
+{
+   InitializeClock();
+}
+
+/******************************************************************************/
+GLTimeHelper::GLTimeHelper(
+      GLTHTimeStampModeType mode,
+      GLVirtualClock& virtualClock)
    :
    m_SystemStartTime(GetSystemTime()),
    m_MeasurementStartTime(m_SystemStartTime),
-   m_LinuxSystemStartTimeNs(GetLinuxSystemTimeNs()),
-   m_LinuxMeasurementStartTimeNs(m_LinuxSystemStartTimeNs),
-   m_TimeStampMode(mode)
+   m_LinuxSystemStartTimeNs(0),
+   m_LinuxMeasurementStartTimeNs(0),
+   m_TimeStampMode(mode),
+   m_ClockSource(GLTH_CLOCK_SOURCE_VIRTUAL),
+   m_ClockId(CLOCK_MONOTONIC),
+   m_TscClock(nullptr),
+   m_VirtualClock(&virtualClock),
+   m_EpochOffsetNs(0)
+{
+   InitializeClock();
+}
+
+/******************************************************************************/
+void GLTimeHelper::InitializeClock()
 {
+   switch (m_ClockSource)
+   {
+      case GLTH_CLOCK_SOURCE_MONOTONIC:
+         m_ClockId = CLOCK_MONOTONIC;
+         break;
+
+      case GLTH_CLOCK_SOURCE_MONOTONIC_COARSE:
+         m_ClockId = CLOCK_MONOTONIC_COARSE;
+         break;
+
+      case GLTH_CLOCK_SOURCE_TSC:
+         m_ClockId = CLOCK_MONOTONIC;
+         m_TscClock = GLTscClock::Instance();
+         break;
+
+      case GLTH_CLOCK_SOURCE_VIRTUAL:
+      case GLTH_CLOCK_SOURCE_REALTIME:
+      default:
+         break;
+   }
+
+   // The start references depend on the clock chosen above.
+   m_EpochOffsetNs = GetEpochOffsetNs();
+   m_LinuxSystemStartTimeNs = GetLinuxSystemTimeNs();
+   m_LinuxMeasurementStartTimeNs = m_LinuxSystemStartTimeNs;
 }
 
 /******************************************************************************/
@@ -118,90 +235,174 @@ uint64_t GLTimeHelper::GetTimeInNs()
 }
 
 /******************************************************************************/
-std::string GLTimeHelper::GetTimeStampInUs()
+uint64_t GLTimeHelper::GetEpochTimeInNs()
 {
-   return ConvertNsIntoTimeStampUs(GetTimeInNs());
+   return GetLinuxTimeElapsedSinceEpochNs();
 }
 
 /******************************************************************************/
-std::string GLTimeHelper::ConvertNsIntoTimeStampUs(uint64_t time)
+uint64_t GLTimeHelper::GetRealtimeInNs()
 {
-   const uint64_t NANOSECONDS_IN_A_DAY = 86400000000000;
-   const uint64_t NANOSECONDS_IN_AN_HOUR = 3600000000000;
-   const uint64_t NANOSECONDS_IN_A_MIN = 60000000000;
-   const uint64_t NANOSECONDS_IN_A_SEC = 1000000000;
-   const uint64_t NANOSECONDS_IN_A_MS = 1000000;
-   const uint64_t NANOSECONDS_IN_A_US = 1000;
-
-   int32_t Days = time / NANOSECONDS_IN_A_DAY;
-   time = time - Days * NANOSECONDS_IN_A_DAY;
-
-   int32_t Hours = time / NANOSECONDS_IN_AN_HOUR;
-   time = time - Hours * NANOSECONDS_IN_AN_HOUR;
-
-   int32_t Mins = time / NANOSECONDS_IN_A_MIN;
-   time = time - Mins * NANOSECONDS_IN_A_MIN;
+   struct timespec tm;
 
-   int32_t Secs = time / NANOSECONDS_IN_A_SEC;
-   time = time - Secs * NANOSECONDS_IN_A_SEC;
+   clock_gettime(CLOCK_REALTIME, &tm);
 
-   int32_t Msecs = time / NANOSECONDS_IN_A_MS;
-   time = time - Msecs * NANOSECONDS_IN_A_MS;
+   return GLTimespecNs(tm).Nanoseconds();
+}
 
-   int32_t Usecs = time / NANOSECONDS_IN_A_US;
-   time = time - Usecs * NANOSECONDS_IN_A_US;
+/******************************************************************************/
+uint64_t GLTimeHelper::GetTimelineEpochInNs()
+{
+   uint64_t epochNs = 0;
 
-   //int64_t Nsecs = time;
+   if (m_TimeStampMode == GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START)
+   {
+      epochNs = m_LinuxSystemStartTimeNs.Nanoseconds() + m_EpochOffsetNs;
+   }
 
-   // 27 char + "/0" timestamp
-   std::string timeString =
-         IntToFixedWidthString(Days, GLTH_DAYS) + ":" +
-         IntToFixedWidthString(Hours, GLTH_HOURS) + ":" +
-         IntToFixedWidthString(Mins, GLTH_MINS) + ":" +
-         IntToFixedWidthString(Secs, GLTH_SECS) + "::" +
-         IntToFixedWidthString(Msecs, GLTH_MS) + "::" +
-         IntToFixedWidthString(Usecs, GLTH_US) + " us";
+   return epochNs;
+}
 
-   return timeString;
+/******************************************************************************/
+GLTHClockSourceType GLTimeHelper::ClockSource()
+{
+   return m_ClockSource;
 }
 
 /******************************************************************************/
-std::string GLTimeHelper::IntToFixedWidthString(int32_t value, GLTH_DATETIME_TYPE type)
+const char* GLTimeHelper::ClockSourceName(GLTHClockSourceType source)
 {
-   char buffer[GLTimeHelper::m_theMaximumFieldTypeWidth + 1];
-   int32_t fixedwidth;
-   const int32_t maxchars = sizeof(buffer);
+   const char* name;
 
-   switch (type)
+   switch (source)
    {
-      case GLTH_DAYS:
-         fixedwidth = 5;
+      case GLTH_CLOCK_SOURCE_REALTIME:
+         name = "CLOCK_REALTIME";
          break;
-      case GLTH_HOURS:
-         fixedwidth = 2;
-         break;
-      case GLTH_MINS:
-         fixedwidth = 2;
+
+      case GLTH_CLOCK_SOURCE_MONOTONIC:
+         name = "CLOCK_MONOTONIC";
          break;
-      case GLTH_SECS:
-         fixedwidth = 2;
+
+      case GLTH_CLOCK_SOURCE_MONOTONIC_COARSE:
+         name = "CLOCK_MONOTONIC_COARSE";
          break;
-      case GLTH_MS:
-         fixedwidth = 3;
+
+      case GLTH_CLOCK_SOURCE_TSC:
+         name = "TSC";
          break;
-      case GLTH_US:
-         fixedwidth = 3;
+
+      case GLTH_CLOCK_SOURCE_VIRTUAL:
+         name = "VIRTUAL";
          break;
-      case GLTH_NS:
+
       default:
-         fixedwidth = 3;
+         name = "UNKNOWN";
          break;
    }
 
-   snprintf(buffer, maxchars, "%.*d", fixedwidth, value);
-   std::string s = std::string(buffer);
+   return name;
+}
+
+/******************************************************************************/
+GLTHClockSourceType GLTimeHelper::SelectClockSource(GLTHClockSourceType source)
+{
+   if (source == GLTH_CLOCK_SOURCE_TSC && GLTscClock::Instance() == nullptr)
+   {
+      source = GLTH_CLOCK_SOURCE_MONOTONIC;
+   }
+
+   // Only the constructor taking a GLVirtualClock can select it.
+   if (source == GLTH_CLOCK_SOURCE_VIRTUAL)
+   {
+      source = GLTH_CLOCK_SOURCE_MONOTONIC;
+   }
 
-   return s;
+   return source;
+}
+
+/******************************************************************************/
+std::string GLTimeHelper::GetTimeStampInUs()
+{
+   return ConvertNsIntoTimeStampUs(GetTimeInNs());
+}
+
+/******************************************************************************/
+std::string GLTimeHelper::ConvertNsIntoTimeStampUs(uint64_t time)
+{
+   char buffer[GLTHTimeStampBufferSize];
+   size_t length = FormatNsIntoTimeStampUs(time, buffer, sizeof(buffer));
+
+   return std::string(buffer, length);
+}
+
+/******************************************************************************/
+size_t GLTimeHelper::FormatNsIntoTimeStampUs(
+      uint64_t time,
+      char* buffer,
+      size_t bufferSize)
+{
+   if (bufferSize < GLTHTimeStampBufferSize)
+   {
+      return 0;
+   }
+
+   if (time / GLTHNanosecondsInADay > GLTHMaximumTimeStampDays)
+   {
+      // Too wide for the fixed layout; rare enough for the slow path.
+      int length = snprintf(buffer, bufferSize, "%lu:%.2lu:%.2lu:%.2lu::%.3lu::%.3lu us",
+            time / GLTHNanosecondsInADay,
+            (time / GLTHNanosecondsInAnHour) % 24,
+            (time / GLTHNanosecondsInAMinute) % 60,
+            (time / m_theNanosecondsPerSecond) % 60,
+            (time / m_theNanosecondsPerMs) % 1000,
+            (time / 1000) % 1000);
+      return std::min(static_cast<size_t>(length), bufferSize - 1);
+   }
+
+   // "DDDDD:HH:MM:" only changes once a minute, so consecutive log lines
+   // reuse it.
+   GL_TIME_STAMP_PREFIX_TYPE& prefix = m_theTimeStampPrefix;
+   if (time < prefix.minuteStartNs || time >= prefix.minuteEndNs)
+   {
+      uint64_t minuteStartNs = time - time % GLTHNanosecondsInAMinute;
+      uint32_t days = static_cast<uint32_t>(minuteStartNs / GLTHNanosecondsInADay);
+      uint32_t hours = static_cast<uint32_t>((minuteStartNs / GLTHNanosecondsInAnHour) % 24);
+      uint32_t mins = static_cast<uint32_t>((minuteStartNs / GLTHNanosecondsInAMinute) % 60);
+
+      char* out = prefix.text;
+      *out++ = static_cast<char>('0' + days / 10000);
+      out = PutDigitPair(out, (days / 100) % 100);
+      out = PutDigitPair(out, days % 100);
+      *out++ = ':';
+      out = PutDigitPair(out, hours);
+      *out++ = ':';
+      out = PutDigitPair(out, mins);
+      *out++ = ':';
+
+      prefix.minuteStartNs = minuteStartNs;
+      prefix.minuteEndNs = minuteStartNs + GLTHNanosecondsInAMinute;
+   }
+
+   uint64_t withinMinuteNs = time - prefix.minuteStartNs;
+   uint32_t secs = static_cast<uint32_t>(withinMinuteNs / m_theNanosecondsPerSecond);
+   uint32_t msecs = static_cast<uint32_t>((withinMinuteNs / m_theNanosecondsPerMs) % 1000);
+   uint32_t usecs = static_cast<uint32_t>((withinMinuteNs / 1000) % 1000);
+
+   std::memcpy(buffer, prefix.text, GLTHTimeStampPrefixLength);
+   char* out = buffer + GLTHTimeStampPrefixLength;
+   out = PutDigitPair(out, secs);
+   *out++ = ':';
+   *out++ = ':';
+   out = PutDigitTriple(out, msecs);
+   *out++ = ':';
+   *out++ = ':';
+   out = PutDigitTriple(out, usecs);
+   std::memcpy(out, " us", 3);
+   out += 3;
+   *out = '\0';
+
+   return static_cast<size_t>(out - buffer);
 }
 
 /******************************************************************************/
@@ -236,12 +437,22 @@ std::string GLTimeHelper::GetCurrentDateTimeString()
 void GLTimeHelper::GetLinuxSystemTime(struct timespec* tm)
 {
    // Note: LINUX / UNIX function
-   clock_gettime(CLOCK_REALTIME, tm);
+   clock_gettime(m_ClockId, tm);
 }
 
 /******************************************************************************/
 GLTimespecNs GLTimeHelper::GetLinuxSystemTimeNs()
 {
+   if (m_VirtualClock != nullptr)
+   {
+      return GLTimespecNs(m_VirtualClock->GetTimeInNs());
+   }
+
+   if (m_TscClock != nullptr)
+   {
+      return GLTimespecNs(m_TscClock->GetTimeInNs());
+   }
+
    struct timespec tm;
 
    GetLinuxSystemTime(&tm);
@@ -250,6 +461,24 @@ GLTimespecNs GLTimeHelper::GetLinuxSystemTimeNs()
    return timespecNs;
 }
 
+/******************************************************************************/
+uint64_t GLTimeHelper::GetEpochOffsetNs()
+{
+   uint64_t offsetNs = 0;
+
+   // A virtual clock stays on its own timeline so runs are reproducible.
+   if (m_ClockSource != GLTH_CLOCK_SOURCE_REALTIME &&
+      m_ClockSource != GLTH_CLOCK_SOURCE_VIRTUAL)
+   {
+      struct timespec tm;
+
+      clock_gettime(CLOCK_REALTIME, &tm);
+      offsetNs = GLTimespecNs(tm).Nanoseconds() - GetLinuxSystemTimeNs().Nanoseconds();
+   }
+
+   return offsetNs;
+}
+
 /******************************************************************************/
 uint64_t GLTimeHelper::GetLinuxTimeElapsedNs()
 {
@@ -263,8 +492,10 @@ uint64_t GLTimeHelper::GetLinuxTimeElapsedNs()
 /******************************************************************************/
 uint64_t GLTimeHelper::GetLinuxTimeElapsedSinceEpochNs()
 {
-   // Assume system time is already set to epoch time
-   return GetLinuxSystemTimeNs().Nanoseconds();
+   // Assume system time is already set to epoch time.  A monotonic source is
+   // lined up with the wall clock once at construction and does not follow
+   // later steps of it.
+   return GetLinuxSystemTimeNs().Nanoseconds() + m_EpochOffsetNs;
 }
 
 /******************************************************************************/
@@ -43,6 +43,15 @@ typedef enum
    GLTH_TIMESTAMP_MODE_EPOCH_TIME,
 } GLTHTimeStampModeType;
 
+typedef enum
+{
+   GLTH_CLOCK_SOURCE_REALTIME,
+   GLTH_CLOCK_SOURCE_MONOTONIC,
+   GLTH_CLOCK_SOURCE_MONOTONIC_COARSE,
+   GLTH_CLOCK_SOURCE_TSC,
+   GLTH_CLOCK_SOURCE_VIRTUAL,   // Driven by a GLVirtualClock, for simulation
+} GLTHClockSourceType;
+
 typedef enum
 {
    GLTH_DAYS = 0,
@@ -54,6 +63,18 @@ typedef enum
    GLTH_NS
 } GLTH_DATETIME_TYPE;
 
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+
+// Monotonic sources keep log timestamps in order when NTP steps the wall
+// clock.  The TSC source falls back to CLOCK_MONOTONIC on a processor
+// without an invariant TSC.
+const GLTHClockSourceType GLTHDefaultClockSource = GLTH_CLOCK_SOURCE_TSC;
+
+// "DDDDD:HH:MM:SS::mmm::uuu us" plus the terminating NUL.
+const size_t GLTHTimeStampBufferSize = 28;
+
 /******************************************************************************/
 /*                           D A T A  M O D E L S                             */
 /******************************************************************************/
@@ -78,21 +99,49 @@ class GLTimespecNs
 namespace MDN
 {
 
+class GLTscClock;
+class GLVirtualClock;
+
 class GLTimeHelper
 {
    public:
-      GLTimeHelper(GLTHTimeStampModeType mode);
+      GLTimeHelper(
+            GLTHTimeStampModeType mode,
+            GLTHClockSourceType source = GLTHDefaultClockSource);
+      // GLTH_CLOCK_SOURCE_VIRTUAL; the clock has to outlive the helper.
+      GLTimeHelper(
+            GLTHTimeStampModeType mode,
+            GLVirtualClock& virtualClock);
       ~GLTimeHelper();
 
       std::string ConvertNsIntoTimeStampUs(uint64_t time);
+
+      // Writes "DDDDD:HH:MM:SS::mmm::uuu us" and a terminating NUL without
+      // allocating.  Returns the length written, 0 if bufferSize is smaller
+      // than GLTHTimeStampBufferSize.
+      static size_t FormatNsIntoTimeStampUs(
+            uint64_t time,
+            char* buffer,
+            size_t bufferSize);
       uint64_t GetTimeInNs();
+      // Nanoseconds since the epoch whatever the timestamp mode; a monotonic
+      // source is lined up with CLOCK_REALTIME once at construction.
+      uint64_t GetEpochTimeInNs();
+      // CLOCK_REALTIME as read now, the clock of the kernel receive
+      // timestamps; stepped and slewed by NTP.
+      uint64_t GetRealtimeInNs();
+      // Epoch time of GetTimeInNs() zero: the construction time in
+      // GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START, 0 in epoch mode.  Log
+      // timestamps plus this value are epoch times.
+      uint64_t GetTimelineEpochInNs();
+      GLTHClockSourceType ClockSource();
+      static const char* ClockSourceName(GLTHClockSourceType source);
 
       // P U B LI C  C L A S S  C O N S T A N T S
       static const uint64_t m_theNanosecondsPerSecond;
       static const uint64_t m_theNanosecondsPerMs;
 
    private:
-      std::string IntToFixedWidthString(int32_t value, GLTH_DATETIME_TYPE type);
       std::string GetCurrentDateTimeString();
 
        //Linux format
@@ -108,14 +157,21 @@ class GLTimeHelper
       hrc::time_point GetSystemTime();
 
 
+      static GLTHClockSourceType SelectClockSource(GLTHClockSourceType source);
+      void InitializeClock();
+      uint64_t GetEpochOffsetNs();
+
       hrc::time_point m_SystemStartTime;
       hrc::time_point m_MeasurementStartTime;
       GLTimespecNs m_LinuxSystemStartTimeNs;
       GLTimespecNs m_LinuxMeasurementStartTimeNs;
       GLTHTimeStampModeType m_TimeStampMode;
+      GLTHClockSourceType m_ClockSource;
+      clockid_t m_ClockId;
+      GLTscClock* m_TscClock;
+      GLVirtualClock* m_VirtualClock;
+      uint64_t m_EpochOffsetNs;
 
-      // C L A S S  C O N S T A N T S
-      static const uint32_t m_theMaximumFieldTypeWidth;
 
 };
 
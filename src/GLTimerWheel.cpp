@@ -0,0 +1,441 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTimerWheel.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the hierarchical timer wheel.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "GLTimeHelper.h"
+#include "GLTimerWheel.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint32_t GLTWNoNode = UINT32_MAX;
+static const uint32_t GLTWSlotMask = GLTWSlots - 1;
+static const uint64_t GLTWNoTick = UINT64_MAX;
+static const uint64_t GLTWMaximumDeltaTicks =
+      (static_cast<uint64_t>(1) << (GLTWSlotBits * GLTWLevels)) - 1;
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLTimerWheel::GLTimerWheel(GLTimeHelper& timeHelper)
+   :
+   m_TimeHelper(timeHelper),
+   m_Nodes(GLTWMaximumTimers),
+   m_FreeHead(0),
+   m_ActiveTimers(0),
+   m_StartNs(timeHelper.GetTimeInNs()),
+   m_CurrentTick(0),
+   m_ArmedTick(GLTWNoTick),
+   m_TimerFd(-1)
+{
+   for (auto& level : m_Slots)
+   {
+      level.fill(GLTWNoNode);
+   }
+   for (auto& level : m_Occupied)
+   {
+      level.fill(0);
+   }
+
+   for (uint32_t index = 0; index < GLTWMaximumTimers; index++)
+   {
+      GL_TIMER_NODE_TYPE& node = m_Nodes[index];
+      node.next = (index + 1 < GLTWMaximumTimers) ? index + 1 : GLTWNoNode;
+      node.prev = GLTWNoNode;
+      node.generation = 1;
+      node.active = false;
+   }
+
+   m_ExpiredBatch.reserve(GLTWMaximumTimers);
+
+   m_TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+}
+
+/******************************************************************************/
+GLTimerWheel::~GLTimerWheel()
+{
+   if (m_TimerFd >= 0)
+   {
+      close(m_TimerFd);
+   }
+}
+
+/******************************************************************************/
+GLTimerId GLTimerWheel::MakeTimerId(uint32_t index, uint32_t generation)
+{
+   // Generations start at 1 so no valid id is ever GLTWInvalidTimerId.
+   return (static_cast<uint64_t>(generation) << 32) | index;
+}
+
+/******************************************************************************/
+uint64_t GLTimerWheel::NowTick()
+{
+   uint64_t nowNs = m_TimeHelper.GetTimeInNs();
+
+   return (nowNs > m_StartNs) ? (nowNs - m_StartNs) / GLTWTickNs : 0;
+}
+
+/******************************************************************************/
+void GLTimerWheel::Insert(uint32_t index)
+{
+   GL_TIMER_NODE_TYPE& node = m_Nodes[index];
+
+   // Already due: fire on the next tick processed.
+   uint64_t targetTick = std::max(node.expiryTick, m_CurrentTick + 1);
+   uint64_t delta = std::min(targetTick - m_CurrentTick, GLTWMaximumDeltaTicks);
+   targetTick = m_CurrentTick + delta;
+
+   uint32_t level = 0;
+   while (level + 1 < GLTWLevels &&
+         delta >= (static_cast<uint64_t>(1) << (GLTWSlotBits * (level + 1))))
+   {
+      level++;
+   }
+
+   uint32_t slot = static_cast<uint32_t>(targetTick >> (GLTWSlotBits * level)) & GLTWSlotMask;
+
+   node.level = static_cast<uint8_t>(level);
+   node.slot = static_cast<uint8_t>(slot);
+   node.prev = GLTWNoNode;
+   node.next = m_Slots[level][slot];
+   if (node.next != GLTWNoNode)
+   {
+      m_Nodes[node.next].prev = index;
+   }
+   m_Slots[level][slot] = index;
+   m_Occupied[level][slot / 64] |= (static_cast<uint64_t>(1) << (slot % 64));
+}
+
+/******************************************************************************/
+void GLTimerWheel::Unlink(uint32_t index)
+{
+   GL_TIMER_NODE_TYPE& node = m_Nodes[index];
+
+   if (node.prev != GLTWNoNode)
+   {
+      m_Nodes[node.prev].next = node.next;
+   }
+   else
+   {
+      m_Slots[node.level][node.slot] = node.next;
+      if (node.next == GLTWNoNode)
+      {
+         m_Occupied[node.level][node.slot / 64] &= ~(static_cast<uint64_t>(1) << (node.slot % 64));
+      }
+   }
+
+   if (node.next != GLTWNoNode)
+   {
+      m_Nodes[node.next].prev = node.prev;
+   }
+
+   node.next = GLTWNoNode;
+   node.prev = GLTWNoNode;
+}
+
+/******************************************************************************/
+void GLTimerWheel::Cascade(uint32_t level)
+{
+   uint32_t slot = static_cast<uint32_t>(m_CurrentTick >> (GLTWSlotBits * level)) & GLTWSlotMask;
+   uint32_t index = m_Slots[level][slot];
+
+   m_Slots[level][slot] = GLTWNoNode;
+   m_Occupied[level][slot / 64] &= ~(static_cast<uint64_t>(1) << (slot % 64));
+
+   while (index != GLTWNoNode)
+   {
+      uint32_t next = m_Nodes[index].next;
+      Insert(index);
+      index = next;
+   }
+}
+
+/******************************************************************************/
+GLTimerId GLTimerWheel::Schedule(
+      GLTimerWheelIntf& client,
+      uint64_t delayNs,
+      uint64_t periodNs,
+      uint64_t context)
+{
+   uint64_t nowNs = m_TimeHelper.GetTimeInNs();
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   if (m_FreeHead == GLTWNoNode)
+   {
+      return (GLTWInvalidTimerId);
+   }
+
+   uint32_t index = m_FreeHead;
+   GL_TIMER_NODE_TYPE& node = m_Nodes[index];
+   m_FreeHead = node.next;
+
+   // Rounded up to the next tick boundary so a timer never fires early.
+   uint64_t expiryNs = std::max(nowNs, m_StartNs) - m_StartNs + delayNs;
+   node.expiryTick = std::max((expiryNs + GLTWTickNs - 1) / GLTWTickNs, m_CurrentTick);
+   node.periodTicks = (periodNs == 0) ? 0 : std::max<uint64_t>((periodNs + GLTWTickNs - 1) / GLTWTickNs, 1);
+   node.context = context;
+   node.client = &client;
+   node.active = true;
+   m_ActiveTimers++;
+
+   Insert(index);
+
+   if (node.expiryTick < m_ArmedTick)
+   {
+      ArmTimerFd();
+   }
+
+   return (MakeTimerId(index, node.generation));
+}
+
+/******************************************************************************/
+bool GLTimerWheel::Cancel(GLTimerId timerId)
+{
+   uint32_t index = static_cast<uint32_t>(timerId);
+   uint32_t generation = static_cast<uint32_t>(timerId >> 32);
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   if (index >= GLTWMaximumTimers ||
+      !m_Nodes[index].active ||
+      m_Nodes[index].generation != generation)
+   {
+      return (false);
+   }
+
+   // The timerfd stays armed; an early wake up with nothing due is harmless.
+   Unlink(index);
+
+   GL_TIMER_NODE_TYPE& node = m_Nodes[index];
+   node.active = false;
+   node.generation = std::max<uint32_t>(node.generation + 1, 1);
+   node.next = m_FreeHead;
+   m_FreeHead = index;
+   m_ActiveTimers--;
+
+   return (true);
+}
+
+/******************************************************************************/
+uint32_t GLTimerWheel::Advance()
+{
+   std::lock_guard<std::mutex> advanceLock(m_AdvanceMutex);
+   uint64_t nowTick = NowTick();
+
+   m_ExpiredBatch.clear();
+
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      while (m_CurrentTick < nowTick)
+      {
+         if (m_ActiveTimers == 0)
+         {
+            m_CurrentTick = nowTick;
+            break;
+         }
+
+         m_CurrentTick++;
+
+         // Higher levels first, so their timers land in the slots below
+         // before those slots are visited.
+         for (uint32_t level = GLTWLevels - 1; level > 0; level--)
+         {
+            if ((m_CurrentTick & ((static_cast<uint64_t>(1) << (GLTWSlotBits * level)) - 1)) == 0)
+            {
+               Cascade(level);
+            }
+         }
+
+         uint32_t slot = static_cast<uint32_t>(m_CurrentTick) & GLTWSlotMask;
+         uint32_t index = m_Slots[0][slot];
+
+         m_Slots[0][slot] = GLTWNoNode;
+         m_Occupied[0][slot / 64] &= ~(static_cast<uint64_t>(1) << (slot % 64));
+
+         while (index != GLTWNoNode)
+         {
+            GL_TIMER_NODE_TYPE& node = m_Nodes[index];
+            uint32_t next = node.next;
+
+            if (node.expiryTick > m_CurrentTick)
+            {
+               // Parked at the clamp distance, not due yet.
+               Insert(index);
+            }
+            else
+            {
+               m_ExpiredBatch.push_back({node.client, MakeTimerId(index, node.generation), node.context});
+
+               if (node.periodTicks != 0)
+               {
+                  // Keeps the period's phase; a wheel that fell behind skips
+                  // the missed expiries rather than delivering a burst.
+                  node.expiryTick += node.periodTicks;
+                  if (node.expiryTick <= m_CurrentTick)
+                  {
+                     node.expiryTick = m_CurrentTick + node.periodTicks;
+                  }
+                  Insert(index);
+               }
+               else
+               {
+                  node.active = false;
+                  node.generation = std::max<uint32_t>(node.generation + 1, 1);
+                  node.next = m_FreeHead;
+                  m_FreeHead = index;
+                  m_ActiveTimers--;
+               }
+            }
+
+            index = next;
+         }
+      }
+
+      ArmTimerFd();
+   }
+
+   for (const GL_TIMER_EXPIRY_TYPE& expiry : m_ExpiredBatch)
+   {
+      expiry.client->EventTimerExpired(expiry.timerId, expiry.context);
+   }
+
+   return (static_cast<uint32_t>(m_ExpiredBatch.size()));
+}
+
+/******************************************************************************/
+uint64_t GLTimerWheel::NextWakeTick()
+{
+   // The nearest occupied slot on each level.  For level 0 that is the exact
+   // expiry; for the others it is when the slot cascades, after which the
+   // wheel is re-armed for the timers it moved down.
+   uint64_t wakeTick = GLTWNoTick;
+
+   for (uint32_t level = 0; level < GLTWLevels; level++)
+   {
+      uint32_t shift = GLTWSlotBits * level;
+      uint64_t position = m_CurrentTick >> shift;
+
+      for (uint32_t distance = 1; distance <= GLTWSlots; distance++)
+      {
+         uint32_t slot = static_cast<uint32_t>(position + distance) & GLTWSlotMask;
+
+         if ((m_Occupied[level][slot / 64] & (static_cast<uint64_t>(1) << (slot % 64))) != 0)
+         {
+            wakeTick = std::min(wakeTick, (position + distance) << shift);
+            break;
+         }
+      }
+   }
+
+   return (wakeTick);
+}
+
+/******************************************************************************/
+void GLTimerWheel::ArmTimerFd()
+{
+   // Called with m_Mutex held.  The timerfd is one shot, so it is still
+   // armed for m_ArmedTick until ProcessTimerFd() reads it.
+   uint64_t wakeTick = NextWakeTick();
+
+   if (wakeTick == m_ArmedTick)
+   {
+      return;
+   }
+
+   m_ArmedTick = wakeTick;
+
+   if (m_TimerFd < 0)
+   {
+      return;
+   }
+
+   struct itimerspec spec = {};
+
+   if (wakeTick != GLTWNoTick)
+   {
+      uint64_t wakeNs = m_StartNs + wakeTick * GLTWTickNs;
+      uint64_t nowNs = m_TimeHelper.GetTimeInNs();
+      // A zero it_value would disarm the timer.
+      uint64_t delayNs = (wakeNs > nowNs) ? wakeNs - nowNs : 1;
+
+      spec.it_value.tv_sec = static_cast<time_t>(delayNs / GLTimeHelper::m_theNanosecondsPerSecond);
+      spec.it_value.tv_nsec = static_cast<long>(delayNs % GLTimeHelper::m_theNanosecondsPerSecond);
+   }
+
+   timerfd_settime(m_TimerFd, 0, &spec, nullptr);
+}
+
+/******************************************************************************/
+int GLTimerWheel::TimerFd()
+{
+   return (m_TimerFd);
+}
+
+/******************************************************************************/
+uint32_t GLTimerWheel::ProcessTimerFd()
+{
+   uint64_t expirations;
+
+   // Non blocking; only clears the readable state.
+   while (read(m_TimerFd, &expirations, sizeof(expirations)) > 0)
+   {
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_ArmedTick = GLTWNoTick;
+   }
+
+   return (Advance());
+}
+
+/******************************************************************************/
+uint32_t GLTimerWheel::WaitAndAdvance(uint64_t maxWaitNs)
+{
+   if (m_TimerFd < 0)
+   {
+      usleep(static_cast<useconds_t>(std::min<uint64_t>(maxWaitNs / 1000, 1000000)));
+      return (Advance());
+   }
+
+   struct pollfd pfd = {m_TimerFd, POLLIN, 0};
+   int timeoutMs = static_cast<int>(std::min<uint64_t>(maxWaitNs / 1000000, INT32_MAX));
+
+   if (poll(&pfd, 1, timeoutMs) > 0)
+   {
+      return (ProcessTimerFd());
+   }
+
+   return (Advance());
+}
+
+/******************************************************************************/
+uint32_t GLTimerWheel::ActiveTimers()
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   return (m_ActiveTimers);
+}
+
+/******************************************************************************/
@@ -0,0 +1,154 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTimerWheel.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the hierarchical timer wheel.
+
+   Four levels of 256 slots cover 2^32 ticks of GLTWTickNs (about 49 days);
+   later timers are parked in the top level and cascaded again.  Timers are
+   taken from a fixed pool and linked into their slot by pool index, so
+   Schedule() and Cancel() are O(1) and never allocate.  A slot of a higher
+   level is cascaded into the lower levels when the wheel reaches it.
+
+   The wheel keeps a timerfd armed for the next slot that holds a timer.
+   It can be driven by polling TimerFd() next to a socket and calling
+   ProcessTimerFd(), or by calling WaitAndAdvance(), from exactly one thread:
+   the clients are called back on it.  The server drives it from the network
+   thread in every thread mode.  Expired timers are collected in one pass
+   under the lock and their clients are called back after it is released.
+*/
+/******************************************************************************/
+#ifndef gl_timer_wheel_h
+#define gl_timer_wheel_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "GLTimerWheelIntf.h"
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const uint64_t GLTWTickNs = 1000000;   // 1 ms
+const uint32_t GLTWLevels = 4;
+const uint32_t GLTWSlotBits = 8;
+const uint32_t GLTWSlots = 1 << GLTWSlotBits;
+const uint32_t GLTWMaximumTimers = 4096;
+
+}
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef struct gl_timer_node_struct
+{
+   uint64_t expiryTick;
+   uint64_t periodTicks;   // 0 for a one shot timer
+   uint64_t context;
+   GLTimerWheelIntf* client;
+   uint32_t next;
+   uint32_t prev;
+   uint32_t generation;
+   uint8_t level;
+   uint8_t slot;
+   bool active;
+} GL_TIMER_NODE_TYPE;
+
+typedef struct gl_timer_expiry_struct
+{
+   GLTimerWheelIntf* client;
+   GLTimerId timerId;
+   uint64_t context;
+} GL_TIMER_EXPIRY_TYPE;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class GLTimeHelper;
+
+class GLTimerWheel
+{
+   public:
+      GLTimerWheel(GLTimeHelper& timeHelper);
+      ~GLTimerWheel();
+
+      // Returns GLTWInvalidTimerId when the pool is exhausted.  A timer
+      // never fires early; it fires on the first tick at or after delayNs.
+      GLTimerId Schedule(
+            GLTimerWheelIntf& client,
+            uint64_t delayNs,
+            uint64_t periodNs = 0,
+            uint64_t context = 0);
+
+      // A timer cancelled from another thread while its expiry batch is
+      // being delivered may still be delivered once.
+      bool Cancel(GLTimerId timerId);
+
+      // Processes every tick up to now and delivers the expired timers.
+      // Must not be called from an expiry callback.  Returns the number of
+      // timers delivered.
+      uint32_t Advance();
+
+      // Drivers: poll TimerFd() for POLLIN and call ProcessTimerFd(), or
+      // block in WaitAndAdvance() for at most maxWaitNs.
+      int TimerFd();
+      uint32_t ProcessTimerFd();
+      uint32_t WaitAndAdvance(uint64_t maxWaitNs);
+
+      uint32_t ActiveTimers();
+
+   private:
+      uint64_t NowTick();
+      void Insert(uint32_t index);
+      void Unlink(uint32_t index);
+      void Cascade(uint32_t level);
+      uint64_t NextWakeTick();
+      void ArmTimerFd();
+      static GLTimerId MakeTimerId(uint32_t index, uint32_t generation);
+
+      GLTimeHelper& m_TimeHelper;
+      std::vector<GL_TIMER_NODE_TYPE> m_Nodes;
+      std::array<std::array<uint32_t, GLTWSlots>, GLTWLevels> m_Slots;
+      std::array<std::array<uint64_t, GLTWSlots / 64>, GLTWLevels> m_Occupied;
+      std::vector<GL_TIMER_EXPIRY_TYPE> m_ExpiredBatch;
+      uint32_t m_FreeHead;
+      uint32_t m_ActiveTimers;
+      uint64_t m_StartNs;
+      uint64_t m_CurrentTick;
+      uint64_t m_ArmedTick;
+      int m_TimerFd;
+      std::mutex m_Mutex;
+      std::mutex m_AdvanceMutex;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_timer_wheel_h */
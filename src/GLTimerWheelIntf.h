@@ -0,0 +1,59 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTimerWheelIntf.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the interface definition for the timer wheel clients
+   of the application.
+*/
+/******************************************************************************/
+#ifndef gl_timer_wheel_intf_h
+#define gl_timer_wheel_intf_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <cstdint>
+
+/******************************************************************************/
+/*                              T Y P E D E F S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+using GLTimerId = uint64_t;
+
+const GLTimerId GLTWInvalidTimerId = 0;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+class GLTimerWheelIntf
+{
+   // Methods required to receive expiries from the GLTimerWheel.
+
+   public:
+      // Called on the thread driving the wheel, never with the wheel locked,
+      // so the client may schedule or cancel timers from here.
+      virtual void EventTimerExpired(GLTimerId timerId, uint64_t context) = 0;
+
+      virtual ~GLTimerWheelIntf() {};
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_timer_wheel_intf_h */
@@ -0,0 +1,283 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTscClock.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the invariant TSC clock.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define GL_TSC_SUPPORTED 1
+#endif
+
+#include "GLTscClock.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint32_t GLTSCpuidAdvancedPowerManagement = 0x80000007;
+static const uint32_t GLTSCpuidInvariantTscBit = (1 << 8);
+static const uint32_t GLTSPairSamples = 5;
+static const uint64_t GLTSNanosecondsPerSecond = 1000000000;
+
+/******************************************************************************/
+/*       G L O B A L  V A R S                                                 */
+/******************************************************************************/
+// Keeps every thread's timestamps monotonic across a re-anchor done by
+// another thread in the middle of a read.
+static thread_local uint64_t m_theLastTimeNs = 0;
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLTscClock* GLTscClock::Instance()
+{
+   // Lives for the life of the process, like the TSC it reads.
+   static GLTscClock* theClock = InvariantTscAvailable() ? new GLTscClock() : nullptr;
+
+   return theClock;
+}
+
+/******************************************************************************/
+bool GLTscClock::InvariantTscAvailable()
+{
+   bool available = false;
+
+#ifdef GL_TSC_SUPPORTED
+   uint32_t eax, ebx, ecx, edx;
+
+   if (__get_cpuid(GLTSCpuidAdvancedPowerManagement, &eax, &ebx, &ecx, &edx))
+   {
+      available = ((edx & GLTSCpuidInvariantTscBit) != 0);
+   }
+#endif
+
+   return (available);
+}
+
+/******************************************************************************/
+GLTscClock::GLTscClock()
+   :
+   m_AnchorSequence(0),
+   m_AnchorTsc(0),
+   m_AnchorNs(0),
+   m_Multiplier(0),
+   m_AnchorRate(0),
+   m_ReanchorTicks(0),
+   m_Reanchoring(false),
+   m_RateMultiplier(0),
+   m_ReferenceTsc(0),
+   m_ReferenceNs(0)
+{
+   Calibrate();
+}
+
+/******************************************************************************/
+GLTscClock::~GLTscClock()
+{
+}
+
+/******************************************************************************/
+uint64_t GLTscClock::ReadTsc()
+{
+#ifdef GL_TSC_SUPPORTED
+   return __rdtsc();
+#else
+   return 0;
+#endif
+}
+
+/******************************************************************************/
+uint64_t GLTscClock::ReadMonotonicNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_MONOTONIC, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * GLTSNanosecondsPerSecond +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
+/******************************************************************************/
+void GLTscClock::ReadPair(uint64_t& tsc, uint64_t& monotonicNs)
+{
+   // The narrowest TSC bracket around clock_gettime() gives the best pair.
+   uint64_t bestBracket = UINT64_MAX;
+
+   for (uint32_t sample = 0; sample < GLTSPairSamples; sample++)
+   {
+      uint64_t before = ReadTsc();
+      uint64_t nowNs = ReadMonotonicNs();
+      uint64_t after = ReadTsc();
+
+      if (after - before < bestBracket)
+      {
+         bestBracket = after - before;
+         tsc = before + (after - before) / 2;
+         monotonicNs = nowNs;
+      }
+   }
+}
+
+/******************************************************************************/
+uint64_t GLTscClock::ScaleTicks(uint64_t ticks, uint64_t multiplier)
+{
+   return static_cast<uint64_t>(
+         (static_cast<unsigned __int128>(ticks) * multiplier) >> GLTSScaleShift);
+}
+
+/******************************************************************************/
+uint64_t GLTscClock::AnchorTimeNs(
+      uint64_t anchorNs,
+      uint64_t ticks,
+      uint64_t multiplier,
+      uint64_t rate)
+{
+   // The slew only applies to the interval it was computed for, so a clock
+   // nobody read for an hour does not carry it any further.
+   uint64_t slewTicks = std::min(ticks, m_ReanchorTicks.load(std::memory_order_relaxed));
+
+   return anchorNs + ScaleTicks(slewTicks, multiplier) + ScaleTicks(ticks - slewTicks, rate);
+}
+
+/******************************************************************************/
+void GLTscClock::Calibrate()
+{
+   uint64_t startTsc, startNs, endTsc, endNs;
+
+   ReadPair(startTsc, startNs);
+   while (ReadMonotonicNs() - startNs < GLTSCalibrationIntervalNs)
+   {
+   }
+   ReadPair(endTsc, endNs);
+
+   m_ReferenceTsc = startTsc;
+   m_ReferenceNs = startNs;
+   m_RateMultiplier = static_cast<uint64_t>(
+         (static_cast<unsigned __int128>(endNs - startNs) << GLTSScaleShift) /
+         std::max<uint64_t>(endTsc - startTsc, 1));
+
+   m_AnchorTsc.store(endTsc);
+   m_AnchorNs.store(endNs);
+   m_Multiplier.store(m_RateMultiplier);
+   m_AnchorRate.store(m_RateMultiplier);
+   m_ReanchorTicks.store(static_cast<uint64_t>(
+         (static_cast<unsigned __int128>(GLTSReanchorIntervalNs) << GLTSScaleShift) /
+         m_RateMultiplier));
+}
+
+/******************************************************************************/
+void GLTscClock::Reanchor()
+{
+   // Only one thread at a time gets here, see GetTimeInNs().
+   uint64_t nowTsc, nowNs;
+   ReadPair(nowTsc, nowNs);
+
+   uint64_t anchorTsc = m_AnchorTsc.load(std::memory_order_relaxed);
+   uint64_t estimateNs = AnchorTimeNs(
+         m_AnchorNs.load(std::memory_order_relaxed),
+         (nowTsc > anchorTsc) ? nowTsc - anchorTsc : 0,
+         m_Multiplier.load(std::memory_order_relaxed),
+         m_AnchorRate.load(std::memory_order_relaxed));
+
+   // The rate measured since calibration keeps getting more precise.
+   if (nowTsc > m_ReferenceTsc && nowNs > m_ReferenceNs)
+   {
+      m_RateMultiplier = static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(nowNs - m_ReferenceNs) << GLTSScaleShift) /
+            (nowTsc - m_ReferenceTsc));
+   }
+
+   int64_t errorNs = static_cast<int64_t>(nowNs - estimateNs);
+   int64_t maximumSlewNs = static_cast<int64_t>(
+         GLTSReanchorIntervalNs * GLTSMaximumSlewPpm / 1000000);
+
+   if (errorNs > maximumSlewNs)
+   {
+      // Far behind CLOCK_MONOTONIC; stepping forward is allowed.
+      estimateNs = nowNs;
+      errorNs = 0;
+   }
+   errorNs = std::max(errorNs, -maximumSlewNs);
+
+   uint64_t newMultiplier = static_cast<uint64_t>(
+         static_cast<__int128>(m_RateMultiplier) *
+         (static_cast<int64_t>(GLTSReanchorIntervalNs) + errorNs) /
+         static_cast<int64_t>(GLTSReanchorIntervalNs));
+
+   m_AnchorSequence.fetch_add(1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+   m_AnchorTsc.store(nowTsc, std::memory_order_relaxed);
+   m_AnchorNs.store(estimateNs, std::memory_order_relaxed);
+   m_Multiplier.store(newMultiplier, std::memory_order_relaxed);
+   m_AnchorRate.store(m_RateMultiplier, std::memory_order_relaxed);
+   m_AnchorSequence.fetch_add(1, std::memory_order_release);
+}
+
+/******************************************************************************/
+uint64_t GLTscClock::GetTimeInNs()
+{
+   uint64_t timeNs;
+
+   while (true)
+   {
+      uint32_t sequence = m_AnchorSequence.load(std::memory_order_acquire);
+      uint64_t anchorTsc = m_AnchorTsc.load(std::memory_order_relaxed);
+      uint64_t anchorNs = m_AnchorNs.load(std::memory_order_relaxed);
+      uint64_t multiplier = m_Multiplier.load(std::memory_order_relaxed);
+      uint64_t rate = m_AnchorRate.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      if ((sequence & 1) != 0 ||
+         sequence != m_AnchorSequence.load(std::memory_order_relaxed))
+      {
+         continue;
+      }
+
+      uint64_t tsc = ReadTsc();
+      uint64_t ticks = (tsc > anchorTsc) ? tsc - anchorTsc : 0;
+
+      if (ticks > m_ReanchorTicks.load(std::memory_order_relaxed) &&
+         !m_Reanchoring.exchange(true, std::memory_order_acquire))
+      {
+         Reanchor();
+         m_Reanchoring.store(false, std::memory_order_release);
+         continue;
+      }
+
+      timeNs = AnchorTimeNs(anchorNs, ticks, multiplier, rate);
+      break;
+   }
+
+   timeNs = std::max(timeNs, m_theLastTimeNs);
+   m_theLastTimeNs = timeNs;
+
+   return timeNs;
+}
+
+/******************************************************************************/
+uint64_t GLTscClock::TicksPerSecond()
+{
+   return static_cast<uint64_t>(
+         (static_cast<unsigned __int128>(GLTSNanosecondsPerSecond) << GLTSScaleShift) /
+         std::max<uint64_t>(m_AnchorRate.load(std::memory_order_relaxed), 1));
+}
+
+/******************************************************************************/
@@ -0,0 +1,105 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLTscClock.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the invariant TSC clock.  The time
+   stamp counter is read with a single instruction and scaled to nanoseconds
+   on the CLOCK_MONOTONIC timeline.
+
+   The clock is calibrated once per process and then re-anchored against
+   CLOCK_MONOTONIC by whichever caller first notices that the anchor is
+   older than GLTSReanchorIntervalNs.  A re-anchor never moves time back:
+   the new anchor starts where the old one is at that instant and any error
+   against CLOCK_MONOTONIC is slewed out over the next interval, bounded by
+   GLTSMaximumSlewPpm.  Readers pick up the anchor through a sequence lock
+   and take no lock themselves.
+*/
+/******************************************************************************/
+#ifndef gl_tsc_clock_h
+#define gl_tsc_clock_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <atomic>
+#include <cstdint>
+
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const uint64_t GLTSCalibrationIntervalNs = 10000000;   // 10 ms
+const uint64_t GLTSReanchorIntervalNs = 1000000000;    // 1 s
+const uint64_t GLTSMaximumSlewPpm = 500;
+const uint32_t GLTSScaleShift = 32;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class GLTscClock
+{
+   public:
+      // Calibrated on first use.  Returns nullptr when the processor has no
+      // invariant TSC, the caller then has to use CLOCK_MONOTONIC.
+      static GLTscClock* Instance();
+      static bool InvariantTscAvailable();
+
+      uint64_t GetTimeInNs();
+      uint64_t TicksPerSecond();
+
+   private:
+      GLTscClock();
+      ~GLTscClock();
+
+      static uint64_t ReadTsc();
+      static uint64_t ReadMonotonicNs();
+      static void ReadPair(uint64_t& tsc, uint64_t& monotonicNs);
+
+      void Calibrate();
+      void Reanchor();
+      uint64_t ScaleTicks(uint64_t ticks, uint64_t multiplier);
+      uint64_t AnchorTimeNs(
+            uint64_t anchorNs,
+            uint64_t ticks,
+            uint64_t multiplier,
+            uint64_t rate);
+
+      // Written only by the thread holding m_Reanchoring, published under
+      // m_AnchorSequence (odd while an update is in progress).
+      std::atomic<uint32_t> m_AnchorSequence;
+      std::atomic<uint64_t> m_AnchorTsc;
+      std::atomic<uint64_t> m_AnchorNs;
+      std::atomic<uint64_t> m_Multiplier;
+      std::atomic<uint64_t> m_AnchorRate;
+      std::atomic<uint64_t> m_ReanchorTicks;
+      std::atomic<bool> m_Reanchoring;
+
+      // Long term rate, not skewed by the slew applied to m_Multiplier.
+      uint64_t m_RateMultiplier;
+      uint64_t m_ReferenceTsc;
+      uint64_t m_ReferenceNs;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_tsc_clock_h */
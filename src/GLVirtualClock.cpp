@@ -0,0 +1,60 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLVirtualClock.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the virtual clock.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include "GLVirtualClock.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+GLVirtualClock::GLVirtualClock(uint64_t startNs)
+   :
+   m_TimeNs(startNs)
+{
+}
+
+/******************************************************************************/
+GLVirtualClock::~GLVirtualClock()
+{
+}
+
+/******************************************************************************/
+uint64_t GLVirtualClock::GetTimeInNs()
+{
+   return m_TimeNs.load(std::memory_order_acquire);
+}
+
+/******************************************************************************/
+void GLVirtualClock::SetTimeInNs(uint64_t timeNs)
+{
+   uint64_t currentNs = m_TimeNs.load(std::memory_order_relaxed);
+
+   while (timeNs > currentNs &&
+         !m_TimeNs.compare_exchange_weak(currentNs, timeNs, std::memory_order_release))
+   {
+   }
+}
+
+/******************************************************************************/
+void GLVirtualClock::AdvanceNs(uint64_t deltaNs)
+{
+   m_TimeNs.fetch_add(deltaNs, std::memory_order_release);
+}
+
+/******************************************************************************/
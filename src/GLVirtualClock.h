@@ -0,0 +1,57 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLVirtualClock.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the virtual clock.  It only moves
+   when its owner moves it, so a GLTimeHelper built on it makes every log
+   timestamp and timer expiry of a simulated run reproducible.
+*/
+/******************************************************************************/
+#ifndef gl_virtual_clock_h
+#define gl_virtual_clock_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <atomic>
+#include <cstdint>
+
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class GLVirtualClock
+{
+   public:
+      GLVirtualClock(uint64_t startNs = 0);
+      ~GLVirtualClock();
+
+      uint64_t GetTimeInNs();
+
+      // Time never moves back: an earlier time than the current one is
+      // ignored.
+      void SetTimeInNs(uint64_t timeNs);
+      void AdvanceNs(uint64_t deltaNs);
+
+   private:
+      std::atomic<uint64_t> m_TimeNs;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* gl_virtual_clock_h */
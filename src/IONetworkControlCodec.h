@@ -0,0 +1,507 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkControlCodec.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the compile time codec for the control message data
+   blocks.  A payload is a plain struct; its schema is a specialization of
+   IONWSchema giving the message id, the data block size and the fields as
+   (member, offset) pairs:
+
+      template <> struct IONWSchema<IONW_XXX_TYPE>
+      {
+         static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_XXX;
+         static constexpr uint16_t dataBytes = 14;
+         using Fields = IONWFields<
+            IONWField<&IONW_XXX_TYPE::time, 0>,
+            IONWField<&IONW_XXX_TYPE::flags, 8>>;
+      };
+
+   The field types give the wire sizes, every field is big endian, and the
+   layout is checked when the schema is used: a field past the data block,
+   two fields sharing a byte or a message longer than
+   m_theIoNwControlMessageMaximumLengthBytes does not compile.  Encoding
+   and decoding unroll to one store or load per field.
+
+   dataBytes is the fixed part of the data block.  A message with a
+   variable tail, text or a segment of a longer response, is encoded with
+   IONWEncodeWithTail().
+
+   Format version 2 replaces the 18 byte header with a compact 8 byte one:
+
+      0  magic 0x55        4  data bytes (16 bit)
+      1  version 2         6  sequence number
+      2  message id
+
+   UDP already frames the message, so the sync pattern buys nothing.  The
+   second byte tells the formats apart, 0xAA in version 1 and the version
+   in version 2.  A client asks for compact responses by sending compact
+   requests, or by sending version 1 requests with dataFormatVersion 2; an
+   older server ignores that byte and keeps answering in version 1.
+*/
+/******************************************************************************/
+#ifndef io_network_control_codec_h
+#define io_network_control_codec_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "IONetworkControlMessage.h"
+#include "IONetworkControlMessages.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+// Header layout behind the sync pattern.
+const uint16_t IONWHeaderMsgIdIndex = m_theSyncPatternSizeBytes;
+const uint16_t IONWHeaderDataBytesIndex = IONWHeaderMsgIdIndex + 2;
+const uint16_t IONWHeaderVersionIndex = IONWHeaderDataBytesIndex + 1;
+const uint16_t IONWHeaderSecurityIndex = IONWHeaderVersionIndex + 1;
+const uint16_t IONWHeaderReservedIndex = IONWHeaderSecurityIndex + 2;
+const uint16_t IONWHeaderVerificationIndex = IONWHeaderReservedIndex + 2;
+const uint8_t IONWMessageFormatVersion = 1;
+
+// The compact header of format version 2, see the file notes.
+const uint8_t IONWCompactMagic = 0x55;
+const uint8_t IONWCompactFormatVersion = 2;
+const uint16_t IONWCompactVersionIndex = 1;
+const uint16_t IONWCompactMsgIdIndex = 2;
+const uint16_t IONWCompactDataBytesIndex = 4;
+const uint16_t IONWCompactSequenceIndex = 6;
+const uint16_t IONWCompactHeaderSizeBytes = 8;
+
+/******************************************************************************/
+/*                    W I R E  R E P R E S E N T A T I O N                    */
+/******************************************************************************/
+// Integers and enums are big endian; byte arrays are copied as they are.
+template <typename T, typename Enable = void>
+struct IONWWire
+{
+   static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+         "IONWWire: unsupported field type");
+};
+
+template <typename T>
+struct IONWWire<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+   static constexpr uint16_t size = sizeof(T);
+
+   static constexpr void Put(uint8_t* data, T value)
+   {
+      using U = typename std::make_unsigned<T>::type;
+      U bits = static_cast<U>(value);
+
+      for (uint16_t index = size; index > 0; index--)
+      {
+         data[index - 1] = static_cast<uint8_t>(bits);
+         bits = static_cast<U>(bits >> 8);
+      }
+   }
+
+   static constexpr T Get(const uint8_t* data)
+   {
+      using U = typename std::make_unsigned<T>::type;
+      U bits = 0;
+
+      for (uint16_t index = 0; index < size; index++)
+      {
+         bits = static_cast<U>((bits << 8) | data[index]);
+      }
+
+      return static_cast<T>(bits);
+   }
+};
+
+template <typename T>
+struct IONWWire<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+   using Underlying = typename std::underlying_type<T>::type;
+   static constexpr uint16_t size = sizeof(Underlying);
+
+   static constexpr void Put(uint8_t* data, T value)
+   {
+      IONWWire<Underlying>::Put(data, static_cast<Underlying>(value));
+   }
+
+   static constexpr T Get(const uint8_t* data)
+   {
+      return static_cast<T>(IONWWire<Underlying>::Get(data));
+   }
+};
+
+template <std::size_t N>
+struct IONWWire<std::array<uint8_t, N>, void>
+{
+   static constexpr uint16_t size = N;
+
+   static constexpr void Put(uint8_t* data, const std::array<uint8_t, N>& value)
+   {
+      for (std::size_t index = 0; index < N; index++)
+      {
+         data[index] = value[index];
+      }
+   }
+
+   static constexpr std::array<uint8_t, N> Get(const uint8_t* data)
+   {
+      std::array<uint8_t, N> value = {};
+
+      for (std::size_t index = 0; index < N; index++)
+      {
+         value[index] = data[index];
+      }
+
+      return value;
+   }
+};
+
+/******************************************************************************/
+/*                             S C H E M A                                    */
+/******************************************************************************/
+template <typename M>
+struct IONWMemberTraits;
+
+template <typename C, typename T>
+struct IONWMemberTraits<T C::*>
+{
+   using PayloadType = C;
+   using FieldType = T;
+};
+
+// One field of a data block: the payload member and its byte offset.
+template <auto Member, uint16_t Offset>
+struct IONWField
+{
+   using FieldType = typename IONWMemberTraits<decltype(Member)>::FieldType;
+
+   static constexpr auto member = Member;
+   static constexpr uint16_t offset = Offset;
+   static constexpr uint16_t size = IONWWire<FieldType>::size;
+
+   template <typename Payload>
+   static constexpr void Encode(const Payload& payload, uint8_t* data)
+   {
+      IONWWire<FieldType>::Put(data + Offset, payload.*Member);
+   }
+
+   template <typename Payload>
+   static constexpr void Decode(const uint8_t* data, Payload& payload)
+   {
+      payload.*Member = IONWWire<FieldType>::Get(data + Offset);
+   }
+};
+
+template <auto First, auto Second>
+constexpr bool IONWSameMember()
+{
+   if constexpr (std::is_same_v<decltype(First), decltype(Second)>)
+   {
+      return First == Second;
+   }
+   else
+   {
+      return false;
+   }
+}
+
+template <typename... Field>
+struct IONWFields
+{
+   // One past the last byte any field uses.
+   static constexpr uint16_t End()
+   {
+      uint16_t end = 0;
+      const uint16_t ends[] = {0, (Field::offset + Field::size)...};
+
+      for (uint16_t value : ends)
+      {
+         end = (value > end) ? value : end;
+      }
+
+      return end;
+   }
+
+   static constexpr bool Disjoint()
+   {
+      const uint16_t offsets[] = {0, Field::offset...};
+      const uint16_t sizes[] = {0, Field::size...};
+      const std::size_t count = sizeof...(Field) + 1;
+
+      for (std::size_t first = 1; first < count; first++)
+      {
+         for (std::size_t second = first + 1; second < count; second++)
+         {
+            if (offsets[first] < offsets[second] + sizes[second] &&
+               offsets[second] < offsets[first] + sizes[first])
+            {
+               return false;
+            }
+         }
+      }
+
+      return true;
+   }
+
+   // Byte offset of the field for Member; End() when no field has it.
+   template <auto Member>
+   static constexpr uint16_t OffsetOf()
+   {
+      const bool matches[] = {false, IONWSameMember<Field::member, Member>()...};
+      const uint16_t offsets[] = {0, Field::offset...};
+
+      for (std::size_t index = 1; index < sizeof...(Field) + 1; index++)
+      {
+         if (matches[index])
+         {
+            return offsets[index];
+         }
+      }
+
+      return End();
+   }
+
+   template <typename Payload>
+   static constexpr void Encode(
+         [[maybe_unused]] const Payload& payload,
+         [[maybe_unused]] uint8_t* data)
+   {
+      // Both unused for a payload without fields.
+      (Field::Encode(payload, data), ...);
+   }
+
+   template <typename Payload>
+   static constexpr void Decode(
+         [[maybe_unused]] const uint8_t* data,
+         [[maybe_unused]] Payload& payload)
+   {
+      (Field::Decode(data, payload), ...);
+   }
+};
+
+// Specialized once per payload struct, see the file notes.
+template <typename Payload>
+struct IONWSchema;
+
+template <typename Payload>
+struct IONWCheckedSchema : IONWSchema<Payload>
+{
+   using Schema = IONWSchema<Payload>;
+
+   static_assert(Schema::Fields::End() <= Schema::dataBytes,
+         "IONWSchema: a field ends past the data block");
+   static_assert(Schema::Fields::Disjoint(),
+         "IONWSchema: two fields overlap");
+   static_assert(m_theIoNwControlMessageHeaderSizeBytes + Schema::dataBytes <=
+         m_theIoNwControlMessageMaximumLengthBytes,
+         "IONWSchema: message longer than the maximum message length");
+
+   static constexpr uint16_t messageBytes =
+         m_theIoNwControlMessageHeaderSizeBytes + Schema::dataBytes;
+};
+
+// The complete message, header and data block, for a payload.
+template <typename Payload>
+using IONWWireMessage = std::array<uint8_t, IONWCheckedSchema<Payload>::messageBytes>;
+
+/******************************************************************************/
+/*                       E N C O D E  /  D E C O D E                          */
+/******************************************************************************/
+// Writes the header and clears the data block; for a message id only known
+// at run time, otherwise IONWEncode() does it.
+constexpr void IONWEncodeHeader(uint16_t msgId, uint16_t dataBytes, uint8_t* message)
+{
+   IONWWire<uint64_t>::Put(message, m_theIoNetworkControlMsgHeaderSyncPattern);
+   IONWWire<uint16_t>::Put(message + IONWHeaderMsgIdIndex, msgId);
+   message[IONWHeaderDataBytesIndex] = static_cast<uint8_t>(
+         (dataBytes < m_theIoNwControlMessageExtendedDataBytes) ?
+         dataBytes : m_theIoNwControlMessageExtendedDataBytes);
+   message[IONWHeaderVersionIndex] = IONWMessageFormatVersion;
+   IONWWire<uint16_t>::Put(message + IONWHeaderSecurityIndex, 0);
+   IONWWire<uint16_t>::Put(message + IONWHeaderReservedIndex, 0);
+   IONWWire<uint16_t>::Put(message + IONWHeaderVerificationIndex, 0);
+
+   uint8_t* data = message + m_theIoNwControlMessageHeaderSizeBytes;
+   for (uint16_t index = 0; index < dataBytes; index++)
+   {
+      data[index] = 0;
+   }
+}
+
+// The compact header of format version 2; clears the data block.
+constexpr void IONWEncodeCompactHeader(
+      uint16_t msgId,
+      uint16_t dataBytes,
+      uint16_t sequence,
+      uint8_t* message)
+{
+   message[0] = IONWCompactMagic;
+   message[IONWCompactVersionIndex] = IONWCompactFormatVersion;
+   IONWWire<uint16_t>::Put(message + IONWCompactMsgIdIndex, msgId);
+   IONWWire<uint16_t>::Put(message + IONWCompactDataBytesIndex, dataBytes);
+   IONWWire<uint16_t>::Put(message + IONWCompactSequenceIndex, sequence);
+
+   uint8_t* data = message + IONWCompactHeaderSizeBytes;
+   for (uint16_t index = 0; index < dataBytes; index++)
+   {
+      data[index] = 0;
+   }
+}
+
+// True when message starts with the compact header.
+constexpr bool IONWCompactMessage(const uint8_t* message, int32_t len)
+{
+   return (len >= IONWCompactHeaderSizeBytes &&
+      message[0] == IONWCompactMagic &&
+      message[IONWCompactVersionIndex] == IONWCompactFormatVersion);
+}
+
+template <typename Payload>
+constexpr void IONWEncodeInto(const Payload& payload, uint8_t* message)
+{
+   using Schema = IONWCheckedSchema<Payload>;
+
+   IONWEncodeHeader(static_cast<uint16_t>(Schema::msgId), Schema::dataBytes, message);
+   Schema::Fields::Encode(payload, message + m_theIoNwControlMessageHeaderSizeBytes);
+}
+
+template <typename Payload>
+constexpr IONWWireMessage<Payload> IONWEncode(const Payload& payload)
+{
+   IONWWireMessage<Payload> message = {};
+
+   IONWEncodeInto(payload, message.data());
+
+   return message;
+}
+
+template <typename Payload>
+constexpr std::array<uint8_t, IONWCompactHeaderSizeBytes + IONWCheckedSchema<Payload>::dataBytes>
+IONWEncodeCompact(const Payload& payload, uint16_t sequence)
+{
+   using Schema = IONWCheckedSchema<Payload>;
+   std::array<uint8_t, IONWCompactHeaderSizeBytes + Schema::dataBytes> message = {};
+
+   IONWEncodeCompactHeader(static_cast<uint16_t>(Schema::msgId), Schema::dataBytes, sequence, message.data());
+   Schema::Fields::Encode(payload, message.data() + IONWCompactHeaderSizeBytes);
+
+   return message;
+}
+
+// Rewrites a version 1 message of len bytes with the compact header into
+// compact, which has room for len bytes.  Returns the compact length.
+inline uint16_t IONWCompactFromVersion1(
+      const uint8_t* message,
+      uint16_t len,
+      uint16_t sequence,
+      uint8_t* compact)
+{
+   uint16_t dataBytes = len - m_theIoNwControlMessageHeaderSizeBytes;
+
+   compact[0] = IONWCompactMagic;
+   compact[IONWCompactVersionIndex] = IONWCompactFormatVersion;
+   compact[IONWCompactMsgIdIndex] = message[IONWHeaderMsgIdIndex];
+   compact[IONWCompactMsgIdIndex + 1] = message[IONWHeaderMsgIdIndex + 1];
+   IONWWire<uint16_t>::Put(compact + IONWCompactDataBytesIndex, dataBytes);
+   IONWWire<uint16_t>::Put(compact + IONWCompactSequenceIndex, sequence);
+
+   for (uint16_t index = 0; index < dataBytes; index++)
+   {
+      compact[IONWCompactHeaderSizeBytes + index] = message[m_theIoNwControlMessageHeaderSizeBytes + index];
+   }
+
+   return (IONWCompactHeaderSizeBytes + dataBytes);
+}
+
+// Encodes the payload followed by tailBytes of tail into message, which has
+// room for m_theIoNwControlMessageMaximumLengthBytes.  Returns the message
+// length, 0 if the tail does not fit.
+template <typename Payload>
+uint16_t IONWEncodeWithTail(
+      const Payload& payload,
+      const uint8_t* tail,
+      uint16_t tailBytes,
+      uint8_t* message)
+{
+   using Schema = IONWCheckedSchema<Payload>;
+
+   if (tailBytes > m_theIoNwControlMessageMaximumDataBytes - Schema::dataBytes)
+   {
+      return 0;
+   }
+
+   uint16_t dataBytes = Schema::dataBytes + tailBytes;
+   IONWEncodeHeader(static_cast<uint16_t>(Schema::msgId), dataBytes, message);
+
+   uint8_t* data = message + m_theIoNwControlMessageHeaderSizeBytes;
+   Schema::Fields::Encode(payload, data);
+   for (uint16_t index = 0; index < tailBytes; index++)
+   {
+      data[Schema::dataBytes + index] = tail[index];
+   }
+
+   return (m_theIoNwControlMessageHeaderSizeBytes + dataBytes);
+}
+
+// Decodes a data block of dataBytes bytes; false if it is too short for the
+// schema.
+template <typename Payload>
+constexpr bool IONWDecode(const uint8_t* data, uint16_t dataBytes, Payload& payload)
+{
+   using Schema = IONWCheckedSchema<Payload>;
+
+   if (dataBytes < Schema::Fields::End())
+   {
+      return (false);
+   }
+
+   Schema::Fields::Decode(data, payload);
+
+   return (true);
+}
+
+// Decodes the data block of a received message.
+template <typename Payload>
+bool IONWDecode(IONetworkControlMessage& message, Payload& payload)
+{
+   return (IONWDecode(message.MessageData(), message.DataBytes(), payload));
+}
+
+// Decodes a whole received message in either format; false unless it is
+// long enough and carries the schema's message id.
+template <typename Payload>
+constexpr bool IONWDecodeMessage(const uint8_t* message, int32_t len, Payload& payload)
+{
+   using Schema = IONWCheckedSchema<Payload>;
+   bool compact = IONWCompactMessage(message, len);
+   uint16_t headerBytes = compact ? IONWCompactHeaderSizeBytes : m_theIoNwControlMessageHeaderSizeBytes;
+   uint16_t msgIdIndex = compact ? IONWCompactMsgIdIndex : IONWHeaderMsgIdIndex;
+
+   if (len < static_cast<int32_t>(headerBytes + Schema::dataBytes) ||
+      IONWWire<uint16_t>::Get(message + msgIdIndex) != static_cast<uint16_t>(Schema::msgId))
+   {
+      return (false);
+   }
+
+   return (IONWDecode(message + headerBytes, Schema::dataBytes, payload));
+}
+
+}
+
+/******************************************************************************/
+
+#endif /* io_network_control_codec_h */
@@ -18,14 +18,20 @@
 /******************************************************************************/
 /*       I N C L U D E S                                                      */
 /******************************************************************************/
+#include <algorithm>
 #include <iostream>
+#include <poll.h>
 
 #include "GLResourceMain.h"
 #include "IONetworkUdpHelper.h"
 #include "IONetworkControlMessage.h"
 #include "IONetworkControlMessages.h"
+#include "IONetworkControlPayloads.h"
 #include "GLEventLog.h"
 #include "GLErrorLog.h"
+#include "GLTimeHelper.h"
+#include "GLTimerWheel.h"
+#include "IONetworkFlightRecorder.h"
 #include "PRProtocolDomainManager.h"
 #include "IONetworkControlInterfaceManager.h"
 
@@ -38,24 +44,34 @@ using namespace MDN;
 /******************************************************************************/
 /*                        C O N S T A N T S                                   */
 /******************************************************************************/
-const uint16_t theIoNetworkControlInterfacePort = 49153;
 
 /******************************************************************************/
 /*                     I M P L E M E N T A T I O N                            */
 /******************************************************************************/
-IONetworkControlInterfaceManager::IONetworkControlInterfaceManager(GLResourceMain& resource)
+IONetworkControlInterfaceManager::IONetworkControlInterfaceManager(
+   GLResourceMain& resource,
+   IONetworkTransportPtr transport)
    :
    m_DomainId(GLCF_IO_NETWORK_DOMAIN_ID),
    m_ModuleId(GLCF_GL_IO_NETWORK_CONTROL_INTERFACE_MANAGER_ID),
    m_State(IONCIM_STATE_INACTIVE),
    m_ResourceMain(resource),
    m_ReceiveActive(false),
-   m_UdpHelperPtr(std::make_unique<IONetworkUdpHelper>(
-      *this,
-      theIoNetworkControlInterfacePort,
-      MDN::m_theIoNwControlMessageMaximumLengthBytes))
+   m_TransportPtr(std::move(transport)),
+   m_MaximumMessageBytes(m_theIoNwControlMessageMaximumLengthBytes),
+   m_NextTransferId(0),
+   m_CompactResponse(false),
+   m_ResponseSequence(0),
+   m_ResponseCapturePtr(nullptr),
+   m_CaptureRequestTimerId(GLTWInvalidTimerId)
 {
-
+   if (!m_TransportPtr)
+   {
+      m_TransportPtr = std::make_unique<IONetworkUdpHelper>(
+         *this,
+         m_theIoNwControlInterfacePort,
+         MDN::m_theIoNwControlMessageMaximumLengthBytes);
+   }
 }
 
 /******************************************************************************/
@@ -101,21 +117,32 @@ GLResourceMain& IONetworkControlInterfaceManager::Resource()
 }
 
 /******************************************************************************/
-IONetworkUdpHelper& IONetworkControlInterfaceManager::UdpHelper()
+IONetworkTransport& IONetworkControlInterfaceManager::Transport()
 {
-   return *m_UdpHelperPtr;
+   return *m_TransportPtr;
 }
 
 /******************************************************************************/
 void IONetworkControlInterfaceManager::StartNetworkControlInterface()
 {
-   if(UdpHelper().ActivateUdpHelper())
+   if(Transport().ActivateTransport())
    {
       Resource().EventLog().LogEvent(
          MDN::GLCF_GL_IO_NETWORK_CONTROL_INTERFACE_MANAGER_ID,
          "StartNetworkControlInterface:: Active.",
          MDN::GLEV_EVENT_LEVEL_1);
 
+      // Only a socket transport records datagrams; SIGUSR1 asks for them.
+      if (IOFRRecorderEnabled && Transport().ReceiveFd() != SOCKUDP_NULL_SOCKET_FD)
+      {
+         m_CaptureRequestTimerId = Resource().TimerWheel().Schedule(
+            *this,
+            IONCIMCaptureRequestIntervalNs,
+            IONCIMCaptureRequestIntervalNs);
+      }
+
+      // A transport that cannot be polled is driven by its owner through
+      // ProcessReceivedMessages().
       m_ReceiveActive = true;
       ControlInterfaceReceive();
    }
@@ -131,7 +158,13 @@ void IONetworkControlInterfaceManager::StartNetworkControlInterface()
 /******************************************************************************/
 void IONetworkControlInterfaceManager::StopNetworkControlInterface()
 {
-   if(UdpHelper().ShutdownUdpHelper())
+   if (m_CaptureRequestTimerId != GLTWInvalidTimerId)
+   {
+      Resource().TimerWheel().Cancel(m_CaptureRequestTimerId);
+      m_CaptureRequestTimerId = GLTWInvalidTimerId;
+   }
+
+   if(Transport().ShutdownTransport())
    {
       m_ReceiveActive = false;
 
@@ -152,33 +185,90 @@ void IONetworkControlInterfaceManager::StopNetworkControlInterface()
 /******************************************************************************/
 void IONetworkControlInterfaceManager::ControlInterfaceReceive()
 {
-   uint8_t message[m_theIoNwControlMessageFixedLengthBytes + 1];
+   if (Transport().Active() && Transport().ReceiveFd() != SOCKUDP_NULL_SOCKET_FD)
+   {
+      // The timer wheel is driven from this thread: its timerfd is polled
+      // next to the socket so expiries run between messages.
+      struct pollfd pollFds[2] =
+      {
+         {Transport().ReceiveFd(), POLLIN, 0},
+         {Resource().TimerWheel().TimerFd(), POLLIN, 0},
+      };
+
+      while (m_ReceiveActive)
+      {
+         if (poll(pollFds, 2, -1) < 0)
+         {
+            continue;
+         }
+
+         if ((pollFds[1].revents & POLLIN) != 0)
+         {
+            Resource().TimerWheel().ProcessTimerFd();
+         }
+
+         if ((pollFds[0].revents & POLLIN) != 0)
+         {
+            ReceiveAndProcessMessage();
+         }
+      }
+   }
+}
+
+/******************************************************************************/
+uint32_t IONetworkControlInterfaceManager::ProcessReceivedMessages()
+{
+   uint32_t received = 0;
+
+   while (m_ReceiveActive && ReceiveAndProcessMessage())
+   {
+      received++;
+   }
+
+   return (received);
+}
+
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::ReceiveAndProcessMessage()
+{
+   uint8_t message[m_theIoNwControlMessageMaximumLengthBytes + 1];
    int32_t len = 0;
    std::string sourceIpAddress;
    bool success = false;
 
-   if (UdpHelper().Active())
+   success = Transport().ReceiveMessage(message, len, sourceIpAddress);
+
+   if (success && (len > MDN::SOCK_RECEIVE_FAILURE))
    {
-      while (m_ReceiveActive)
+
+      if (IONetworkControlMessage::ValidateReceivedMessage(message, len))
       {
-         success = UdpHelper().ReceiveMessage(message, len, sourceIpAddress);
+         IONetworkControlMessagePtr newMsgPtr = std::make_shared<IONetworkControlMessage>(message, len);
 
-         if (success && (len > MDN::SOCK_RECEIVE_FAILURE))
+         uint64_t receiveTimeNs = Transport().LastReceiveTimeNs();
+         if (receiveTimeNs != 0)
          {
+            newMsgPtr->SetReceiveTime(receiveTimeNs, true);
+         }
+         else
+         {
+            newMsgPtr->SetReceiveTime(Resource().TimeHelper().GetEpochTimeInNs(), false);
+         }
+         newMsgPtr->SetSource(sourceIpAddress, Transport().SourcePort());
 
-            if (IONetworkControlMessage::ValidateReceivedMessage(message, len))
-            {
-               std::string eventStr;
-               IONetworkControlMsgIds msgId = (IONetworkControlMsgIds)(message[8] << 8 | message[9]);
-               std::string msgName = std::string(IONetworkControlMessage::MessageName(msgId));
-
-               IONetworkControlMessagePtr newMsgPtr = std::make_shared<IONetworkControlMessage>(message);
+         // Responses go out in the format the client asked for.
+         m_CompactResponse = newMsgPtr->CompactResponse();
+         m_ResponseSequence = newMsgPtr->Sequence();
 
-               MessageToBeProcessed(newMsgPtr);
-            }
+         if (FirstRequest(newMsgPtr))
+         {
+            MessageToBeProcessed(newMsgPtr);
          }
+         m_ReplayClient.clear();
       }
    }
+
+   return (success);
 }
 
 /******************************************************************************/
@@ -202,6 +292,43 @@ void IONetworkControlInterfaceManager::MessageToBeProcessed(
    }
 }
 
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::DumpCapture(uint32_t& datagrams)
+{
+   bool success = Transport().DumpCapture(IOFRCaptureFilePath, datagrams);
+
+   if (success)
+   {
+      char eventStr[GLEVEEventMaximumLengthChars];
+      snprintf(eventStr, sizeof(eventStr), "DumpCapture: %u datagrams.", datagrams);
+      Resource().EventLog().LogEvent(
+         ModuleId(),
+         eventStr,
+         GLEV_EVENT_LEVEL_1);
+   }
+   else
+   {
+      Resource().ErrorLog().LogError(
+         ModuleId(),
+         "DumpCapture(): Write FAIL.",
+         GLEL_ERROR_LEVEL_1);
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+/*               T I M E R  W H E E L  I N T F  M E T H O D S                 */
+/******************************************************************************/
+void IONetworkControlInterfaceManager::EventTimerExpired(GLTimerId timerId, uint64_t)
+{
+   if (timerId == m_CaptureRequestTimerId && IONetworkFlightRecorder::TakeDumpRequest())
+   {
+      uint32_t datagrams = 0;
+      DumpCapture(datagrams);
+   }
+}
+
 /******************************************************************************/
 /*               N E T W O R K  U D P  I N T F  M E T H O D S                 */
 /******************************************************************************/
@@ -231,14 +358,23 @@ bool IONetworkControlInterfaceManager::SendResponseMessageToSource(
    uint8_t* message,
    int32_t len)
 {
-   bool success = UdpHelper().SendMessageWithTempUnconnectedSocket(
+   if (m_ResponseCapturePtr != nullptr)
+   {
+      return (CaptureResponseMessage(message, len));
+   }
+
+   uint8_t compact[m_theIoNwControlMessageMaximumLengthBytes];
+   message = FrameResponse(message, len, compact);
+   RecordResponse(message, len, m_theIoNwControlInterfacePort);
+
+   bool success = Transport().SendMessageToTarget(
       message,
       len,
-      UdpHelper().SourceIp(),
-      theIoNetworkControlInterfacePort);
+      Transport().SourceIp(),
+      m_theIoNwControlInterfacePort);
 
    std::string logStr = "SendResponseMessageToSource: ip:"
-      + UdpHelper().SourceIp() + ", port: " + std::to_string(theIoNetworkControlInterfacePort);
+      + Transport().SourceIp() + ", port: " + std::to_string(m_theIoNwControlInterfacePort);
    Resource().EventLog().LogEvent(
       ModuleId(),
       logStr.c_str(),
@@ -246,31 +382,246 @@ bool IONetworkControlInterfaceManager::SendResponseMessageToSource(
    return (success);
 }
 
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::SendResponseMessageToSourcePort(
+   uint8_t* message,
+   int32_t len)
+{
+   if (m_ResponseCapturePtr != nullptr)
+   {
+      return (CaptureResponseMessage(message, len));
+   }
+
+   uint8_t compact[m_theIoNwControlMessageMaximumLengthBytes];
+   message = FrameResponse(message, len, compact);
+   RecordResponse(message, len, Transport().SourcePort());
+
+   return (Transport().SendMessageToSource(message, len));
+}
+
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::SendMessageToClient(
+   uint8_t* message,
+   int32_t len,
+   const std::string& ipAddress,
+   int32_t port,
+   bool compact)
+{
+   uint8_t compactMessage[m_theIoNwControlMessageMaximumLengthBytes];
+
+   if (compact && len >= m_theIoNwControlMessageHeaderSizeBytes)
+   {
+      len = IONWCompactFromVersion1(message, static_cast<uint16_t>(len), 0, compactMessage);
+      message = compactMessage;
+   }
+
+   return (Transport().SendMessageToTarget(message, len, ipAddress, port));
+}
+
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::SendVariableResponseMessageToSourcePort(
+   uint16_t msgId,
+   const uint8_t* data,
+   uint32_t dataBytes)
+{
+   uint8_t message[m_theIoNwControlMessageMaximumLengthBytes];
+   bool success = true;
+
+   if (m_ResponseCapturePtr != nullptr)
+   {
+      return (CaptureResponse(msgId, data, dataBytes));
+   }
+
+   if (m_theIoNwControlMessageHeaderSizeBytes + dataBytes <= m_MaximumMessageBytes)
+   {
+      IONWEncodeHeader(msgId, static_cast<uint16_t>(dataBytes), message);
+      std::copy(data, data + dataBytes, message + m_theIoNwControlMessageHeaderSizeBytes);
+
+      return (SendResponseMessageToSourcePort(message, m_theIoNwControlMessageHeaderSizeBytes + dataBytes));
+   }
+
+   uint32_t segmentBytes = m_MaximumMessageBytes - m_theIoNwControlMessageHeaderSizeBytes -
+      IONWSchema<IONW_SEGMENT_RSP_TYPE>::dataBytes;
+   uint32_t segmentCount = (dataBytes + segmentBytes - 1) / segmentBytes;
+
+   if (segmentCount > UINT16_MAX)
+   {
+      Resource().ErrorLog().LogError(
+         ModuleId(),
+         "SendVariableResponseMessageToSourcePort(): Response too long to segment.",
+         GLEL_ERROR_LEVEL_1);
+      return (false);
+   }
+
+   IONW_SEGMENT_RSP_TYPE segment;
+   segment.responseId = msgId;
+   segment.transferId = m_NextTransferId++;
+   segment.segmentCount = static_cast<uint16_t>(segmentCount);
+   segment.totalBytes = dataBytes;
+
+   for (uint32_t offset = 0; success && offset < dataBytes; offset += segmentBytes)
+   {
+      uint16_t bytes = static_cast<uint16_t>(std::min(segmentBytes, dataBytes - offset));
+      uint16_t len = IONWEncodeWithTail(segment, data + offset, bytes, message);
+
+      success = SendResponseMessageToSourcePort(message, len);
+      segment.segmentIndex++;
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+uint8_t* IONetworkControlInterfaceManager::FrameResponse(
+   uint8_t* message,
+   int32_t& len,
+   uint8_t* compact)
+{
+   if (len < m_theIoNwControlMessageHeaderSizeBytes)
+   {
+      return (message);
+   }
+
+   if (!m_CompactResponse)
+   {
+      // The request's sequence number goes back where it came.
+      IONWWire<uint16_t>::Put(message + IONWHeaderReservedIndex, m_ResponseSequence);
+      return (message);
+   }
+
+   len = IONWCompactFromVersion1(message, static_cast<uint16_t>(len), m_ResponseSequence, compact);
+
+   return (compact);
+}
+
+/******************************************************************************/
+void IONetworkControlInterfaceManager::SetResponseCapture(IO_RESPONSE_CAPTURE_TYPE* capture)
+{
+   m_ResponseCapturePtr = capture;
+}
+
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::CaptureResponse(
+   uint16_t msgId,
+   const uint8_t* data,
+   uint32_t dataBytes)
+{
+   IO_RESPONSE_CAPTURE_TYPE& capture = *m_ResponseCapturePtr;
+
+   // A command answers once; should it answer again the last one is kept.
+   capture.msgId = msgId;
+   capture.captured = true;
+   capture.truncated = (dataBytes > capture.capacity);
+   capture.dataBytes = capture.truncated ? 0 : static_cast<uint16_t>(dataBytes);
+   std::copy(data, data + capture.dataBytes, capture.data);
+
+   return (true);
+}
+
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::CaptureResponseMessage(
+   const uint8_t* message,
+   int32_t len)
+{
+   if (len < m_theIoNwControlMessageHeaderSizeBytes)
+   {
+      return (false);
+   }
+
+   return (CaptureResponse(
+      IONWWire<uint16_t>::Get(message + IONWHeaderMsgIdIndex),
+      message + m_theIoNwControlMessageHeaderSizeBytes,
+      static_cast<uint32_t>(len - m_theIoNwControlMessageHeaderSizeBytes)));
+}
+
+/******************************************************************************/
+void IONetworkControlInterfaceManager::RecordResponse(
+   uint8_t* message,
+   int32_t len,
+   int32_t port)
+{
+   if (!m_ReplayClient.empty())
+   {
+      m_ReplayCache.RecordResponse(m_ReplayClient, m_ResponseSequence, message, len, port);
+   }
+}
+
+/******************************************************************************/
+bool IONetworkControlInterfaceManager::FirstRequest(IONetworkControlMessagePtr& msgPtr)
+{
+   // Requests without a sequence number run every time.
+   if (msgPtr->Sequence() == 0)
+   {
+      return (true);
+   }
+
+   std::string client = msgPtr->SourceIp() + ":" + std::to_string(msgPtr->SourcePort());
+   IONetworkSequenceCheckType check = m_ReplayCache.CheckSequence(
+      client,
+      msgPtr->Sequence(),
+      Resource().TimeHelper().GetTimeInNs());
+
+   if (check == IONRC_SEQUENCE_NEW)
+   {
+      m_ReplayClient = client;
+      return (true);
+   }
+
+   bool replayed = false;
+   if (check == IONRC_SEQUENCE_DUPLICATE)
+   {
+      replayed = m_ReplayCache.ReplayResponse(
+         client,
+         msgPtr->Sequence(),
+         [this](uint8_t* message, int32_t len, int32_t port)
+         {
+            if (port == Transport().SourcePort())
+            {
+               return (Transport().SendMessageToSource(message, len));
+            }
+            return (Transport().SendMessageToTarget(message, len, Transport().SourceIp(), port));
+         });
+   }
+
+   // One fixed text per outcome so the repeat filter folds a retransmit
+   // storm into a single entry.
+   const char* eventStr =
+      (check == IONRC_SEQUENCE_TOO_OLD) ? "Repeated request too old, dropped." :
+      replayed ? "Repeated request replayed." : "Repeated request not cached, dropped.";
+   Resource().EventLog().LogEvent(
+      ModuleId(),
+      eventStr,
+      GLEV_EVENT_LEVEL_1);
+
+   return (false);
+}
+
+/******************************************************************************/
+void IONetworkControlInterfaceManager::SetMaximumMessageBytes(uint16_t bytes)
+{
+   m_MaximumMessageBytes = std::max(
+      m_theIoNwControlMessageFixedLengthBytes,
+      std::min(bytes, m_theIoNwControlMessageMaximumLengthBytes));
+}
+
+/******************************************************************************/
+uint16_t IONetworkControlInterfaceManager::MaximumMessageBytes()
+{
+   return m_MaximumMessageBytes;
+}
+
 /******************************************************************************/
 void IONetworkControlInterfaceManager::TestUdpTxWithTempSocket()
 {
    const std::string TX_TARGET_IP_ADDRESS("127.0.0.1");
-   const int32_t TX_TARGET_PORT = 49153;
-
-   //uint8_t message[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
-   //uint8_t msglen = 10;
-   uint8_t msglen = m_theIoNwControlMessageFixedLengthBytes;
-   std::array<uint8_t, m_theIoNwControlMessageFixedLengthBytes> message =
-      {0x55,0xAA,0x00,0xff,0xaa,0x55,0xff,0x00, // sync pattern
-       IONW_CONTROL_MSG_PING_INTERFACE_RSP >> 8,
-       IONW_CONTROL_MSG_PING_INTERFACE_RSP & 0x00ff, // command IONW_CONTROL_MSG_PING_INTERFACE_RSP
-       14, // number of data bytes
-       1,  // message format version
-       0x00, 0x00, //msg security number
-       0x00, 0x00, // reserved 1
-       0x00, 0x00, // msg verification value (CRC)
-       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}; // msg databool success;
-
-   bool success = UdpHelper().SendMessageWithTempUnconnectedSocket(
+
+   auto message = IONWEncode(IONW_PING_INTERFACE_RSP_TYPE());
+
+   bool success = Transport().SendMessageToTarget(
                      message.data(),
-                     msglen,
+                     message.size(),
                      TX_TARGET_IP_ADDRESS,
-                     TX_TARGET_PORT);
+                     m_theIoNwControlInterfacePort);
    if (success)
    {
       Resource().EventLog().LogEvent(
@@ -298,9 +649,9 @@ void IONetworkControlInterfaceManager::TestUdpRx()
    int32_t len = 0;
    std::string sourceIpAddress;
 
-   if (UdpHelper().Active())
+   if (Transport().Active())
    {
-      success = UdpHelper().ReceiveMessage(message, len, sourceIpAddress);
+      success = Transport().ReceiveMessage(message, len, sourceIpAddress);
 
       if (len > MDN::SOCK_RECEIVE_FAILURE)
       {
@@ -343,7 +694,7 @@ void IONetworkControlInterfaceManager::TestUdpRx()
                eventStr.c_str(),
                MDN::GLEV_EVENT_LEVEL_1);
 
-            IONetworkControlMessage newMessage(message);
+            IONetworkControlMessage newMessage(message, len);
          }
       }
    }
@@ -25,7 +25,10 @@
 
 #include "IONetworkControlMessage.h"
 #include "GLConfigureSystemModules.h"
+#include "GLTimerWheelIntf.h"
 #include "IONetworkUdpHelperIntf.h"
+#include "IONetworkReplayCache.h"
+#include "IONetworkTransport.h"
 
 /******************************************************************************/
 /*                              D E F I N E S                                 */
@@ -33,6 +36,9 @@
 namespace MDN
 {
 
+// How often a capture dump asked for by signal is looked for.
+const uint64_t IONCIMCaptureRequestIntervalNs = 250000000;
+
 /******************************************************************************/
 /*               F O R W A R D  D E C L A R A T I O N S                       */
 /******************************************************************************/
@@ -40,8 +46,6 @@ class GLResourceMain;
 class IOMessageQueueHelper;
 class IONetworkUdpHelper;
 
-using UdpHelperPtrType = std::unique_ptr<IONetworkUdpHelper>;
-
 /******************************************************************************/
 /*                  T Y P E D E F S  A N D  E N U M S                         */
 /******************************************************************************/
@@ -52,20 +56,40 @@ typedef enum
    IONCIM_STATE_ACTIVE
 } IONetworkControlInterfaceManagerStateType;
 
+// Where the response of a command run inside a BATCH goes instead of the
+// network.
+typedef struct response_capture_struct
+{
+   uint8_t* data = nullptr;      // room for the response data block
+   uint16_t capacity = 0;
+   uint16_t msgId = 0;
+   uint16_t dataBytes = 0;
+   bool captured = false;
+   bool truncated = false;       // longer than capacity, nothing kept
+} IO_RESPONSE_CAPTURE_TYPE;
+
 /******************************************************************************/
 /*                         D E C L A R A T I O N S                            */
 /******************************************************************************/
 class IONetworkControlInterfaceManager :
-   public virtual IONetworkUdpHelperIntf
+   public virtual IONetworkUdpHelperIntf,
+   public GLTimerWheelIntf
 {
    public:
-      IONetworkControlInterfaceManager(GLResourceMain& resource);
+      // Without a transport the manager opens its UDP socket.
+      IONetworkControlInterfaceManager(
+         GLResourceMain& resource,
+         IONetworkTransportPtr transport = nullptr);
       ~IONetworkControlInterfaceManager();
 
       void StartNetworkControlInterface();
       void StopNetworkControlInterface();
       bool Active();
 
+      // Receives and processes every datagram already queued on a transport
+      // that cannot be polled.  Returns the number of datagrams received.
+      uint32_t ProcessReceivedMessages();
+
       const GLCFDomainIds DomainId();
       const GLCFModuleIds ModuleId();
       const std::string& ModuleName();
@@ -74,6 +98,40 @@ class IONetworkControlInterfaceManager :
       virtual void EventUdpHelperActive() override;
       virtual void EventUdpHelperInactive() override;
       bool SendResponseMessageToSource(uint8_t* message, int32_t len);
+      // To the address and port the message came from, not the server port.
+      bool SendResponseMessageToSourcePort(uint8_t* message, int32_t len);
+      // Sends a response data block of any length to the source port: as one
+      // message while it fits MaximumMessageBytes(), else as SEGMENT_RSP
+      // messages.
+      bool SendVariableResponseMessageToSourcePort(
+         uint16_t msgId,
+         const uint8_t* data,
+         uint32_t dataBytes);
+
+      // Sends a message no request asked for, a telemetry push, to a client
+      // with the compact header when compact, else as it is.
+      bool SendMessageToClient(
+         uint8_t* message,
+         int32_t len,
+         const std::string& ipAddress,
+         int32_t port,
+         bool compact);
+
+      // The largest message sent, for a path with a smaller MTU; between
+      // m_theIoNwControlMessageFixedLengthBytes and
+      // m_theIoNwControlMessageMaximumLengthBytes.
+      void SetMaximumMessageBytes(uint16_t bytes);
+      uint16_t MaximumMessageBytes();
+
+      // While set, the response sent is kept in capture rather than sent;
+      // nullptr sends responses again.
+      void SetResponseCapture(IO_RESPONSE_CAPTURE_TYPE* capture);
+
+      // Writes the flight recorder of the transport to IOFRCaptureFilePath.
+      bool DumpCapture(uint32_t& datagrams);
+
+      // T I M E R  W H E E L  I N T E R F A C E
+      void EventTimerExpired(GLTimerId timerId, uint64_t context) override;
 
       // Tests
       void TestUdpTxWithTempSocket();
@@ -81,9 +139,20 @@ class IONetworkControlInterfaceManager :
 
    private:
       GLResourceMain& Resource();
-      IONetworkUdpHelper& UdpHelper();
+      IONetworkTransport& Transport();
       void ControlInterfaceReceive();
+      bool ReceiveAndProcessMessage();
       void MessageToBeProcessed(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      // A version 1 response rewritten with the compact header into
+      // compact when the client asked for it, else message as it is.
+      uint8_t* FrameResponse(uint8_t* message, int32_t& len, uint8_t* compact);
+      bool CaptureResponse(uint16_t msgId, const uint8_t* data, uint32_t dataBytes);
+      bool CaptureResponseMessage(const uint8_t* message, int32_t len);
+      // Keeps a response datagram for a retransmitted request.
+      void RecordResponse(uint8_t* message, int32_t len, int32_t port);
+      // False when msgPtr repeats a request already run; its response has
+      // then been sent again if it is still cached.
+      bool FirstRequest(IONetworkControlMessagePtr& msgPtr);
 
       IONetworkControlInterfaceManagerStateType State();
 
@@ -91,8 +160,16 @@ class IONetworkControlInterfaceManager :
       const GLCFModuleIds m_ModuleId;
       IONetworkControlInterfaceManagerStateType m_State;
       GLResourceMain& m_ResourceMain;
-      UdpHelperPtrType m_UdpHelperPtr;
+      IONetworkTransportPtr m_TransportPtr;
       bool m_ReceiveActive;
+      uint16_t m_MaximumMessageBytes;
+      uint16_t m_NextTransferId;
+      bool m_CompactResponse;
+      uint16_t m_ResponseSequence;
+      IO_RESPONSE_CAPTURE_TYPE* m_ResponseCapturePtr;
+      IONetworkReplayCache m_ReplayCache;
+      std::string m_ReplayClient;       // empty while responses are not kept
+      GLTimerId m_CaptureRequestTimerId;
 };
 
 }
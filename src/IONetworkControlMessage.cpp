@@ -19,6 +19,7 @@
 /*       I N C L U D E S                                                      */
 /******************************************************************************/
 #include "IONetworkUdpHelper.h"
+#include "IONetworkControlCodec.h"
 #include "IONetworkControlMessage.h"
 
 using namespace MDN;
@@ -26,20 +27,49 @@ using namespace MDN;
 /******************************************************************************/
 /*                     I M P L E M E N T A T I O N                            */
 /******************************************************************************/
-IONetworkControlMessage::IONetworkControlMessage(uint8_t *message)
+IONetworkControlMessage::IONetworkControlMessage(uint8_t *message, int32_t len)
+   :
+   m_Compact(IONWCompactMessage(message, len)),
+   m_DataBytes(0),
+   m_ReceiveTimeNs(0),
+   m_KernelReceiveTime(false),
+   m_SourcePort(0)
 {
-   uint16_t index = m_theSyncPatternSizeBytes;
-   m_msg.Header.msgId = message[index++] << 8 | message[index++];
-   m_msg.Header.numberOfDataBytes = message[index++];
-   m_msg.Header.dataFormatVersion = message[index++];
-   m_msg.Header.securityNumber = message[index++] << 8 | message[index++];
-   m_msg.Header.headerReserved1 = message[index++] << 8 | message[index++];
-   m_msg.Header.msgVerification = message[index++] << 8 | message[index++];
+   uint16_t index = 0;
+   uint16_t headerBytes = 0;
+
+   if (m_Compact)
+   {
+      // Mapped onto the version 1 header; the sequence number goes where
+      // version 1 carries it.
+      headerBytes = IONWCompactHeaderSizeBytes;
+      m_DataBytes = static_cast<uint16_t>(len - headerBytes);
+      m_msg.Header.msgId = IONWWire<uint16_t>::Get(message + IONWCompactMsgIdIndex);
+      m_msg.Header.numberOfDataBytes = static_cast<uint8_t>(
+            (m_DataBytes < m_theIoNwControlMessageExtendedDataBytes) ?
+            m_DataBytes : m_theIoNwControlMessageExtendedDataBytes);
+      m_msg.Header.dataFormatVersion = IONWCompactFormatVersion;
+      m_msg.Header.securityNumber = 0;
+      m_msg.Header.headerReserved1 = IONWWire<uint16_t>::Get(message + IONWCompactSequenceIndex);
+      m_msg.Header.msgVerification = 0;
+   }
+   else
+   {
+      headerBytes = m_theIoNwControlMessageHeaderSizeBytes;
+      m_DataBytes = static_cast<uint16_t>(len - headerBytes);
+      index = m_theSyncPatternSizeBytes;
+      m_msg.Header.msgId = message[index++] << 8 | message[index++];
+      m_msg.Header.numberOfDataBytes = message[index++];
+      m_msg.Header.dataFormatVersion = message[index++];
+      m_msg.Header.securityNumber = message[index++] << 8 | message[index++];
+      m_msg.Header.headerReserved1 = message[index++] << 8 | message[index++];
+      m_msg.Header.msgVerification = message[index++] << 8 | message[index++];
+   }
 
    index = 0;
-   while (index < m_theIONwControlMessageDataBytesBlockSizeBytes)
+   while (index < m_DataBytes)
    {
-      m_msg.msgData[index] = message[m_theIoNwControlMessageHeaderSizeBytes + index];
+      m_msg.msgData[index] = message[headerBytes + index];
       index++;
    }
 }
@@ -61,6 +91,74 @@ uint8_t IONetworkControlMessage::NumberOfDataBytes()
    return m_msg.Header.numberOfDataBytes;
 }
 
+/******************************************************************************/
+uint16_t IONetworkControlMessage::DataBytes()
+{
+   return m_DataBytes;
+}
+
+/******************************************************************************/
+uint8_t IONetworkControlMessage::FormatVersion()
+{
+   return m_Compact ? IONWCompactFormatVersion : IONWMessageFormatVersion;
+}
+
+/******************************************************************************/
+bool IONetworkControlMessage::CompactResponse()
+{
+   return (m_Compact || m_msg.Header.dataFormatVersion == IONWCompactFormatVersion);
+}
+
+/******************************************************************************/
+uint16_t IONetworkControlMessage::Sequence()
+{
+   return m_msg.Header.headerReserved1;
+}
+
+/******************************************************************************/
+const uint8_t* IONetworkControlMessage::MessageData()
+{
+   return m_msg.msgData;
+}
+
+/******************************************************************************/
+void IONetworkControlMessage::SetReceiveTime(uint64_t timeNs, bool kernelTimestamp)
+{
+   m_ReceiveTimeNs = timeNs;
+   m_KernelReceiveTime = kernelTimestamp;
+}
+
+/******************************************************************************/
+uint64_t IONetworkControlMessage::ReceiveTimeNs()
+{
+   return m_ReceiveTimeNs;
+}
+
+/******************************************************************************/
+bool IONetworkControlMessage::KernelReceiveTime()
+{
+   return m_KernelReceiveTime;
+}
+
+/******************************************************************************/
+void IONetworkControlMessage::SetSource(const std::string& ipAddress, int32_t port)
+{
+   m_SourceIp = ipAddress;
+   m_SourcePort = port;
+}
+
+/******************************************************************************/
+const std::string& IONetworkControlMessage::SourceIp()
+{
+   return m_SourceIp;
+}
+
+/******************************************************************************/
+int32_t IONetworkControlMessage::SourcePort()
+{
+   return m_SourcePort;
+}
+
 // Static Methods
 /******************************************************************************/
 bool IONetworkControlMessage::ValidateReceivedMessage(uint8_t *msgPtr, int32_t len)
@@ -68,14 +166,38 @@ bool IONetworkControlMessage::ValidateReceivedMessage(uint8_t *msgPtr, int32_t l
    bool valid = false;
    uint16_t index = 0;
 
-   if (  msgPtr[index++] == 0x55 && msgPtr[index++] == 0xAA &&
+   if (IONWCompactMessage(msgPtr, len))
+   {
+      int32_t dataBytes = len - IONWCompactHeaderSizeBytes;
+
+      return (dataBytes <= m_theIoNwControlMessageMaximumDataBytes &&
+         dataBytes == IONWWire<uint16_t>::Get(msgPtr + IONWCompactDataBytesIndex));
+   }
+
+   if (  len >= m_theIoNwControlMessageHeaderSizeBytes &&
+         len <= m_theIoNwControlMessageMaximumLengthBytes &&
+         msgPtr[index++] == 0x55 && msgPtr[index++] == 0xAA &&
          msgPtr[index++] == 0x00 && msgPtr[index++] == 0xFF &&
          msgPtr[index++] == 0xAA && msgPtr[index++] == 0x55 &&
-         msgPtr[index++] == 0xFF && msgPtr[index++] == 0x00 &&
-         len == m_theIoNwControlMessageFixedLengthBytes)
+         msgPtr[index++] == 0xFF && msgPtr[index++] == 0x00)
    {
-      // MessageType = IONetworkControlMessageType;
-      valid = true;
+      int32_t dataBytes = len - m_theIoNwControlMessageHeaderSizeBytes;
+      uint8_t numberOfDataBytes = msgPtr[IONWHeaderDataBytesIndex];
+
+      // The fixed length messages of the older tools are taken whatever
+      // their data byte count says.
+      if (len == m_theIoNwControlMessageFixedLengthBytes)
+      {
+         valid = true;
+      }
+      else if (numberOfDataBytes == m_theIoNwControlMessageExtendedDataBytes)
+      {
+         valid = (dataBytes >= m_theIoNwControlMessageExtendedDataBytes);
+      }
+      else
+      {
+         valid = (dataBytes == numberOfDataBytes);
+      }
    }
 
    return (valid);
@@ -84,13 +206,15 @@ bool IONetworkControlMessage::ValidateReceivedMessage(uint8_t *msgPtr, int32_t l
 /******************************************************************************/
 const std::string& IONetworkControlMessage::MessageName(IONetworkControlMsgIds MsgId)
 {
-   return m_theIONetworkControlMsgNameMap.at(MsgId);
+   auto iter = m_theIONetworkControlMsgNameMap.find(MsgId);
+
+   return (iter != m_theIONetworkControlMsgNameMap.end()) ? iter->second : m_theUnknwnMessageName;
 }
 
 /******************************************************************************/
 const std::string& IONetworkControlMessage::MessageName(uint16_t MsgId)
 {
-   return m_theIONetworkControlMsgNameMap.at((IONetworkControlMsgIds) MsgId);
+   return MessageName((IONetworkControlMsgIds) MsgId);
 }
 
 /******************************************************************************/
@@ -22,6 +22,7 @@
 /*                              I N C L U D E S                               */
 /******************************************************************************/
 #include <memory>
+#include <string>
 
 #include "IONetworkControlMessages.h"
 
@@ -30,12 +31,20 @@
 /******************************************************************************/
 namespace MDN
 {
-   static const uint16_t m_theIoNwControlMessageMaximumLengthBytes = 64;
+   // One UDP datagram in a 1500 byte Ethernet MTU, less the IP and UDP
+   // headers.  Longer responses are sent as SEGMENT_RSP datagrams.
+   static const uint16_t m_theIoNwControlMessageMaximumLengthBytes = 1472;
    static const uint16_t m_theIoNwControlMessageFixedLengthBytes = 32;
    static const uint16_t m_theIoNwControlMessageHeaderSizeBytes = 18;
    static const uint16_t m_theIONwControlMessageDataBytesBlockSizeBytes =
       m_theIoNwControlMessageFixedLengthBytes -
       m_theIoNwControlMessageHeaderSizeBytes;
+   static const uint16_t m_theIoNwControlMessageMaximumDataBytes =
+      m_theIoNwControlMessageMaximumLengthBytes -
+      m_theIoNwControlMessageHeaderSizeBytes;
+   // numberOfDataBytes saturates here; a data block of this size or more is
+   // as long as the datagram says.
+   static const uint8_t m_theIoNwControlMessageExtendedDataBytes = 0xFF;
    static const uint64_t m_theIoNetworkControlMsgHeaderSyncPattern = 0x55AA00FFAA55FF00;
    static const uint16_t m_theSyncPatternSizeBytes = sizeof(m_theIoNetworkControlMsgHeaderSyncPattern);
 
@@ -53,8 +62,7 @@ namespace MDN
    typedef struct message_struct
    {
       IO_NETWORK_CONTROL_MESSAGE_HEADER_TYPE Header;
-      // FIRST POC DO FIXED LENGTH COMMAND MESSAGES OF m_theIoNwControlMessageFixedLengthBytes
-      uint8_t  msgData[m_theIONwControlMessageDataBytesBlockSizeBytes];
+      uint8_t  msgData[m_theIoNwControlMessageMaximumDataBytes];
    } IO_NETWORK_CONTROL_MESSAGE_TYPE;
 
 /******************************************************************************/
@@ -68,7 +76,8 @@ namespace MDN
 class IONetworkControlMessage
 {
    public:
-      IONetworkControlMessage(uint8_t *receivedMsgBytes);
+      // receivedMsgBytes has passed ValidateReceivedMessage().
+      IONetworkControlMessage(uint8_t *receivedMsgBytes, int32_t len);
       ~IONetworkControlMessage();
 
       // S T A T I C  M E T H O D S
@@ -79,9 +88,33 @@ class IONetworkControlMessage
       // G E T T E R S  /  S E T T E R S
       uint16_t MessageId();
       uint8_t NumberOfDataBytes();
+      // The data block length taken from the datagram.
+      uint16_t DataBytes();
+      // 1, or 2 for the compact header.
+      uint8_t FormatVersion();
+      // The client wants compact responses: it sent a compact message or a
+      // version 1 message with dataFormatVersion 2.
+      bool CompactResponse();
+      uint16_t Sequence();
+      const uint8_t* MessageData();
+
+      // CLOCK_REALTIME ns, from the kernel when kernelTimestamp is set.
+      void SetReceiveTime(uint64_t timeNs, bool kernelTimestamp);
+      uint64_t ReceiveTimeNs();
+      bool KernelReceiveTime();
+
+      void SetSource(const std::string& ipAddress, int32_t port);
+      const std::string& SourceIp();
+      int32_t SourcePort();
 
    private:
       IO_NETWORK_CONTROL_MESSAGE_TYPE m_msg;
+      bool m_Compact;
+      uint16_t m_DataBytes;
+      uint64_t m_ReceiveTimeNs;
+      bool m_KernelReceiveTime;
+      std::string m_SourceIp;
+      int32_t m_SourcePort;
 
 };
    typedef std::shared_ptr<IONetworkControlMessage> IONetworkControlMessagePtr;
@@ -21,6 +21,7 @@
 /******************************************************************************/
 /*                              I N C L U D E S                               */
 /******************************************************************************/
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -50,6 +51,12 @@ typedef enum
    IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT,
    IONW_CONTROL_MSG_GET_SOC_VOLTAGE,
    IONW_CONTROL_MSG_GET_SOC_LIMIT,
+   IONW_CONTROL_MSG_CLOCK_SYNC,
+   IONW_CONTROL_MSG_BATCH,
+   IONW_CONTROL_MSG_DUMP_CAPTURE,
+   IONW_CONTROL_MSG_SUBSCRIBE,
+   IONW_CONTROL_MSG_UNSUBSCRIBE,
+   IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY,
 
 
    // OUTBOUND RESPONSES
@@ -65,11 +72,38 @@ typedef enum
    IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP,
    IONW_CONTROL_MSG_GET_SOC_VOLTAGE_RSP,
    IONW_CONTROL_MSG_GET_SOC_LIMIT_RSP,
+   IONW_CONTROL_MSG_CLOCK_SYNC_RSP,
+   IONW_CONTROL_MSG_SEGMENT_RSP,
+   IONW_CONTROL_MSG_BATCH_RSP,
+   IONW_CONTROL_MSG_DUMP_CAPTURE_RSP,
+   IONW_CONTROL_MSG_SUBSCRIBE_RSP,
+   IONW_CONTROL_MSG_UNSUBSCRIBE_RSP,
+   IONW_CONTROL_MSG_TELEMETRY_PUSH,     // unsolicited, to subscribers
+   IONW_CONTROL_MSG_ALARM_NOTIFY,       // unsolicited, to alarm subscribers
+   IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY_RSP,
 
    IONW_CONTROL_MSG_SHUTDOWN_INTERFACE = 0xFFFF,
 
 } IONetworkControlMsgIds;
 
+// The outcome of one command, as reported in a BATCH_RSP.
+typedef enum
+{
+   IONW_STATUS_SUCCESS = 0,
+   IONW_STATUS_FAILED,           // the command failed or sent no response
+   IONW_STATUS_UNSUPPORTED,      // no handler for the message id
+   IONW_STATUS_MALFORMED,        // the command runs past the end of the BATCH
+   IONW_STATUS_NOT_ALLOWED,      // not allowed inside a BATCH or from this client
+   IONW_STATUS_TRUNCATED,        // the response did not fit the BATCH_RSP
+   IONW_STATUS_UNAVAILABLE       // the data asked for is not available
+} IONetworkControlStatus;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+// The UDP port the server takes commands on.
+const uint16_t m_theIoNwControlInterfacePort = 49153;
+
 /******************************************************************************/
 /*                         D E C L A R A T I O N S                            */
 /******************************************************************************/
@@ -87,6 +121,12 @@ static const std::map<IONetworkControlMsgIds, std::string> m_theIONetworkControl
    {IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT, "GET SOC TEMPERATURE LIMIT"},
    {IONW_CONTROL_MSG_GET_SOC_VOLTAGE, "GET SOC VOLTAGE"},
    {IONW_CONTROL_MSG_GET_SOC_LIMIT, "GET SOC VOLTAGE LIMIT"},
+   {IONW_CONTROL_MSG_CLOCK_SYNC, "CLOCK_SYNC"},
+   {IONW_CONTROL_MSG_BATCH, "BATCH"},
+   {IONW_CONTROL_MSG_DUMP_CAPTURE, "DUMP_CAPTURE"},
+   {IONW_CONTROL_MSG_SUBSCRIBE, "SUBSCRIBE"},
+   {IONW_CONTROL_MSG_UNSUBSCRIBE, "UNSUBSCRIBE"},
+   {IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY, "GET_TELEMETRY_HISTORY"},
 
    {IONW_CONTROL_MSG_REQUEST_APP_SHUTDOWN_RSP, "REQUEST_APP_SHUTDOWN_RSP"},
    {IONW_CONTROL_MSG_PING_INTERFACE_RSP, "PING_INTERFACE_RSP"},
@@ -100,6 +140,15 @@ static const std::map<IONetworkControlMsgIds, std::string> m_theIONetworkControl
    {IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP, "GET SOC TEMPERATURE LIMIT_RSP"},
    {IONW_CONTROL_MSG_GET_SOC_VOLTAGE_RSP, "GET SOC VOLTAGE_RSP"},
    {IONW_CONTROL_MSG_GET_SOC_LIMIT_RSP, "GET SOC VOLTAGE LIMIT_RSP"},
+   {IONW_CONTROL_MSG_CLOCK_SYNC_RSP, "CLOCK_SYNC_RSP"},
+   {IONW_CONTROL_MSG_SEGMENT_RSP, "SEGMENT_RSP"},
+   {IONW_CONTROL_MSG_BATCH_RSP, "BATCH_RSP"},
+   {IONW_CONTROL_MSG_DUMP_CAPTURE_RSP, "DUMP_CAPTURE_RSP"},
+   {IONW_CONTROL_MSG_SUBSCRIBE_RSP, "SUBSCRIBE_RSP"},
+   {IONW_CONTROL_MSG_UNSUBSCRIBE_RSP, "UNSUBSCRIBE_RSP"},
+   {IONW_CONTROL_MSG_TELEMETRY_PUSH, "TELEMETRY_PUSH"},
+   {IONW_CONTROL_MSG_ALARM_NOTIFY, "ALARM_NOTIFY"},
+   {IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY_RSP, "GET_TELEMETRY_HISTORY_RSP"},
 
    {IONW_CONTROL_MSG_SHUTDOWN_INTERFACE, "SHUTDOWN NETWORK CONTROL INTERFACE"},
 };
@@ -0,0 +1,669 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkControlPayloads.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the data block of every control message as a payload
+   struct and its schema for IONetworkControlCodec.h.  Messages that carry
+   no data yet have an empty payload with the fixed 14 byte data block, the
+   version string responses are variable length text.
+*/
+/******************************************************************************/
+#ifndef io_network_control_payloads_h
+#define io_network_control_payloads_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include "IONetworkControlCodec.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const uint16_t IONW_PING_FLAG_TIMESTAMPS = 0x0001;
+const uint16_t IONW_PING_FLAG_KERNEL_RX_TIME = 0x0002;   // set by the server
+
+const uint8_t IONW_CLOCK_SYNC_FLAG_KERNEL_RX_TIME = 0x01;
+const uint8_t IONW_CLOCK_SYNC_FLAG_OFFSET_VALID = 0x02;
+
+/******************************************************************************/
+/*                       E M P T Y  P A Y L O A D S                           */
+/******************************************************************************/
+template <IONetworkControlMsgIds Id>
+struct IONWEmptyPayload
+{
+};
+
+template <IONetworkControlMsgIds Id>
+struct IONWSchema<IONWEmptyPayload<Id>>
+{
+   static constexpr IONetworkControlMsgIds msgId = Id;
+   static constexpr uint16_t dataBytes = m_theIONwControlMessageDataBytesBlockSizeBytes;
+   using Fields = IONWFields<>;
+};
+
+using IONW_REQUEST_APP_SHUTDOWN_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_REQUEST_APP_SHUTDOWN>;
+using IONW_REQUEST_INTERFACE_CONTROL_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL>;
+using IONW_RESTART_SOC_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_RESTART_SOC>;
+using IONW_REBOOT_ECU_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_REBOOT_ECU>;
+using IONW_GET_SOC_SW_VERSION_STRING_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_GET_SOC_SW_VERSION_STRING>;
+using IONW_GET_MCU_SW_VERSION_STRING_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_GET_MCU_SW_VERSION_STRING>;
+using IONW_GET_SWITCH_SW_VERSIONS_STRING_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_GET_SWITCH_SW_VERSIONS_STRING>;
+using IONW_GET_SOC_TEMPERATURE_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_GET_SOC_TEMPERATURE>;
+using IONW_GET_SOC_TEMPERATURE_LIMIT_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT>;
+using IONW_GET_SOC_VOLTAGE_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_GET_SOC_VOLTAGE>;
+using IONW_GET_SOC_LIMIT_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_GET_SOC_LIMIT>;
+using IONW_SHUTDOWN_INTERFACE_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_SHUTDOWN_INTERFACE>;
+
+using IONW_REQUEST_APP_SHUTDOWN_RSP_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_REQUEST_APP_SHUTDOWN_RSP>;
+using IONW_PING_INTERFACE_RSP_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_PING_INTERFACE_RSP>;
+using IONW_REQUEST_INTERFACE_CONTROL_RSP_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL_RSP>;
+using IONW_RESTART_SOC_RSP_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_RESTART_SOC_RSP>;
+using IONW_REBOOT_ECU_RSP_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_REBOOT_ECU_RSP>;
+
+/******************************************************************************/
+/*                        T E X T  P A Y L O A D S                            */
+/******************************************************************************/
+// The whole data block is text, not NUL terminated, encoded as the tail of
+// IONWEncodeWithTail() or segmented when it does not fit one datagram.
+template <IONetworkControlMsgIds Id>
+struct IONWTextPayload
+{
+};
+
+template <IONetworkControlMsgIds Id>
+struct IONWSchema<IONWTextPayload<Id>>
+{
+   static constexpr IONetworkControlMsgIds msgId = Id;
+   static constexpr uint16_t dataBytes = 0;
+   using Fields = IONWFields<>;
+};
+
+using IONW_GET_SOC_SW_VERSION_STRING_RSP_TYPE = IONWTextPayload<IONW_CONTROL_MSG_GET_SOC_SW_VERSION_STRING_RSP>;
+using IONW_GET_MCU_SW_VERSION_STRING_RSP_TYPE = IONWTextPayload<IONW_CONTROL_MSG_GET_MCU_SW_VERSION_STRING_RSP>;
+using IONW_GET_SWITCH_SW_VERSIONS_STRING_RSP_TYPE = IONWTextPayload<IONW_CONTROL_MSG_GET_SWITCH_SW_VERSIONS_STRING_RSP>;
+
+/******************************************************************************/
+/*                           S E G M E N T _ R S P                            */
+/******************************************************************************/
+// A response longer than one datagram goes out as segmentCount SEGMENT_RSP
+// messages of the same transferId, each followed by its part of the
+// response data block.  The receiver puts the parts together in
+// segmentIndex order; totalBytes is the length of the whole data block of
+// responseId.
+typedef struct segment_rsp_struct
+{
+   uint16_t responseId = 0;
+   uint16_t transferId = 0;
+   uint16_t segmentIndex = 0;
+   uint16_t segmentCount = 0;
+   uint32_t totalBytes = 0;
+} IONW_SEGMENT_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_SEGMENT_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_SEGMENT_RSP;
+   static constexpr uint16_t dataBytes = 12;
+   using Fields = IONWFields<
+      IONWField<&IONW_SEGMENT_RSP_TYPE::responseId, 0>,
+      IONWField<&IONW_SEGMENT_RSP_TYPE::transferId, 2>,
+      IONWField<&IONW_SEGMENT_RSP_TYPE::segmentIndex, 4>,
+      IONWField<&IONW_SEGMENT_RSP_TYPE::segmentCount, 6>,
+      IONWField<&IONW_SEGMENT_RSP_TYPE::totalBytes, 8>>;
+};
+
+// Response data carried by one SEGMENT_RSP at the full message length.
+const uint16_t IONWSegmentDataBytes =
+      m_theIoNwControlMessageMaximumDataBytes - IONWSchema<IONW_SEGMENT_RSP_TYPE>::dataBytes;
+
+/******************************************************************************/
+/*                          P I N G _ I N T E R F A C E                       */
+/******************************************************************************/
+// A client that sets IONW_PING_FLAG_TIMESTAMPS gets its data back in the
+// extended PING_INTERFACE_RSP, followed by the server receive and transmit
+// times (CLOCK_REALTIME ns), sent to the port the PING came from.  A PING
+// without the flag gets IONW_PING_INTERFACE_RSP_TYPE.
+typedef struct ping_interface_struct
+{
+   uint64_t clientTxNs = 0;
+   uint32_t sequence = 0;
+   uint16_t flags = 0;
+} IONW_PING_INTERFACE_TYPE;
+
+template <>
+struct IONWSchema<IONW_PING_INTERFACE_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_PING_INTERFACE;
+   static constexpr uint16_t dataBytes = m_theIONwControlMessageDataBytesBlockSizeBytes;
+   using Fields = IONWFields<
+      IONWField<&IONW_PING_INTERFACE_TYPE::clientTxNs, 0>,
+      IONWField<&IONW_PING_INTERFACE_TYPE::sequence, 8>,
+      IONWField<&IONW_PING_INTERFACE_TYPE::flags, 12>>;
+};
+
+typedef struct timestamped_ping_interface_rsp_struct
+{
+   uint64_t clientTxNs = 0;
+   uint32_t sequence = 0;
+   uint16_t flags = 0;
+   uint64_t serverRxNs = 0;
+   uint64_t serverTxNs = 0;
+} IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_PING_INTERFACE_RSP;
+   static constexpr uint16_t dataBytes = 30;
+   using Fields = IONWFields<
+      IONWField<&IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE::clientTxNs, 0>,
+      IONWField<&IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE::sequence, 8>,
+      IONWField<&IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE::flags, 12>,
+      IONWField<&IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE::serverRxNs, 14>,
+      IONWField<&IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE::serverTxNs, 22>>;
+};
+
+/******************************************************************************/
+/*                             C L O C K _ S Y N C                            */
+/******************************************************************************/
+// The client sends its transmit time t1 and, from the second exchange on,
+// the round trip t4 - t1 it measured for the previous sequence number (0 if
+// lost).  The CLOCK_SYNC_RSP goes to the port the request came from and
+// carries the server receive and transmit times t2 and t3 on the
+// GLTimeHelper timeline, i.e. that of the log timestamps, the server's best
+// offset (server minus client) and delay over the last exchanges of this
+// client, and the epoch time of the timeline's zero.
+typedef struct clock_sync_struct
+{
+   uint64_t clientTxNs = 0;
+   uint16_t sequence = 0;
+   uint32_t previousRoundTripNs = 0;
+} IONW_CLOCK_SYNC_TYPE;
+
+template <>
+struct IONWSchema<IONW_CLOCK_SYNC_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_CLOCK_SYNC;
+   static constexpr uint16_t dataBytes = m_theIONwControlMessageDataBytesBlockSizeBytes;
+   using Fields = IONWFields<
+      IONWField<&IONW_CLOCK_SYNC_TYPE::clientTxNs, 0>,
+      IONWField<&IONW_CLOCK_SYNC_TYPE::sequence, 8>,
+      IONWField<&IONW_CLOCK_SYNC_TYPE::previousRoundTripNs, 10>>;
+};
+
+typedef struct clock_sync_rsp_struct
+{
+   uint16_t sequence = 0;
+   uint8_t flags = 0;
+   uint8_t samples = 0;
+   uint64_t serverRxNs = 0;
+   uint64_t serverTxNs = 0;
+   int64_t offsetNs = 0;
+   uint32_t delayNs = 0;
+   uint64_t timelineEpochNs = 0;
+} IONW_CLOCK_SYNC_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_CLOCK_SYNC_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_CLOCK_SYNC_RSP;
+   static constexpr uint16_t dataBytes = 40;
+   using Fields = IONWFields<
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::sequence, 0>,
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::flags, 2>,
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::samples, 3>,
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::serverRxNs, 4>,
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::serverTxNs, 12>,
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::offsetNs, 20>,
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::delayNs, 28>,
+      IONWField<&IONW_CLOCK_SYNC_RSP_TYPE::timelineEpochNs, 32>>;
+};
+
+/******************************************************************************/
+/*                                B A T C H                                   */
+/******************************************************************************/
+// A BATCH carries commandCount commands back to back, each an entry header
+// followed by the command's data block.  The server runs them in order and
+// answers with one BATCH_RSP: a result entry per command run, each followed
+// by the data block of the command's response.  A BATCH_RSP with fewer
+// entries than commands ran out of room; the rest were not run.
+typedef struct batch_struct
+{
+   uint16_t commandCount = 0;
+} IONW_BATCH_TYPE;
+
+template <>
+struct IONWSchema<IONW_BATCH_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_BATCH;
+   static constexpr uint16_t dataBytes = 2;
+   using Fields = IONWFields<
+      IONWField<&IONW_BATCH_TYPE::commandCount, 0>>;
+};
+
+typedef struct batch_entry_struct
+{
+   uint16_t msgId = 0;
+   uint16_t dataBytes = 0;
+} IONW_BATCH_ENTRY_TYPE;
+
+template <>
+struct IONWSchema<IONW_BATCH_ENTRY_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_BATCH;
+   static constexpr uint16_t dataBytes = 4;
+   using Fields = IONWFields<
+      IONWField<&IONW_BATCH_ENTRY_TYPE::msgId, 0>,
+      IONWField<&IONW_BATCH_ENTRY_TYPE::dataBytes, 2>>;
+};
+
+typedef struct batch_rsp_struct
+{
+   uint16_t commandCount = 0;    // commands run
+   uint16_t failedCount = 0;     // of those, not IONW_STATUS_SUCCESS
+} IONW_BATCH_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_BATCH_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_BATCH_RSP;
+   static constexpr uint16_t dataBytes = 4;
+   using Fields = IONWFields<
+      IONWField<&IONW_BATCH_RSP_TYPE::commandCount, 0>,
+      IONWField<&IONW_BATCH_RSP_TYPE::failedCount, 2>>;
+};
+
+typedef struct batch_rsp_entry_struct
+{
+   uint16_t requestId = 0;
+   uint16_t responseId = 0;      // 0 with no response data
+   uint16_t dataBytes = 0;
+   uint16_t status = IONW_STATUS_SUCCESS;   // IONetworkControlStatus
+} IONW_BATCH_RSP_ENTRY_TYPE;
+
+template <>
+struct IONWSchema<IONW_BATCH_RSP_ENTRY_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_BATCH_RSP;
+   static constexpr uint16_t dataBytes = 8;
+   using Fields = IONWFields<
+      IONWField<&IONW_BATCH_RSP_ENTRY_TYPE::requestId, 0>,
+      IONWField<&IONW_BATCH_RSP_ENTRY_TYPE::responseId, 2>,
+      IONWField<&IONW_BATCH_RSP_ENTRY_TYPE::dataBytes, 4>,
+      IONWField<&IONW_BATCH_RSP_ENTRY_TYPE::status, 6>>;
+};
+
+/******************************************************************************/
+/*                          D U M P _ C A P T U R E                           */
+/******************************************************************************/
+// DUMP_CAPTURE has no data.  The server writes its flight recorder to
+// IOFRCaptureFilePath on its own file system and answers, to the port the
+// request came from, with the outcome and the datagrams written.  Only a
+// request from IOFRDumpControllerAddress is taken, others are answered
+// IONW_STATUS_NOT_ALLOWED.
+typedef struct dump_capture_rsp_struct
+{
+   uint16_t status = IONW_STATUS_SUCCESS;   // IONetworkControlStatus
+   uint32_t datagrams = 0;
+} IONW_DUMP_CAPTURE_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_DUMP_CAPTURE_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_DUMP_CAPTURE_RSP;
+   static constexpr uint16_t dataBytes = 6;
+   using Fields = IONWFields<
+      IONWField<&IONW_DUMP_CAPTURE_RSP_TYPE::status, 0>,
+      IONWField<&IONW_DUMP_CAPTURE_RSP_TYPE::datagrams, 2>>;
+};
+
+/******************************************************************************/
+/*                       S O C  T E L E M E T R Y                             */
+/******************************************************************************/
+// GET_SOC_TEMPERATURE, GET_SOC_TEMPERATURE_LIMIT, GET_SOC_VOLTAGE and
+// GET_SOC_LIMIT have no data.  Each response, sent to the port the request
+// came from, has the summary below followed by one entry per sensor: an
+// IONW_SOC_READING_TYPE for the readings, an IONW_SOC_LIMITS_TYPE for the
+// limits.  Temperatures are in m°C, voltages in mV, in thermal zone and
+// hwmon channel order; sampleAgeMs is how old the server's sample is.
+// status is IONW_STATUS_UNAVAILABLE, with no entries, when the server has
+// no telemetry.  A value the SoC does not give is IONW_SOC_NO_VALUE.
+const int32_t IONW_SOC_NO_VALUE = INT32_MIN;
+
+template <IONetworkControlMsgIds Id>
+struct IONWSocTelemetryPayload
+{
+   uint16_t status = IONW_STATUS_SUCCESS;   // IONetworkControlStatus
+   uint16_t sensorCount = 0;
+   uint32_t sampleAgeMs = 0;
+};
+
+template <IONetworkControlMsgIds Id>
+struct IONWSchema<IONWSocTelemetryPayload<Id>>
+{
+   static constexpr IONetworkControlMsgIds msgId = Id;
+   static constexpr uint16_t dataBytes = 8;
+   using Fields = IONWFields<
+      IONWField<&IONWSocTelemetryPayload<Id>::status, 0>,
+      IONWField<&IONWSocTelemetryPayload<Id>::sensorCount, 2>,
+      IONWField<&IONWSocTelemetryPayload<Id>::sampleAgeMs, 4>>;
+};
+
+using IONW_GET_SOC_TEMPERATURE_RSP_TYPE = IONWSocTelemetryPayload<IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_RSP>;
+using IONW_GET_SOC_TEMPERATURE_LIMIT_RSP_TYPE = IONWSocTelemetryPayload<IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP>;
+using IONW_GET_SOC_VOLTAGE_RSP_TYPE = IONWSocTelemetryPayload<IONW_CONTROL_MSG_GET_SOC_VOLTAGE_RSP>;
+using IONW_GET_SOC_LIMIT_RSP_TYPE = IONWSocTelemetryPayload<IONW_CONTROL_MSG_GET_SOC_LIMIT_RSP>;
+
+typedef struct soc_reading_struct
+{
+   int32_t value = IONW_SOC_NO_VALUE;
+} IONW_SOC_READING_TYPE;
+
+template <>
+struct IONWSchema<IONW_SOC_READING_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_RSP;
+   static constexpr uint16_t dataBytes = 4;
+   using Fields = IONWFields<
+      IONWField<&IONW_SOC_READING_TYPE::value, 0>>;
+};
+
+// Temperature: the lowest passive (or hot) and critical trip points.
+// Voltage: the minimum and maximum of the channel.
+typedef struct soc_limits_struct
+{
+   int32_t lower = IONW_SOC_NO_VALUE;
+   int32_t upper = IONW_SOC_NO_VALUE;
+} IONW_SOC_LIMITS_TYPE;
+
+template <>
+struct IONWSchema<IONW_SOC_LIMITS_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP;
+   static constexpr uint16_t dataBytes = 8;
+   using Fields = IONWFields<
+      IONWField<&IONW_SOC_LIMITS_TYPE::lower, 0>,
+      IONWField<&IONW_SOC_LIMITS_TYPE::upper, 4>>;
+};
+
+/******************************************************************************/
+/*                            S U B S C R I B E                               */
+/******************************************************************************/
+// SUBSCRIBE registers the client (source address and port) for pushes of
+// the telemetry selected by the IONW_TELEMETRY_ bits: a TELEMETRY_PUSH every
+// intervalMs or, with IONW_SUBSCRIBE_FLAG_ON_CHANGE, at most every
+// intervalMs when a value changed.  The subscription ends leaseMs after
+// the last SUBSCRIBE; sending it again renews it and replaces the terms.
+// 0 asks for the default interval or lease.  SUBSCRIBE_RSP carries the
+// terms granted; pushes use the header format of the SUBSCRIBE.
+// IONW_TELEMETRY_ALARMS adds no section to the pushes; it registers the
+// client for the ALARM_NOTIFY sent on each alarm edge.
+const uint16_t IONW_TELEMETRY_TEMPERATURE = 0x0001;
+const uint16_t IONW_TELEMETRY_TEMPERATURE_LIMIT = 0x0002;
+const uint16_t IONW_TELEMETRY_VOLTAGE = 0x0004;
+const uint16_t IONW_TELEMETRY_VOLTAGE_LIMIT = 0x0008;
+const uint16_t IONW_TELEMETRY_ALL = 0x000F;
+const uint16_t IONW_TELEMETRY_ALARMS = 0x0010;
+
+const uint8_t IONW_SUBSCRIBE_FLAG_ON_CHANGE = 0x01;
+
+typedef struct subscribe_struct
+{
+   uint16_t telemetry = 0;
+   uint8_t flags = 0;
+   uint32_t intervalMs = 0;
+   uint32_t leaseMs = 0;
+} IONW_SUBSCRIBE_TYPE;
+
+template <>
+struct IONWSchema<IONW_SUBSCRIBE_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_SUBSCRIBE;
+   static constexpr uint16_t dataBytes = m_theIONwControlMessageDataBytesBlockSizeBytes;
+   using Fields = IONWFields<
+      IONWField<&IONW_SUBSCRIBE_TYPE::telemetry, 0>,
+      IONWField<&IONW_SUBSCRIBE_TYPE::flags, 2>,
+      IONWField<&IONW_SUBSCRIBE_TYPE::intervalMs, 4>,
+      IONWField<&IONW_SUBSCRIBE_TYPE::leaseMs, 8>>;
+};
+
+typedef struct subscribe_rsp_struct
+{
+   uint16_t status = IONW_STATUS_SUCCESS;   // IONetworkControlStatus
+   uint16_t telemetry = 0;
+   uint32_t intervalMs = 0;
+   uint32_t leaseMs = 0;
+} IONW_SUBSCRIBE_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_SUBSCRIBE_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_SUBSCRIBE_RSP;
+   static constexpr uint16_t dataBytes = 12;
+   using Fields = IONWFields<
+      IONWField<&IONW_SUBSCRIBE_RSP_TYPE::status, 0>,
+      IONWField<&IONW_SUBSCRIBE_RSP_TYPE::telemetry, 2>,
+      IONWField<&IONW_SUBSCRIBE_RSP_TYPE::intervalMs, 4>,
+      IONWField<&IONW_SUBSCRIBE_RSP_TYPE::leaseMs, 8>>;
+};
+
+// UNSUBSCRIBE has no data; UNSUBSCRIBE_RSP fails when the client had no
+// subscription.
+using IONW_UNSUBSCRIBE_TYPE = IONWEmptyPayload<IONW_CONTROL_MSG_UNSUBSCRIBE>;
+
+typedef struct unsubscribe_rsp_struct
+{
+   uint16_t status = IONW_STATUS_SUCCESS;   // IONetworkControlStatus
+} IONW_UNSUBSCRIBE_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_UNSUBSCRIBE_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_UNSUBSCRIBE_RSP;
+   static constexpr uint16_t dataBytes = 2;
+   using Fields = IONWFields<
+      IONWField<&IONW_UNSUBSCRIBE_RSP_TYPE::status, 0>>;
+};
+
+// A TELEMETRY_PUSH holds one section per telemetry subscribed to, in
+// IONW_TELEMETRY_ bit order: the section header followed by the data block
+// of the GET_SOC_..._RSP that answers the same question.  sequence counts
+// the pushes to this subscriber from 1, so a lost one shows.
+typedef struct telemetry_push_struct
+{
+   uint32_t sequence = 0;
+   uint16_t sectionCount = 0;
+} IONW_TELEMETRY_PUSH_TYPE;
+
+template <>
+struct IONWSchema<IONW_TELEMETRY_PUSH_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_TELEMETRY_PUSH;
+   static constexpr uint16_t dataBytes = 6;
+   using Fields = IONWFields<
+      IONWField<&IONW_TELEMETRY_PUSH_TYPE::sequence, 0>,
+      IONWField<&IONW_TELEMETRY_PUSH_TYPE::sectionCount, 4>>;
+};
+
+typedef struct telemetry_section_struct
+{
+   uint16_t responseId = 0;
+   uint16_t dataBytes = 0;
+} IONW_TELEMETRY_SECTION_TYPE;
+
+template <>
+struct IONWSchema<IONW_TELEMETRY_SECTION_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_TELEMETRY_PUSH;
+   static constexpr uint16_t dataBytes = 4;
+   using Fields = IONWFields<
+      IONWField<&IONW_TELEMETRY_SECTION_TYPE::responseId, 0>,
+      IONWField<&IONW_TELEMETRY_SECTION_TYPE::dataBytes, 2>>;
+};
+
+/******************************************************************************/
+/*                              A L A R M S                                   */
+/******************************************************************************/
+// An ALARM_NOTIFY is sent when an alarm is raised or cleared, never while it
+// stays so.  sequence counts the edges from 1, for all subscribers alike, so
+// a lost one shows; activeAlarms is the number raised after this edge.
+// value and limit are those of the sample that completed the edge, in m°C
+// or mV; the limits are the ones GET_SOC_TEMPERATURE_LIMIT and
+// GET_SOC_LIMIT report.
+typedef enum
+{
+   IONW_ALARM_TEMPERATURE_PASSIVE = 0,   // temperature at the passive trip
+   IONW_ALARM_TEMPERATURE_CRITICAL,      // temperature at the critical trip
+   IONW_ALARM_VOLTAGE_LOW,               // voltage below its minimum
+   IONW_ALARM_VOLTAGE_HIGH,              // voltage above its maximum
+   IONW_ALARM_TYPES
+} IONetworkControlAlarmType;
+
+const uint8_t IONW_ALARM_CLEARED = 0;
+const uint8_t IONW_ALARM_RAISED = 1;
+
+typedef struct alarm_notify_struct
+{
+   uint32_t sequence = 0;
+   uint8_t alarm = 0;                    // IONetworkControlAlarmType
+   uint8_t sensor = 0;                   // thermal zone or voltage channel
+   uint8_t state = IONW_ALARM_CLEARED;
+   uint8_t activeAlarms = 0;
+   int32_t value = IONW_SOC_NO_VALUE;
+   int32_t limit = IONW_SOC_NO_VALUE;
+} IONW_ALARM_NOTIFY_TYPE;
+
+template <>
+struct IONWSchema<IONW_ALARM_NOTIFY_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_ALARM_NOTIFY;
+   static constexpr uint16_t dataBytes = 16;
+   using Fields = IONWFields<
+      IONWField<&IONW_ALARM_NOTIFY_TYPE::sequence, 0>,
+      IONWField<&IONW_ALARM_NOTIFY_TYPE::alarm, 4>,
+      IONWField<&IONW_ALARM_NOTIFY_TYPE::sensor, 5>,
+      IONWField<&IONW_ALARM_NOTIFY_TYPE::state, 6>,
+      IONWField<&IONW_ALARM_NOTIFY_TYPE::activeAlarms, 7>,
+      IONWField<&IONW_ALARM_NOTIFY_TYPE::value, 8>,
+      IONWField<&IONW_ALARM_NOTIFY_TYPE::limit, 12>>;
+};
+
+/******************************************************************************/
+/*                 G E T _ T E L E M E T R Y _ H I S T O R Y                  */
+/******************************************************************************/
+// GET_TELEMETRY_HISTORY asks for the readings of the IONW_TELEMETRY_
+// TEMPERATURE and / or VOLTAGE sensors from fromAgeMs to toAgeMs before
+// now, at one IONW_HISTORY_ resolution.  Of the totalRows in that range a
+// reply holds the rows from firstRow on that fit in
+// IONW_HISTORY_MAXIMUM_DATA_BYTES, so the server's replay cache can still
+// answer a retransmit; ask again from firstRow + rowCount for the rest.
+// The range is taken again for each request, so rows sampled in between
+// shift the pages by as many rows.
+// The RSP data block goes out as SEGMENT_RSP messages when it does not fit
+// one message:
+//
+//    IONW_GET_TELEMETRY_HISTORY_RSP_TYPE
+//    metricCount IONW_TELEMETRY_METRIC_TYPE   zones first, then channels
+//    rowCount    uint32_t ageMs               oldest first
+//    per metric, columns x rowCount int32_t   value (raw), or minimum,
+//                                             maximum, average
+//
+// A second or minute row is the bucket that started ageMs ago; the bucket
+// in progress is not in the history yet.
+const uint8_t IONW_HISTORY_RAW = 0;
+const uint8_t IONW_HISTORY_SECOND = 1;
+const uint8_t IONW_HISTORY_MINUTE = 2;
+const uint32_t IONW_HISTORY_MAXIMUM_DATA_BYTES = 4096;
+
+typedef struct get_telemetry_history_struct
+{
+   uint16_t telemetry = 0;               // IONW_TELEMETRY_ bits
+   uint8_t resolution = IONW_HISTORY_RAW;
+   uint32_t fromAgeMs = 0;
+   uint32_t toAgeMs = 0;
+   uint16_t firstRow = 0;                // of the range, oldest first
+} IONW_GET_TELEMETRY_HISTORY_TYPE;
+
+template <>
+struct IONWSchema<IONW_GET_TELEMETRY_HISTORY_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY;
+   static constexpr uint16_t dataBytes = m_theIONwControlMessageDataBytesBlockSizeBytes;
+   using Fields = IONWFields<
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_TYPE::telemetry, 0>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_TYPE::resolution, 2>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_TYPE::fromAgeMs, 4>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_TYPE::toAgeMs, 8>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_TYPE::firstRow, 12>>;
+};
+
+typedef struct get_telemetry_history_rsp_struct
+{
+   uint16_t status = IONW_STATUS_SUCCESS;   // IONetworkControlStatus
+   uint8_t resolution = IONW_HISTORY_RAW;
+   uint8_t columns = 0;
+   uint16_t rowCount = 0;
+   uint16_t metricCount = 0;
+   uint32_t periodMs = 0;                // sample interval or bucket width
+   uint16_t firstRow = 0;                // of the range, as asked
+   uint16_t totalRows = 0;               // in the range
+} IONW_GET_TELEMETRY_HISTORY_RSP_TYPE;
+
+template <>
+struct IONWSchema<IONW_GET_TELEMETRY_HISTORY_RSP_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY_RSP;
+   static constexpr uint16_t dataBytes = 16;
+   using Fields = IONWFields<
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::status, 0>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::resolution, 2>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::columns, 3>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::rowCount, 4>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::metricCount, 6>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::periodMs, 8>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::firstRow, 12>,
+      IONWField<&IONW_GET_TELEMETRY_HISTORY_RSP_TYPE::totalRows, 14>>;
+};
+
+typedef struct telemetry_metric_struct
+{
+   uint16_t telemetry = 0;               // one IONW_TELEMETRY_ bit
+   uint16_t sensor = 0;                  // thermal zone or voltage channel
+} IONW_TELEMETRY_METRIC_TYPE;
+
+template <>
+struct IONWSchema<IONW_TELEMETRY_METRIC_TYPE>
+{
+   static constexpr IONetworkControlMsgIds msgId = IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY_RSP;
+   static constexpr uint16_t dataBytes = 4;
+   using Fields = IONWFields<
+      IONWField<&IONW_TELEMETRY_METRIC_TYPE::telemetry, 0>,
+      IONWField<&IONW_TELEMETRY_METRIC_TYPE::sensor, 2>>;
+};
+
+/******************************************************************************/
+/*                 C O M P I L E  T I M E  C H E C K S                        */
+/******************************************************************************/
+// The data-less responses are the fixed 32 byte messages sent before.
+static_assert(IONWEncode(IONW_PING_INTERFACE_RSP_TYPE())[IONWHeaderMsgIdIndex] == 0x80 &&
+      IONWEncode(IONW_PING_INTERFACE_RSP_TYPE())[IONWHeaderMsgIdIndex + 1] == 0x01 &&
+      IONWEncode(IONW_PING_INTERFACE_RSP_TYPE()).size() == m_theIoNwControlMessageFixedLengthBytes,
+      "PING_INTERFACE_RSP encoding changed");
+
+}
+
+/******************************************************************************/
+
+#endif /* io_network_control_payloads_h */
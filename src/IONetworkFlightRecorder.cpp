@@ -0,0 +1,258 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkFlightRecorder.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the datagram flight recorder.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <signal.h>
+#include <stdio.h>
+
+#include "IONetworkFlightRecorder.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint32_t IOFRPcapMagicNanoseconds = 0xa1b23c4d;
+static const uint16_t IOFRPcapVersionMajor = 2;
+static const uint16_t IOFRPcapVersionMinor = 4;
+static const uint32_t IOFRPcapSnapLength = 65535;
+static const uint32_t IOFRPcapLinkTypeRaw = 101;
+static const uint32_t IOFRIpHeaderBytes = 20;
+static const uint32_t IOFRUdpHeaderBytes = 8;
+static const uint8_t IOFRIpTimeToLive = 64;
+static const uint8_t IOFRIpProtocolUdp = 17;
+static const uint64_t IOFRNanosecondsPerSecond = 1000000000;
+
+std::atomic<bool> IONetworkFlightRecorder::m_theDumpRequested(false);
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static void WriteBigEndian(uint8_t* location, uint32_t value, uint32_t bytes)
+{
+   while (bytes > 0)
+   {
+      bytes--;
+      *location++ = static_cast<uint8_t>(value >> (bytes * 8));
+   }
+}
+
+/******************************************************************************/
+static uint16_t IpHeaderChecksum(const uint8_t* header)
+{
+   uint32_t sum = 0;
+
+   for (uint32_t index = 0; index < IOFRIpHeaderBytes; index += 2)
+   {
+      sum += (static_cast<uint32_t>(header[index]) << 8) | header[index + 1];
+   }
+   while ((sum >> 16) != 0)
+   {
+      sum = (sum & 0xffff) + (sum >> 16);
+   }
+
+   return static_cast<uint16_t>(~sum);
+}
+
+/******************************************************************************/
+// IPv4 and UDP headers for record; the UDP checksum is left 0 (none).
+static void BuildPacketHeaders(const IO_FLIGHT_RECORD_TYPE& record, uint8_t* headers)
+{
+   uint32_t peerAddress = ntohl(record.peerAddress);
+   bool received = (record.direction == IOFR_DIRECTION_RECEIVED);
+   uint32_t sourceAddress = received ? peerAddress : INADDR_ANY;
+   uint32_t destinationAddress = received ? INADDR_ANY : peerAddress;
+   uint16_t sourcePort = received ? record.peerPort : record.localPort;
+   uint16_t destinationPort = received ? record.localPort : record.peerPort;
+   uint8_t* ip = headers;
+   uint8_t* udp = headers + IOFRIpHeaderBytes;
+
+   std::memset(headers, 0, IOFRIpHeaderBytes + IOFRUdpHeaderBytes);
+   ip[0] = 0x45;
+   WriteBigEndian(&ip[2], IOFRIpHeaderBytes + IOFRUdpHeaderBytes + record.len, 2);
+   ip[8] = IOFRIpTimeToLive;
+   ip[9] = IOFRIpProtocolUdp;
+   WriteBigEndian(&ip[12], sourceAddress, 4);
+   WriteBigEndian(&ip[16], destinationAddress, 4);
+   WriteBigEndian(&ip[10], IpHeaderChecksum(ip), 2);
+
+   WriteBigEndian(&udp[0], sourcePort, 2);
+   WriteBigEndian(&udp[2], destinationPort, 2);
+   WriteBigEndian(&udp[4], IOFRUdpHeaderBytes + record.len, 2);
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+IONetworkFlightRecorder::IONetworkFlightRecorder(uint32_t capacity)
+   :
+   m_Capacity(std::max<uint32_t>(capacity, 1)),
+   m_Records(new IO_FLIGHT_RECORD_TYPE[m_Capacity]),
+   m_NextSequence(0)
+{
+   for (uint32_t index = 0; index < m_Capacity; index++)
+   {
+      m_Records[index].beginSequence.store(0);
+      m_Records[index].endSequence.store(0);
+   }
+}
+
+/******************************************************************************/
+IONetworkFlightRecorder::~IONetworkFlightRecorder()
+{
+}
+
+/******************************************************************************/
+uint64_t IONetworkFlightRecorder::Recorded()
+{
+   return m_NextSequence.load(std::memory_order_acquire);
+}
+
+/******************************************************************************/
+void IONetworkFlightRecorder::Record(
+      IOFlightRecorderDirectionType direction,
+      const uint8_t* message,
+      int32_t len,
+      const struct sockaddr_in& peer,
+      uint16_t localPort,
+      uint64_t timeNs)
+{
+   if (len < 0)
+   {
+      return;
+   }
+
+   uint64_t sequence = m_NextSequence.fetch_add(1, std::memory_order_relaxed);
+   IO_FLIGHT_RECORD_TYPE& record = m_Records[sequence % m_Capacity];
+   uint16_t recordLen = static_cast<uint16_t>(
+         std::min<int32_t>(len, m_theIoNwControlMessageMaximumLengthBytes));
+
+   record.beginSequence.store(sequence + 1, std::memory_order_relaxed);
+   std::atomic_thread_fence(std::memory_order_release);
+
+   record.timeNs = timeNs;
+   record.peerAddress = peer.sin_addr.s_addr;
+   record.peerPort = ntohs(peer.sin_port);
+   record.localPort = localPort;
+   record.len = recordLen;
+   record.direction = static_cast<uint8_t>(direction);
+   std::memcpy(record.data, message, recordLen);
+
+   record.endSequence.store(sequence + 1, std::memory_order_release);
+}
+
+/******************************************************************************/
+bool IONetworkFlightRecorder::CopyRecord(uint64_t sequence, IO_FLIGHT_RECORD_TYPE& copy)
+{
+   IO_FLIGHT_RECORD_TYPE& record = m_Records[sequence % m_Capacity];
+   uint64_t endSequence = record.endSequence.load(std::memory_order_acquire);
+
+   copy.timeNs = record.timeNs;
+   copy.peerAddress = record.peerAddress;
+   copy.peerPort = record.peerPort;
+   copy.localPort = record.localPort;
+   copy.len = std::min<uint16_t>(record.len, m_theIoNwControlMessageMaximumLengthBytes);
+   copy.direction = record.direction;
+   std::memcpy(copy.data, record.data, copy.len);
+
+   std::atomic_thread_fence(std::memory_order_acquire);
+   uint64_t beginSequence = record.beginSequence.load(std::memory_order_relaxed);
+
+   return (endSequence == sequence + 1 && beginSequence == endSequence);
+}
+
+/******************************************************************************/
+bool IONetworkFlightRecorder::WritePcap(const std::string& path, uint32_t& datagrams)
+{
+   FILE* file = fopen(path.c_str(), "wb");
+
+   datagrams = 0;
+   if (file == nullptr)
+   {
+      return (false);
+   }
+
+   // pcap headers are in the writer's byte order; readers go by the magic.
+   uint32_t fileHeader[6] = {IOFRPcapMagicNanoseconds, 0, 0, 0, IOFRPcapSnapLength, IOFRPcapLinkTypeRaw};
+   uint16_t versions[2] = {IOFRPcapVersionMajor, IOFRPcapVersionMinor};
+   std::memcpy(&fileHeader[1], versions, sizeof(versions));
+   bool success = (fwrite(fileHeader, sizeof(fileHeader), 1, file) == 1);
+
+   uint64_t nextSequence = Recorded();
+   uint64_t firstSequence = (nextSequence > m_Capacity) ? nextSequence - m_Capacity : 0;
+   std::unique_ptr<IO_FLIGHT_RECORD_TYPE> copy(new IO_FLIGHT_RECORD_TYPE);
+   uint8_t headers[IOFRIpHeaderBytes + IOFRUdpHeaderBytes];
+
+   for (uint64_t sequence = firstSequence; success && sequence < nextSequence; sequence++)
+   {
+      if (!CopyRecord(sequence, *copy))
+      {
+         continue;
+      }
+
+      BuildPacketHeaders(*copy, headers);
+
+      uint32_t packetBytes = sizeof(headers) + copy->len;
+      uint32_t recordHeader[4] =
+      {
+         static_cast<uint32_t>(copy->timeNs / IOFRNanosecondsPerSecond),
+         static_cast<uint32_t>(copy->timeNs % IOFRNanosecondsPerSecond),
+         packetBytes,
+         packetBytes
+      };
+
+      success = (fwrite(recordHeader, sizeof(recordHeader), 1, file) == 1 &&
+            fwrite(headers, sizeof(headers), 1, file) == 1 &&
+            (copy->len == 0 || fwrite(copy->data, copy->len, 1, file) == 1));
+      if (success)
+      {
+         datagrams++;
+      }
+   }
+
+   success = (fclose(file) == 0) && success;
+
+   return (success);
+}
+
+/******************************************************************************/
+void IONetworkFlightRecorder::InstallSignalHandler()
+{
+   struct sigaction action;
+
+   std::memset(&action, 0, sizeof(action));
+   action.sa_handler = &IONetworkFlightRecorder::SignalHandler;
+   sigemptyset(&action.sa_mask);
+   action.sa_flags = SA_RESTART;
+   sigaction(SIGUSR1, &action, nullptr);
+}
+
+/******************************************************************************/
+void IONetworkFlightRecorder::SignalHandler(int)
+{
+   m_theDumpRequested.store(true);
+}
+
+/******************************************************************************/
+bool IONetworkFlightRecorder::TakeDumpRequest()
+{
+   return m_theDumpRequested.exchange(false);
+}
+
+/******************************************************************************/
@@ -0,0 +1,143 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkFlightRecorder.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the datagram flight recorder.
+   The UDP helper records every datagram it receives and sends, with its
+   time and peer address, into a ring of IOFRCapacity preallocated records;
+   the newest overwrite the oldest.  Recording takes a slot with one atomic
+   increment and copies the datagram into it, seqlock style as in
+   GLLogRing, so it never locks and never allocates.
+
+   WritePcap() writes the records still in the ring, oldest first, to a
+   pcap file (nanosecond timestamps, LINKTYPE_RAW) with an IPv4 and UDP
+   header made up for each datagram.  The server listens on all addresses
+   and does not learn which one a datagram came in on, so its side of each
+   packet shows as 0.0.0.0.  A record being overwritten while it is copied
+   is left out.
+
+   SIGUSR1 asks for a dump; the signal handler only sets a flag, which
+   TakeDumpRequest() reads from a normal thread.
+*/
+/******************************************************************************/
+#ifndef io_network_flight_recorder_h
+#define io_network_flight_recorder_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <atomic>
+#include <memory>
+#include <netinet/in.h>
+#include <string>
+
+#include "GLTypedefs.h"
+#include "IONetworkControlMessage.h"
+
+/******************************************************************************/
+/*                              T Y P E D E F S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef enum
+{
+   IOFR_DIRECTION_RECEIVED,
+   IOFR_DIRECTION_SENT
+} IOFlightRecorderDirectionType;
+
+}
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const bool IOFRRecorderEnabled = true;
+// Datagrams kept; about 1.5 MB of records.
+const uint32_t IOFRCapacity = 1024;
+static const std::string IOFRCaptureFilePath("ucrp_flight_recorder.pcap");
+// Also written when the UDP helper shuts down.
+const bool IOFRDumpAtShutdown = true;
+// The only source a DUMP_CAPTURE is taken from: the write blocks the
+// network thread, and the file is only of use on the server host.
+static const std::string IOFRDumpControllerAddress("127.0.0.1");
+
+}
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef struct io_flight_record_struct
+{
+   // Valid only when beginSequence == endSequence != 0; both hold the
+   // record sequence number + 1.
+   std::atomic<uint64_t> beginSequence;
+   uint64_t timeNs;              // CLOCK_REALTIME
+   uint32_t peerAddress;         // network byte order
+   uint16_t peerPort;
+   uint16_t localPort;
+   uint16_t len;
+   uint8_t direction;            // IOFlightRecorderDirectionType
+   uint8_t data[m_theIoNwControlMessageMaximumLengthBytes];
+   std::atomic<uint64_t> endSequence;
+} IO_FLIGHT_RECORD_TYPE;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class IONetworkFlightRecorder
+{
+   public:
+      IONetworkFlightRecorder(uint32_t capacity = IOFRCapacity);
+      ~IONetworkFlightRecorder();
+
+      // May be called from any thread; a datagram longer than the maximum
+      // message is cut to it.
+      void Record(
+            IOFlightRecorderDirectionType direction,
+            const uint8_t* message,
+            int32_t len,
+            const struct sockaddr_in& peer,
+            uint16_t localPort,
+            uint64_t timeNs);
+      bool WritePcap(const std::string& path, uint32_t& datagrams);
+      uint64_t Recorded();
+
+      static void InstallSignalHandler();
+      static bool TakeDumpRequest();
+
+   private:
+      bool CopyRecord(uint64_t sequence, IO_FLIGHT_RECORD_TYPE& copy);
+      static void SignalHandler(int signalNumber);
+
+      const uint32_t m_Capacity;
+      std::unique_ptr<IO_FLIGHT_RECORD_TYPE[]> m_Records;
+      std::atomic<uint64_t> m_NextSequence;
+
+      static std::atomic<bool> m_theDumpRequested;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* io_network_flight_recorder_h */
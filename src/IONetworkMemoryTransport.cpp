@@ -0,0 +1,231 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkMemoryTransport.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the in-memory network
+   transport.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <cstring>
+
+#include "IONetworkMemoryTransport.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+IONetworkMemoryTransport::IONetworkMemoryTransport()
+   :
+   m_Active(false),
+   m_SourcePort(SOCKUDP_NULL_PORT),
+   m_MessagesInjected(0),
+   m_MessagesSent(0),
+   m_MessagesDropped(0)
+{
+}
+
+/******************************************************************************/
+IONetworkMemoryTransport::~IONetworkMemoryTransport()
+{
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::Enqueue(
+      std::deque<IO_MEMORY_DATAGRAM_TYPE>& queue,
+      const uint8_t* message,
+      int32_t len,
+      const std::string& ipAddress,
+      int32_t port)
+{
+   if (len < 0 || len > static_cast<int32_t>(m_theIoNwControlMessageMaximumLengthBytes))
+   {
+      return (false);
+   }
+
+   bool dropped = false;
+   if (queue.size() >= IOMTMaximumQueuedMessages)
+   {
+      queue.pop_front();
+      dropped = true;
+   }
+
+   queue.emplace_back();
+   IO_MEMORY_DATAGRAM_TYPE& datagram = queue.back();
+   memcpy(datagram.data.data(), message, static_cast<size_t>(len));
+   datagram.len = len;
+   datagram.ipAddress = ipAddress;
+   datagram.port = port;
+
+   return (!dropped);
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::InjectMessage(
+      const uint8_t* message,
+      int32_t len,
+      const std::string& sourceIpAddress,
+      int32_t sourcePort)
+{
+   if (!m_Active)
+   {
+      return (false);
+   }
+
+   if (!Enqueue(m_ReceiveQueue, message, len, sourceIpAddress, sourcePort))
+   {
+      m_MessagesDropped++;
+   }
+   m_MessagesInjected++;
+
+   return (true);
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::TakeSentMessage(IO_MEMORY_DATAGRAM_TYPE& datagram)
+{
+   if (m_SentQueue.empty())
+   {
+      return (false);
+   }
+
+   datagram = m_SentQueue.front();
+   m_SentQueue.pop_front();
+
+   return (true);
+}
+
+/******************************************************************************/
+uint64_t IONetworkMemoryTransport::MessagesInjected()
+{
+   return m_MessagesInjected;
+}
+
+/******************************************************************************/
+uint64_t IONetworkMemoryTransport::MessagesSent()
+{
+   return m_MessagesSent;
+}
+
+/******************************************************************************/
+uint64_t IONetworkMemoryTransport::MessagesDropped()
+{
+   return m_MessagesDropped;
+}
+
+/******************************************************************************/
+/*          N E T W O R K  T R A N S P O R T  M E T H O D S                   */
+/******************************************************************************/
+bool IONetworkMemoryTransport::ActivateTransport()
+{
+   m_Active = true;
+
+   return (true);
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::ShutdownTransport()
+{
+   m_Active = false;
+
+   return (true);
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::Active()
+{
+   return m_Active;
+}
+
+/******************************************************************************/
+int32_t IONetworkMemoryTransport::ReceiveFd()
+{
+   return SOCKUDP_NULL_SOCKET_FD;
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::ReceiveMessage(
+      uint8_t* message,
+      int32_t& len,
+      std::string& sourceIpAddress)
+{
+   if (m_ReceiveQueue.empty())
+   {
+      len = SOCK_RECEIVE_FAILURE;
+      return (false);
+   }
+
+   IO_MEMORY_DATAGRAM_TYPE& datagram = m_ReceiveQueue.front();
+   memcpy(message, datagram.data.data(), static_cast<size_t>(datagram.len));
+   len = datagram.len;
+   m_SourceIpAddress = datagram.ipAddress;
+   m_SourcePort = datagram.port;
+   sourceIpAddress = m_SourceIpAddress;
+   m_ReceiveQueue.pop_front();
+
+   return (true);
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::SendMessageToTarget(
+      uint8_t* message,
+      int32_t len,
+      std::string targetIPAddress,
+      int32_t targetPort)
+{
+   if (!Enqueue(m_SentQueue, message, len, targetIPAddress, targetPort))
+   {
+      m_MessagesDropped++;
+   }
+   m_MessagesSent++;
+
+   return (true);
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::SendMessageToSource(
+      uint8_t* message,
+      int32_t len)
+{
+   return SendMessageToTarget(message, len, m_SourceIpAddress, m_SourcePort);
+}
+
+/******************************************************************************/
+std::string IONetworkMemoryTransport::SourceIp()
+{
+   return m_SourceIpAddress;
+}
+
+/******************************************************************************/
+int32_t IONetworkMemoryTransport::SourcePort()
+{
+   return m_SourcePort;
+}
+
+/******************************************************************************/
+uint64_t IONetworkMemoryTransport::LastReceiveTimeNs()
+{
+   // The receiver stamps simulated datagrams on its own clock.
+   return 0;
+}
+
+/******************************************************************************/
+bool IONetworkMemoryTransport::DumpCapture(const std::string&, uint32_t& datagrams)
+{
+   // The driver sees every datagram already.
+   datagrams = 0;
+   return (false);
+}
+
+/******************************************************************************/
@@ -0,0 +1,132 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkMemoryTransport.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the in-memory network transport.
+   A simulation driver injects command datagrams and takes the responses
+   back out; nothing touches a socket.  It is not polled: the driver calls
+   IONetworkControlInterfaceManager::ProcessReceivedMessages() after
+   injecting, on its own thread.
+*/
+/******************************************************************************/
+#ifndef io_network_memory_transport_h
+#define io_network_memory_transport_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "IONetworkControlMessage.h"
+#include "IONetworkTransport.h"
+#include "IONetworkUdpHelper.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+// Responses nobody takes are dropped, oldest first, past this depth so a
+// long soak run does not grow without bound.
+const uint32_t IOMTMaximumQueuedMessages = 1024;
+
+}
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef struct io_memory_datagram_struct
+{
+   std::array<uint8_t, m_theIoNwControlMessageMaximumLengthBytes> data;
+   int32_t len;
+   std::string ipAddress;
+   int32_t port;
+} IO_MEMORY_DATAGRAM_TYPE;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+class IONetworkMemoryTransport :
+   public IONetworkTransport
+{
+   public:
+      IONetworkMemoryTransport();
+      ~IONetworkMemoryTransport();
+
+      // D R I V E R  S I D E
+      bool InjectMessage(
+         const uint8_t* message,
+         int32_t len,
+         const std::string& sourceIpAddress,
+         int32_t sourcePort = SOCKUDP_NULL_PORT);
+      bool TakeSentMessage(IO_MEMORY_DATAGRAM_TYPE& datagram);
+      uint64_t MessagesInjected();
+      uint64_t MessagesSent();
+      uint64_t MessagesDropped();
+
+      // N E T W O R K  T R A N S P O R T
+      bool ActivateTransport() override;
+      bool ShutdownTransport() override;
+      bool Active() override;
+      int32_t ReceiveFd() override;
+      bool ReceiveMessage(
+         uint8_t* message,
+         int32_t& len,
+         std::string& sourceIpAddress) override;
+      bool SendMessageToTarget(
+         uint8_t* message,
+         int32_t len,
+         std::string targetIPAddress,
+         int32_t targetPort) override;
+      bool SendMessageToSource(
+         uint8_t* message,
+         int32_t len) override;
+      std::string SourceIp() override;
+      int32_t SourcePort() override;
+      uint64_t LastReceiveTimeNs() override;
+      bool DumpCapture(const std::string& path, uint32_t& datagrams) override;
+
+   private:
+      static bool Enqueue(
+         std::deque<IO_MEMORY_DATAGRAM_TYPE>& queue,
+         const uint8_t* message,
+         int32_t len,
+         const std::string& ipAddress,
+         int32_t port);
+
+      bool m_Active;
+      std::deque<IO_MEMORY_DATAGRAM_TYPE> m_ReceiveQueue;
+      std::deque<IO_MEMORY_DATAGRAM_TYPE> m_SentQueue;
+      std::string m_SourceIpAddress;
+      int32_t m_SourcePort;
+      uint64_t m_MessagesInjected;
+      uint64_t m_MessagesSent;
+      uint64_t m_MessagesDropped;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* io_network_memory_transport_h */
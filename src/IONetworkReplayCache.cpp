@@ -0,0 +1,201 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkReplayCache.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the request sequence window
+   and the response replay cache.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include "IONetworkReplayCache.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+IONetworkReplayCache::IONetworkReplayCache()
+   :
+   m_Requests(0)
+{
+}
+
+/******************************************************************************/
+IONetworkReplayCache::~IONetworkReplayCache()
+{
+}
+
+/******************************************************************************/
+uint32_t IONetworkReplayCache::Clients()
+{
+   return static_cast<uint32_t>(m_Clients.size());
+}
+
+/******************************************************************************/
+IONetworkSequenceCheckType IONetworkReplayCache::CheckSequence(
+      const std::string& client,
+      uint16_t sequence,
+      uint64_t nowNs)
+{
+   IO_REPLAY_CLIENT_TYPE& state = Client(client);
+   bool idle = (state.window.none() || nowNs - state.lastHeardNs > IONRCClientIdleNs);
+
+   state.lastHeardNs = nowNs;
+
+   if (idle)
+   {
+      state.newestSequence = sequence;
+      state.window.reset();
+      state.window.set(0);
+      for (IO_REPLAY_RESPONSE_TYPE& response : state.responses)
+      {
+         response.valid = false;
+         response.uncacheable = false;
+      }
+      return (IONRC_SEQUENCE_NEW);
+   }
+
+   int16_t ahead = static_cast<int16_t>(sequence - state.newestSequence);
+
+   if (ahead > 0)
+   {
+      state.window <<= ahead;
+      state.window.set(0);
+      state.newestSequence = sequence;
+      return (IONRC_SEQUENCE_NEW);
+   }
+
+   uint16_t behind = static_cast<uint16_t>(-ahead);
+   if (behind >= IONRCWindowSize)
+   {
+      return (IONRC_SEQUENCE_TOO_OLD);
+   }
+
+   if (state.window.test(behind))
+   {
+      return (IONRC_SEQUENCE_DUPLICATE);
+   }
+
+   state.window.set(behind);
+
+   return (IONRC_SEQUENCE_NEW);
+}
+
+/******************************************************************************/
+void IONetworkReplayCache::RecordResponse(
+      const std::string& client,
+      uint16_t sequence,
+      const uint8_t* message,
+      int32_t len,
+      int32_t port)
+{
+   IO_REPLAY_CLIENT_TYPE& state = Client(client);
+   uint32_t last = (state.nextResponse + IONRCCachedResponses - 1) % IONRCCachedResponses;
+   IO_REPLAY_RESPONSE_TYPE* response = &state.responses[last];
+
+   // The next datagram of the last response, or a new response.
+   if (response->sequence != sequence || !(response->valid || response->uncacheable))
+   {
+      response = &state.responses[state.nextResponse];
+      state.nextResponse = (state.nextResponse + 1) % IONRCCachedResponses;
+
+      // clear() keeps the capacity; the slots stop allocating once warm.
+      response->sequence = sequence;
+      response->valid = true;
+      response->uncacheable = false;
+      response->bytes.clear();
+      response->datagrams.clear();
+   }
+
+   if (response->uncacheable)
+   {
+      return;
+   }
+
+   // Too long to keep: a duplicate of it then goes unanswered rather than
+   // answered in part.  The slot stays with the sequence so the rest of its
+   // datagrams are dropped here instead of evicting other responses.
+   if (response->bytes.size() + len > IONRCMaximumCachedBytes)
+   {
+      response->valid = false;
+      response->uncacheable = true;
+      response->bytes.clear();
+      response->datagrams.clear();
+      return;
+   }
+
+   IO_REPLAY_DATAGRAM_TYPE datagram;
+   datagram.len = static_cast<uint16_t>(len);
+   datagram.port = port;
+
+   response->bytes.insert(response->bytes.end(), message, message + len);
+   response->datagrams.push_back(datagram);
+}
+
+/******************************************************************************/
+bool IONetworkReplayCache::ReplayResponse(
+      const std::string& client,
+      uint16_t sequence,
+      const SendFunction& send)
+{
+   IO_REPLAY_CLIENT_TYPE& state = Client(client);
+
+   for (IO_REPLAY_RESPONSE_TYPE& response : state.responses)
+   {
+      if (response.valid && response.sequence == sequence)
+      {
+         uint8_t* message = response.bytes.data();
+         bool success = true;
+
+         for (const IO_REPLAY_DATAGRAM_TYPE& datagram : response.datagrams)
+         {
+            success = send(message, datagram.len, datagram.port) && success;
+            message += datagram.len;
+         }
+
+         return (success);
+      }
+   }
+
+   return (false);
+}
+
+/******************************************************************************/
+IO_REPLAY_CLIENT_TYPE& IONetworkReplayCache::Client(const std::string& client)
+{
+   auto it = m_Clients.find(client);
+
+   if (it == m_Clients.end())
+   {
+      if (m_Clients.size() >= IONRCMaximumClients)
+      {
+         auto oldest = m_Clients.begin();
+         for (auto candidate = m_Clients.begin(); candidate != m_Clients.end(); candidate++)
+         {
+            if (candidate->second.lastHeard < oldest->second.lastHeard)
+            {
+               oldest = candidate;
+            }
+         }
+         m_Clients.erase(oldest);
+      }
+
+      it = m_Clients.emplace(client, IO_REPLAY_CLIENT_TYPE()).first;
+   }
+
+   it->second.lastHeard = ++m_Requests;
+
+   return it->second;
+}
+
+/******************************************************************************/
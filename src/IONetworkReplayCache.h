@@ -0,0 +1,146 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkReplayCache.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the request sequence window and
+   the response replay cache.  A client that numbers its requests, in
+   headerReserved1 or in the compact header, gets each request run at most
+   once: a retransmitted request is answered from the cache of the last
+   responses sent to that client instead of running the handler again.
+   Sequence number 0 means the client does not number its requests.
+
+   As in the IPsec anti-replay window the newest sequence seen and a bitmap
+   of the IONRCWindowSize sequences before it tell a new request from a
+   duplicate; a request older than the window cannot be told apart and is
+   dropped.  Sequence numbers compare in 16 bit serial arithmetic.
+*/
+/******************************************************************************/
+#ifndef io_network_replay_cache_h
+#define io_network_replay_cache_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <bitset>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+// Sequences remembered behind the newest one, one bit each. A pipelining
+// client keeps numbering new requests while it waits to retransmit a lost
+// one; a duplicate older than the cached responses is still recognized
+// here and dropped rather than run twice.
+const uint16_t IONRCWindowSize = 4096;
+// Responses kept per client, and the most bytes one response may take.  A
+// client keeping more requests in flight than this (IONCLMaximumWindow)
+// could see a lost response evicted before its retransmit arrives.
+const uint32_t IONRCCachedResponses = 64;
+const uint32_t IONRCMaximumCachedBytes = 8192;
+// Clients tracked; the one heard from least recently makes room.
+const uint32_t IONRCMaximumClients = 64;
+// A client quiet this long starts a new window, it has likely restarted.
+const uint64_t IONRCClientIdleNs = 10000000000ULL;
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+typedef enum
+{
+   IONRC_SEQUENCE_NEW,
+   IONRC_SEQUENCE_DUPLICATE,
+   IONRC_SEQUENCE_TOO_OLD
+} IONetworkSequenceCheckType;
+
+typedef struct replay_datagram_struct
+{
+   uint16_t len = 0;
+   int32_t port = 0;
+} IO_REPLAY_DATAGRAM_TYPE;
+
+// The datagrams sent in answer to one request, back to back in bytes.
+typedef struct replay_response_struct
+{
+   uint16_t sequence = 0;
+   bool valid = false;
+   bool uncacheable = false;          // too long; its datagrams are ignored
+   std::vector<uint8_t> bytes;
+   std::vector<IO_REPLAY_DATAGRAM_TYPE> datagrams;
+} IO_REPLAY_RESPONSE_TYPE;
+
+typedef struct replay_client_struct
+{
+   uint16_t newestSequence = 0;
+   std::bitset<IONRCWindowSize> window;   // bit n: newestSequence - n seen
+   uint64_t lastHeardNs = 0;
+   uint64_t lastHeard = 0;        // request count when last heard from
+   std::array<IO_REPLAY_RESPONSE_TYPE, IONRCCachedResponses> responses;
+   uint32_t nextResponse = 0;
+} IO_REPLAY_CLIENT_TYPE;
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+class IONetworkReplayCache
+{
+   public:
+      // Sends one cached datagram to the client at port.
+      using SendFunction = std::function<bool(uint8_t* message, int32_t len, int32_t port)>;
+
+      IONetworkReplayCache();
+      ~IONetworkReplayCache();
+
+      // Marks sequence seen for client.  nowNs ages out quiet clients.
+      IONetworkSequenceCheckType CheckSequence(
+            const std::string& client,
+            uint16_t sequence,
+            uint64_t nowNs);
+
+      // Keeps a datagram sent to port in answer to the client's sequence;
+      // a response is one or more datagrams.
+      void RecordResponse(
+            const std::string& client,
+            uint16_t sequence,
+            const uint8_t* message,
+            int32_t len,
+            int32_t port);
+
+      // Sends again the response cached for the client's sequence.  False
+      // when there is none, the request then goes unanswered.
+      bool ReplayResponse(
+            const std::string& client,
+            uint16_t sequence,
+            const SendFunction& send);
+
+      uint32_t Clients();
+
+   private:
+      IO_REPLAY_CLIENT_TYPE& Client(const std::string& client);
+
+      std::map<std::string, IO_REPLAY_CLIENT_TYPE> m_Clients;
+      uint64_t m_Requests;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* io_network_replay_cache_h */
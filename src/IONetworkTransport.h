@@ -0,0 +1,80 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkTransport.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the transport the network control interface manager
+   sends and receives datagrams through.  IONetworkUdpHelper is the socket
+   implementation; IONetworkMemoryTransport keeps datagrams in memory for
+   simulated runs.
+*/
+/******************************************************************************/
+#ifndef io_network_transport_h
+#define io_network_transport_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+class IONetworkTransport
+{
+   public:
+      virtual bool ActivateTransport() = 0;
+      virtual bool ShutdownTransport() = 0;
+      virtual bool Active() = 0;
+
+      // Descriptor to poll() for received datagrams, or -1 when the
+      // transport cannot be polled and its owner drives the receive side.
+      virtual int32_t ReceiveFd() = 0;
+
+      // message has room for m_theIoNwControlMessageMaximumLengthBytes + 1.
+      virtual bool ReceiveMessage(
+         uint8_t* message,
+         int32_t& len,
+         std::string& sourceIpAddress) = 0;
+      virtual bool SendMessageToTarget(
+         uint8_t* message,
+         int32_t len,
+         std::string targetIPAddress,
+         int32_t targetPort) = 0;
+      // Replies to the address and port the last datagram came from.
+      virtual bool SendMessageToSource(
+         uint8_t* message,
+         int32_t len) = 0;
+      virtual std::string SourceIp() = 0;
+      virtual int32_t SourcePort() = 0;
+
+      // CLOCK_REALTIME time the kernel stamped the last received datagram
+      // with, 0 when the transport has no such stamp.
+      virtual uint64_t LastReceiveTimeNs() = 0;
+
+      // Writes the datagrams the transport has recorded lately to a pcap
+      // file; false when it records none.
+      virtual bool DumpCapture(const std::string& path, uint32_t& datagrams) = 0;
+
+      virtual ~IONetworkTransport() {};
+};
+
+using IONetworkTransportPtr = std::unique_ptr<IONetworkTransport>;
+
+}
+
+/******************************************************************************/
+
+#endif /* io_network_transport_h */
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <sys/socket.h>
 #include <array>
+#include <time.h>
 
 #include "GLConfigureSystemModules.h"
 #include "GLResourceMain.h"
@@ -40,6 +41,19 @@ using namespace MDN;
 const int IONetworkUdpHelper::m_theSocketInvalidValue = -1;
 const int IONetworkUdpHelper::m_thePortInvalidValue = -1;
 
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static uint64_t RealtimeNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_REALTIME, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * 1000000000ULL +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
 /******************************************************************************/
 /*       I M P L E M E N T A T I O N                                          */
 /******************************************************************************/
@@ -53,9 +67,12 @@ IONetworkUdpHelper::IONetworkUdpHelper(
    m_Sockfd(m_theSocketInvalidValue),
    m_errno(NO_ERROR),
    m_UdpMaxMsgLenBytes((size_t)maxMessageLenBytes),
-   m_PortNumber(port)
+   m_PortNumber(port),
+   m_ReceiveTimeNs(0),
+   m_KernelReceiveTimestamps(false)
 {
    m_SourceIpAddress.clear();
+   memset(&m_SourceAddr, 0, sizeof(m_SourceAddr));
 }
 
 /******************************************************************************/
@@ -97,6 +114,10 @@ bool IONetworkUdpHelper::ActivateUdpHelper()
    success = CreatePermanentUdpServerSocket();
    if(success)
    {
+      if (IOFRRecorderEnabled)
+      {
+         IONetworkFlightRecorder::InstallSignalHandler();
+      }
       m_State = IOUDPH_STATE_ACTIVE_WITH_PERMANENT_SOCKET;
       Parent().EventUdpHelperActive();
    };
@@ -113,12 +134,111 @@ std::string IONetworkUdpHelper::SourceIp()
 /******************************************************************************/
 bool IONetworkUdpHelper::ShutdownUdpHelper()
 {
+   if (IOFRRecorderEnabled && IOFRDumpAtShutdown && Active())
+   {
+      uint32_t datagrams = 0;
+      DumpCapture(IOFRCaptureFilePath, datagrams);
+   }
+
    m_State = IOUDPH_STATE_INACTIVE;
    Parent().EventUdpHelperInactive();
 
    return (true);
 }
 
+/******************************************************************************/
+bool IONetworkUdpHelper::ActivateTransport()
+{
+   return ActivateUdpHelper();
+}
+
+/******************************************************************************/
+bool IONetworkUdpHelper::ShutdownTransport()
+{
+   return ShutdownUdpHelper();
+}
+
+/******************************************************************************/
+int32_t IONetworkUdpHelper::ReceiveFd()
+{
+   return m_Sockfd;
+}
+
+/******************************************************************************/
+bool IONetworkUdpHelper::SendMessageToTarget(
+        uint8_t* message,
+        int32_t len,
+        std::string targetIPAddress,
+        int32_t targetPort)
+{
+   return SendMessageWithTempUnconnectedSocket(message, len, targetIPAddress, targetPort);
+}
+
+/******************************************************************************/
+bool IONetworkUdpHelper::SendMessageToSource(
+        uint8_t* message,
+        int32_t len)
+{
+   // Sent from the server port on the permanent socket, no socket set up.
+   bool success = false;
+   m_errno = NO_ERROR;
+
+   if (m_Sockfd != m_theSocketInvalidValue && m_SourceAddr.sin_family == AF_INET)
+   {
+      success = (sendto(
+         m_Sockfd,
+         message,
+         len,
+         0,
+         (struct sockaddr*)&m_SourceAddr,
+         sizeof(m_SourceAddr)) != SOCK_SEND_FAIL);
+
+      if (success)
+      {
+         RecordSent(message, len, m_SourceAddr, m_PortNumber);
+      }
+      else
+      {
+         m_errno = errno;
+      }
+   }
+
+   return(success);
+}
+
+/******************************************************************************/
+int32_t IONetworkUdpHelper::SourcePort()
+{
+   return ntohs(m_SourceAddr.sin_port);
+}
+
+/******************************************************************************/
+uint64_t IONetworkUdpHelper::LastReceiveTimeNs()
+{
+   return m_ReceiveTimeNs;
+}
+
+/******************************************************************************/
+bool IONetworkUdpHelper::DumpCapture(const std::string& path, uint32_t& datagrams)
+{
+   datagrams = 0;
+   return IOFRRecorderEnabled && m_FlightRecorder.WritePcap(path, datagrams);
+}
+
+/******************************************************************************/
+void IONetworkUdpHelper::RecordSent(
+        uint8_t* message,
+        int32_t len,
+        const SOCKUDP_SOCKET_ADDR& targetAddr,
+        uint16_t localPort)
+{
+   if (IOFRRecorderEnabled)
+   {
+      m_FlightRecorder.Record(
+         IOFR_DIRECTION_SENT, message, len, targetAddr, localPort, RealtimeNs());
+   }
+}
+
 /******************************************************************************/
 bool IONetworkUdpHelper::CreatePermanentUdpServerSocket()
 {
@@ -140,6 +260,11 @@ bool IONetworkUdpHelper::CreatePermanentUdpServerSocket()
       bindresult = BindSocket(&m_Sockfd, &m_SockAddr);
       if (bindresult)
       {
+         // Receive times stamped by the kernel leave the server's own
+         // scheduling delay out of round trip measurements.
+         int enable = 1;
+         m_KernelReceiveTimestamps = (setsockopt(
+            m_Sockfd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) == 0);
          success = true;
       }
       else
@@ -185,33 +310,65 @@ bool IONetworkUdpHelper::ReceiveMessage(
         std::string& sourceIpAddress)
 {
    bool success;
-   sockaddr src_addr;
-   socklen_t src_addr_len = sizeof(struct sockaddr);
+   SOCKUDP_SOCKET_ADDR src_addr;
    char ip[INET6_ADDRSTRLEN] = {0};
+   char control[CMSG_SPACE(sizeof(struct timespec))];
+   // The caller's buffer holds one byte more than the maximum message, so
+   // a longer datagram shows up as too long rather than cut to size.
+   struct iovec iov = {message, m_UdpMaxMsgLenBytes + 1};
+   struct msghdr msg;
 
    success = FALSE;
 
    if (m_Sockfd != m_theSocketInvalidValue)
    {
-      len = static_cast<int32_t>(recvfrom(
-         m_Sockfd,
-         message,
-         MDN::m_theIoNwControlMessageFixedLengthBytes,
-         0,
-         &src_addr,
-         &src_addr_len));
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_name = &src_addr;
+      msg.msg_namelen = sizeof(src_addr);
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+
+      len = static_cast<int32_t>(recvmsg(m_Sockfd, &msg, 0));
 
       if (len != SOCK_RECEIVE_FAILURE)
       {
          success = TRUE;
 
-         if (src_addr.sa_family == AF_INET)
+         m_ReceiveTimeNs = 0;
+         for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+               cmsg != nullptr;
+               cmsg = CMSG_NXTHDR(&msg, cmsg))
+         {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+            {
+               struct timespec stamp;
+               memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+               m_ReceiveTimeNs =
+                  static_cast<uint64_t>(stamp.tv_sec) * 1000000000ULL +
+                  static_cast<uint64_t>(stamp.tv_nsec);
+            }
+         }
+
+         if (src_addr.sin_family == AF_INET)
          {
             // get the ip address of the source of this message
-            sockaddr_in *src_addr_in = reinterpret_cast<sockaddr_in*>(&src_addr);
+            m_SourceAddr = src_addr;
             m_SourceIpAddress = std::string(
-                  inet_ntop(AF_INET, &src_addr_in->sin_addr, ip, INET6_ADDRSTRLEN));
+                  inet_ntop(AF_INET, &src_addr.sin_addr, ip, INET6_ADDRSTRLEN));
             sourceIpAddress = m_SourceIpAddress;
+
+            if (IOFRRecorderEnabled)
+            {
+               m_FlightRecorder.Record(
+                  IOFR_DIRECTION_RECEIVED,
+                  message,
+                  len,
+                  src_addr,
+                  m_PortNumber,
+                  (m_ReceiveTimeNs != 0) ? m_ReceiveTimeNs : RealtimeNs());
+            }
          }
       }
       else
@@ -259,6 +416,11 @@ bool IONetworkUdpHelper::SendMessageWithTempUnconnectedSocket(
          if (sendresult != SOCK_SEND_FAIL)
          {
             success = TRUE;
+
+            // The temporary socket's port was picked by the kernel.
+            socklen_t addrLen = sizeof(tempTxSockAddr);
+            getsockname(tempTxSockFd, (struct sockaddr*)&tempTxSockAddr, &addrLen);
+            RecordSent(message, len, targetAddr, ntohs(tempTxSockAddr.sin_port));
          }
          else
          {
@@ -334,6 +496,7 @@ bool IONetworkUdpHelper::SendUDPMessage(
    if (sendresult != SOCK_SEND_FAIL)
    {
       success = TRUE;
+      RecordSent(message, len, targetAddr, m_PortNumber);
    }
    else
    {
@@ -29,13 +29,17 @@
 #include <map>
 #include <netinet/in.h>
 
+#include "IONetworkControlMessage.h"
+#include "IONetworkFlightRecorder.h"
+#include "IONetworkTransport.h"
+
 /******************************************************************************/
 /*                           D E F I N E S                                    */
 /******************************************************************************/
 namespace MDN
 {
 static const std::string SOCKUDP_TXTEST_LOOPBACK_IP_ADDRESS("127.0.0.1");
-static const uint32_t the_IONW_UDP_API_MAX_MESSAGE_LEN = 64;
+static const uint32_t the_IONW_UDP_API_MAX_MESSAGE_LEN = m_theIoNwControlMessageMaximumLengthBytes;
 static const int NO_ERROR = 0;
 static const bool SOCKUDP_NEW_PERMANENT_SOCKET = true;
 static const bool SOCKUDP_NEW_TEMP_SOCKET = false;
@@ -79,7 +83,8 @@ namespace MDN
 
 class IONetworkUdpHelperIntf;
 
-class IONetworkUdpHelper
+class IONetworkUdpHelper :
+   public IONetworkTransport
 {
    public:
       IONetworkUdpHelper(
@@ -92,7 +97,7 @@ class IONetworkUdpHelper
       bool ReceiveMessage(
          uint8_t* message,
          int32_t& len,
-         std::string& sourceIpAddress);
+         std::string& sourceIpAddress) override;
       bool SendResponseMessageToSource(
          uint8_t* message,
          int32_t len);
@@ -108,8 +113,24 @@ class IONetworkUdpHelper
          int32_t targetPort);
       bool ShutdownUdpHelper();
       bool ActivateUdpHelper();
-      bool Active();
-      std::string SourceIp();
+      bool Active() override;
+      std::string SourceIp() override;
+
+      // N E T W O R K  T R A N S P O R T
+      bool ActivateTransport() override;
+      bool ShutdownTransport() override;
+      int32_t ReceiveFd() override;
+      bool SendMessageToTarget(
+         uint8_t* message,
+         int32_t len,
+         std::string targetIPAddress,
+         int32_t targetPort) override;
+      bool SendMessageToSource(
+         uint8_t* message,
+         int32_t len) override;
+      int32_t SourcePort() override;
+      uint64_t LastReceiveTimeNs() override;
+      bool DumpCapture(const std::string& path, uint32_t& datagrams) override;
 
    private:
       bool CloseSocket(SOCKUDP_SOCKET_FD extSocketfd);
@@ -128,6 +149,11 @@ class IONetworkUdpHelper
          int32_t port);
       IONetworkUdpHelperState State();
       IONetworkUdpHelperIntf& Parent();
+      void RecordSent(
+         uint8_t* message,
+         int32_t len,
+         const SOCKUDP_SOCKET_ADDR& targetAddr,
+         uint16_t localPort);
 
       IONetworkUdpHelperState m_State;
       SOCKUDP_SOCKET_FD m_Sockfd;
@@ -135,8 +161,12 @@ class IONetworkUdpHelper
       IONetworkUdpHelperIntf& m_Parent;
       int m_errno;
       std::string m_SourceIpAddress;
+      SOCKUDP_SOCKET_ADDR m_SourceAddr;
       uint32_t m_UdpMaxMsgLenBytes;
       const int32_t m_PortNumber;
+      uint64_t m_ReceiveTimeNs;
+      bool m_KernelReceiveTimestamps;
+      IONetworkFlightRecorder m_FlightRecorder;
 
       // C L A S S  C O N S T A N T S
       static const int m_theSocketInvalidValue;
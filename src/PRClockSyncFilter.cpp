@@ -0,0 +1,148 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file PRClockSyncFilter.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the CLOCK_SYNC sample filter.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include "PRClockSyncFilter.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+PRClockSyncFilter::PRClockSyncFilter()
+   :
+   m_Exchanges(0)
+{
+}
+
+/******************************************************************************/
+PRClockSyncFilter::~PRClockSyncFilter()
+{
+}
+
+/******************************************************************************/
+uint32_t PRClockSyncFilter::Clients()
+{
+   return static_cast<uint32_t>(m_Clients.size());
+}
+
+/******************************************************************************/
+bool PRClockSyncFilter::FilterExchange(
+      const std::string& client,
+      uint16_t sequence,
+      uint32_t previousRoundTripNs,
+      uint64_t nowNs,
+      PR_CLOCK_SYNC_SAMPLE_TYPE& best,
+      uint32_t& samples)
+{
+   PR_CLOCK_SYNC_CLIENT_TYPE& state = Client(client);
+
+   // A lost request or response leaves a gap in the sequence; the round
+   // trip reported then belongs to an exchange this side never finished.
+   if (state.exchangePending &&
+      previousRoundTripNs != 0 &&
+      static_cast<uint16_t>(state.sequence + 1) == sequence)
+   {
+      uint64_t clientRxNs = state.clientTxNs + previousRoundTripNs;   // t4
+      int64_t outboundNs = static_cast<int64_t>(state.serverRxNs - state.clientTxNs);
+      int64_t inboundNs = static_cast<int64_t>(state.serverTxNs - clientRxNs);
+      int64_t serverNs = static_cast<int64_t>(state.serverTxNs - state.serverRxNs);
+
+      PR_CLOCK_SYNC_SAMPLE_TYPE& sample = state.samples[state.nextSample];
+      sample.offsetNs = (outboundNs + inboundNs) / 2;
+      sample.delayNs = (static_cast<int64_t>(previousRoundTripNs) > serverNs) ?
+            static_cast<uint64_t>(previousRoundTripNs - serverNs) : 0;
+      sample.serverTimeNs = state.serverTxNs;
+
+      state.nextSample = (state.nextSample + 1) % PRCSFilterSamples;
+      if (state.sampleCount < PRCSFilterSamples)
+      {
+         state.sampleCount++;
+      }
+   }
+   state.exchangePending = false;
+
+   bool found = false;
+   samples = 0;
+
+   for (uint32_t index = 0; index < state.sampleCount; index++)
+   {
+      const PR_CLOCK_SYNC_SAMPLE_TYPE& sample = state.samples[index];
+
+      if (nowNs > sample.serverTimeNs &&
+         nowNs - sample.serverTimeNs > PRCSSampleMaximumAgeNs)
+      {
+         continue;
+      }
+
+      if (!found || sample.delayNs < best.delayNs)
+      {
+         best = sample;
+         found = true;
+      }
+      samples++;
+   }
+
+   return (found);
+}
+
+/******************************************************************************/
+void PRClockSyncFilter::RecordExchange(
+      const std::string& client,
+      uint16_t sequence,
+      uint64_t clientTxNs,
+      uint64_t serverRxNs,
+      uint64_t serverTxNs)
+{
+   PR_CLOCK_SYNC_CLIENT_TYPE& state = Client(client);
+
+   state.sequence = sequence;
+   state.clientTxNs = clientTxNs;
+   state.serverRxNs = serverRxNs;
+   state.serverTxNs = serverTxNs;
+   state.exchangePending = true;
+}
+
+/******************************************************************************/
+PR_CLOCK_SYNC_CLIENT_TYPE& PRClockSyncFilter::Client(const std::string& client)
+{
+   auto it = m_Clients.find(client);
+
+   if (it == m_Clients.end())
+   {
+      if (m_Clients.size() >= PRCSMaximumClients)
+      {
+         auto oldest = m_Clients.begin();
+         for (auto candidate = m_Clients.begin(); candidate != m_Clients.end(); candidate++)
+         {
+            if (candidate->second.lastHeard < oldest->second.lastHeard)
+            {
+               oldest = candidate;
+            }
+         }
+         m_Clients.erase(oldest);
+      }
+
+      it = m_Clients.emplace(client, PR_CLOCK_SYNC_CLIENT_TYPE()).first;
+   }
+
+   it->second.lastHeard = ++m_Exchanges;
+
+   return it->second;
+}
+
+/******************************************************************************/
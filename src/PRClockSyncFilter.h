@@ -0,0 +1,112 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file PRClockSyncFilter.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the CLOCK_SYNC sample filter.  It
+   keeps the last exchange of each client so the round trip the client
+   reports with its next request completes the four timestamps t1..t4, and
+   it keeps the offset and delay of the last exchanges.  As in the NTP clock
+   filter the sample with the smallest delay is the best one: queuing only
+   ever adds delay, and the less delay the less room for an asymmetric path
+   to bias the offset.
+*/
+/******************************************************************************/
+#ifndef pr_clock_sync_filter_h
+#define pr_clock_sync_filter_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <map>
+#include <string>
+
+#include "GLTypedefs.h"
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+// Exchanges kept per client, and how long a sample stays a candidate.
+const uint32_t PRCSFilterSamples = 8;
+const uint64_t PRCSSampleMaximumAgeNs = 64000000000ULL;
+// Clients tracked; the one heard from least recently makes room.
+const uint32_t PRCSMaximumClients = 64;
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+typedef struct clock_sync_sample_struct
+{
+   int64_t offsetNs = 0;       // server minus client
+   uint64_t delayNs = 0;       // round trip less the time in the server
+   uint64_t serverTimeNs = 0;  // t3, ages the sample
+} PR_CLOCK_SYNC_SAMPLE_TYPE;
+
+typedef struct clock_sync_client_struct
+{
+   uint16_t sequence = 0;
+   bool exchangePending = false;
+   uint64_t clientTxNs = 0;    // t1
+   uint64_t serverRxNs = 0;    // t2
+   uint64_t serverTxNs = 0;    // t3
+   std::array<PR_CLOCK_SYNC_SAMPLE_TYPE, PRCSFilterSamples> samples;
+   uint32_t sampleCount = 0;
+   uint32_t nextSample = 0;
+   uint64_t lastHeard = 0;     // exchange count when last heard from
+} PR_CLOCK_SYNC_CLIENT_TYPE;
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+class PRClockSyncFilter
+{
+   public:
+      PRClockSyncFilter();
+      ~PRClockSyncFilter();
+
+      // Completes the client's previous exchange when sequence follows it
+      // and previousRoundTripNs is set, then picks the best recent sample.
+      // Returns false while the client has no sample younger than
+      // PRCSSampleMaximumAgeNs.
+      bool FilterExchange(
+            const std::string& client,
+            uint16_t sequence,
+            uint32_t previousRoundTripNs,
+            uint64_t nowNs,
+            PR_CLOCK_SYNC_SAMPLE_TYPE& best,
+            uint32_t& samples);
+
+      // Keeps t1..t3 of the exchange just answered for the next request.
+      void RecordExchange(
+            const std::string& client,
+            uint16_t sequence,
+            uint64_t clientTxNs,
+            uint64_t serverRxNs,
+            uint64_t serverTxNs);
+
+      uint32_t Clients();
+
+   private:
+      PR_CLOCK_SYNC_CLIENT_TYPE& Client(const std::string& client);
+
+      std::map<std::string, PR_CLOCK_SYNC_CLIENT_TYPE> m_Clients;
+      uint64_t m_Exchanges;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* pr_clock_sync_filter_h */
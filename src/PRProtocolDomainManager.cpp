@@ -18,14 +18,23 @@
 /******************************************************************************/
 /*       I N C L U D E S                                                      */
 /******************************************************************************/
+#include <algorithm>
 #include <iostream>
+#include <stdio.h>
+#include <sys/utsname.h>
 
 #include "GLErrorLog.h"
 #include "GLEventLog.h"
 #include "GLResourceMain.h"
+#include "GLTelemetrySampler.h"
+#include "PRTelemetrySubscriptions.h"
+#include "GLTimeHelper.h"
 #include "IONetworkControlMessage.h"
 #include "IONetworkControlMessages.h"
+#include "IONetworkControlPayloads.h"
 #include "IONetworkControlInterfaceManager.h"
+#include "IONetworkFlightRecorder.h"
+#include "IONetworkReplayCache.h"
 #include "PRProtocolDomainManager.h"
 
 using namespace MDN;
@@ -37,6 +46,37 @@ using namespace MDN;
 /******************************************************************************/
 /*                        C O N S T A N T S                                   */
 /******************************************************************************/
+static const uint64_t PRDMNanosecondsPerMs = 1000000;
+
+// A history reply, segment headers included, has to fit the replay cache.
+static_assert(2 * IONW_HISTORY_MAXIMUM_DATA_BYTES <= IONRCMaximumCachedBytes,
+      "GET_TELEMETRY_HISTORY_RSP longer than the replay cache keeps");
+
+// Row spacing of each GLTLHResolutionType, as GET_TELEMETRY_HISTORY_RSP
+// reports it.
+static const uint32_t PRDMHistoryPeriodMs[GLTLH_RESOLUTIONS] =
+{
+   GLTLSSampleIntervalMs,
+   static_cast<uint32_t>(GLTLHSecondNs / PRDMNanosecondsPerMs),
+   static_cast<uint32_t>(GLTLHMinuteNs / PRDMNanosecondsPerMs),
+};
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static IONetworkControlStatus HandlerStatus(bool success)
+{
+   return success ? IONW_STATUS_SUCCESS : IONW_STATUS_FAILED;
+}
+
+// Commands that would end the session or nest; a BATCH answers them with
+// IONW_STATUS_NOT_ALLOWED.
+static bool AllowedInBatch(uint16_t msgId)
+{
+   return (msgId != IONW_CONTROL_MSG_BATCH &&
+      msgId != IONW_CONTROL_MSG_REQUEST_APP_SHUTDOWN &&
+      msgId != IONW_CONTROL_MSG_SHUTDOWN_INTERFACE);
+}
 
 
 /******************************************************************************/
@@ -47,7 +87,9 @@ PRProtocolDomainManager::PRProtocolDomainManager(GLResourceMain& resource)
    m_DomainId(GLCF_PROTOCOL_DOMAIN_ID),
    m_ModuleId(GLCF_PR_PROTOCOL_DOMAIN_MANAGER_ID),
    m_State(PRDM_STATE_INACTIVE),
-   m_ResourceMain(resource)
+   m_ResourceMain(resource),
+   m_TelemetrySubscriptions(resource),
+   m_TelemetryAlarms(resource, m_TelemetrySubscriptions)
 {
 
 }
@@ -86,6 +128,7 @@ PrProtocolDomainManagerStateType PRProtocolDomainManager::State()
 void PRProtocolDomainManager::ActivateProtocolManager()
 {
    m_State = PRDM_STATE_ACTIVE;
+   m_TelemetryAlarms.Start();
    Resource().EventLog().LogEvent(
       GLCF_GL_RESOURCE_MAIN_ID,
       "PRProtocolDomainManager::ActivateProtocolManager().",
@@ -96,6 +139,7 @@ void PRProtocolDomainManager::ActivateProtocolManager()
 void PRProtocolDomainManager::DeactivateProtocolManager()
 {
    m_State = PRDM_STATE_INACTIVE;
+   m_TelemetryAlarms.Stop();
    Resource().EventLog().LogEvent(
       GLCF_GL_RESOURCE_MAIN_ID,
       "PRProtocolDomainManager::DeactivateProtocolManager().",
@@ -138,7 +182,7 @@ void PRProtocolDomainManager::ProcessMessage(
 }
 
 /******************************************************************************/
-void PRProtocolDomainManager::ProcessMessageStateActive(
+IONetworkControlStatus PRProtocolDomainManager::ProcessMessageStateActive(
       std::shared_ptr<IONetworkControlMessage>& msgPtr)
 {
    std::string logStr = "PRProtocolDomainManager::ProcessMessageStateActive(): " +
@@ -148,14 +192,17 @@ void PRProtocolDomainManager::ProcessMessageStateActive(
       logStr.c_str(),
       GLEV_EVENT_LEVEL_1);
 
+   // Messages without a handler yet stay IONW_STATUS_UNSUPPORTED.
+   IONetworkControlStatus status = IONW_STATUS_UNSUPPORTED;
+
    switch (msgPtr->MessageId())
    {
       case IONW_CONTROL_MSG_PING_INTERFACE:
-         EventPingMsgRcvdStateActive(msgPtr);
+         status = HandlerStatus(EventPingMsgRcvdStateActive(msgPtr));
          break;
 
       case IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL:
-         EventRqstIntfMsgRcvdStateActive(msgPtr);
+         status = HandlerStatus(EventRqstIntfMsgRcvdStateActive(msgPtr));
          break;
 
       case IONW_CONTROL_MSG_RESTART_SOC:
@@ -165,6 +212,7 @@ void PRProtocolDomainManager::ProcessMessageStateActive(
          break;
 
       case IONW_CONTROL_MSG_GET_SOC_SW_VERSION_STRING:
+         status = HandlerStatus(EventGetSocSwVersionMsgRcvdStateActive(msgPtr));
          break;
 
       case IONW_CONTROL_MSG_GET_MCU_SW_VERSION_STRING:
@@ -174,53 +222,112 @@ void PRProtocolDomainManager::ProcessMessageStateActive(
          break;
 
       case IONW_CONTROL_MSG_GET_SOC_TEMPERATURE:
+         status = HandlerStatus(EventGetSocTemperatureMsgRcvdStateActive(msgPtr));
          break;
 
       case IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT:
+         status = HandlerStatus(EventGetSocTemperatureLimitMsgRcvdStateActive(msgPtr));
          break;
 
       case IONW_CONTROL_MSG_GET_SOC_VOLTAGE:
+         status = HandlerStatus(EventGetSocVoltageMsgRcvdStateActive(msgPtr));
          break;
 
       case IONW_CONTROL_MSG_GET_SOC_LIMIT:
+         status = HandlerStatus(EventGetSocLimitMsgRcvdStateActive(msgPtr));
+         break;
+
+      case IONW_CONTROL_MSG_CLOCK_SYNC:
+         status = HandlerStatus(EventClockSyncMsgRcvdStateActive(msgPtr));
+         break;
+
+      case IONW_CONTROL_MSG_BATCH:
+         status = HandlerStatus(EventBatchMsgRcvdStateActive(msgPtr));
+         break;
+
+      case IONW_CONTROL_MSG_DUMP_CAPTURE:
+         status = HandlerStatus(EventDumpCaptureMsgRcvdStateActive(msgPtr));
+         break;
+
+      case IONW_CONTROL_MSG_SUBSCRIBE:
+         status = HandlerStatus(EventSubscribeMsgRcvdStateActive(msgPtr));
+         break;
+
+      case IONW_CONTROL_MSG_UNSUBSCRIBE:
+         status = HandlerStatus(EventUnsubscribeMsgRcvdStateActive(msgPtr));
+         break;
+
+      case IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY:
+         status = HandlerStatus(EventGetTelemetryHistoryMsgRcvdStateActive(msgPtr));
          break;
 
       case IONW_CONTROL_MSG_SHUTDOWN_INTERFACE:
          Resource().InterfaceManager().StopNetworkControlInterface();
+         status = IONW_STATUS_SUCCESS;
          break;
 
       case IONW_CONTROL_MSG_REQUEST_APP_SHUTDOWN:
       default:
-         std::string errStr =
-               "ProcessMessageStateActive(): Unhandled message. Id = " +
-               std::to_string(msgPtr->MessageId());
+      {
+         // Formatted on the stack; a flooding client repeats this one a lot.
+         char errStr[GLELErrorMaximumLengthChars + 40];
+         snprintf(errStr, sizeof(errStr),
+               "ProcessMessageStateActive(): Unhandled message. Id = %u",
+               msgPtr->MessageId());
          Resource().ErrorLog().LogError(
                ModuleId(),
-               errStr.c_str(),
+               errStr,
                GLEL_ERROR_LEVEL_1);
          break;
+      }
    }
+
+   return (status);
 }
 
 /******************************************************************************/
 bool PRProtocolDomainManager::EventPingMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
 {
    // Any  actions go here.
+   IONW_PING_INTERFACE_TYPE request;
+   if (IONWDecode(*msgPtr, request) && (request.flags & IONW_PING_FLAG_TIMESTAMPS) != 0)
+   {
+      return (EventTimestampedPingMsgRcvdStateActive(msgPtr));
+   }
 
    // Send response to message IONW_CONTROL_MSG_PING_INTERFACE
-   uint8_t msglen = m_theIoNwControlMessageFixedLengthBytes;
-   std::array<uint8_t, m_theIoNwControlMessageFixedLengthBytes> message =
-      {0x55,0xAA,0x00,0xff,0xaa,0x55,0xff,0x00, // sync pattern
-       IONW_CONTROL_MSG_PING_INTERFACE_RSP >> 8,
-       IONW_CONTROL_MSG_PING_INTERFACE_RSP & 0x00ff, // command IONW_CONTROL_MSG_PING_INTERFACE_RSP
-       14, // number of data bytes
-       1,  // message format version
-       0x00, 0x00, //msg security number
-       0x00, 0x00, // reserved 1
-       0x00, 0x00, // msg verification value (CRC)
-       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}; // msg data
-
-   bool success = SendResponseMessage(IONW_CONTROL_MSG_PING_INTERFACE_RSP, message, msglen);
+   auto message = IONWEncode(IONW_PING_INTERFACE_RSP_TYPE());
+
+   bool success = SendResponseMessage(IONW_CONTROL_MSG_PING_INTERFACE_RSP, message.data(), message.size());
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventTimestampedPingMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   IONW_PING_INTERFACE_TYPE request;
+   IONWDecode(*msgPtr, request);
+
+   // Client time, sequence and flags are echoed as they came.
+   IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE response;
+   response.clientTxNs = request.clientTxNs;
+   response.sequence = request.sequence;
+   response.flags = request.flags;
+   if (msgPtr->KernelReceiveTime())
+   {
+      response.flags |= IONW_PING_FLAG_KERNEL_RX_TIME;
+   }
+   response.serverRxNs = msgPtr->ReceiveTimeNs();
+
+   // Last thing before the send, the event log entry comes after it, on the
+   // clock of serverRxNs.
+   response.serverTxNs = msgPtr->KernelReceiveTime() ?
+         Resource().TimeHelper().GetRealtimeInNs() : Resource().TimeHelper().GetEpochTimeInNs();
+   auto message = IONWEncode(response);
+   bool success = Resource().InterfaceManager().SendResponseMessageToSourcePort(message.data(), message.size());
+
+   LogResponseSent(IONW_CONTROL_MSG_PING_INTERFACE_RSP, success);
 
    return (success);
 }
@@ -231,19 +338,408 @@ bool PRProtocolDomainManager::EventRqstIntfMsgRcvdStateActive(std::shared_ptr<IO
    // Any actions go here
 
    // Send response to message IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL
-   uint8_t msglen = m_theIoNwControlMessageFixedLengthBytes;
-   std::array<uint8_t, m_theIoNwControlMessageFixedLengthBytes> message =
-      {0x55,0xAA,0x00,0xff,0xaa,0x55,0xff,0x00, // sync pattern
-       IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL_RSP >> 8,
-       IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL_RSP & 0x00ff, // command IONW_CONTROL_MSG_PING_INTERFACE_RSP
-       14, // number of data bytes
-       1,  // message format version
-       0x00, 0x00, //msg security number
-       0x00, 0x00, // reserved 1
-       0x00, 0x00, // msg verification value (CRC)
-       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}; // msg data
-
-   bool success = SendResponseMessage(IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL_RSP, message, msglen);
+   auto message = IONWEncode(IONW_REQUEST_INTERFACE_CONTROL_RSP_TYPE());
+
+   bool success = SendResponseMessage(IONW_CONTROL_MSG_REQUEST_INTERFACE_CONTROL_RSP, message.data(), message.size());
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventGetSocSwVersionMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   // The kernel build identifies the SoC software image.
+   struct utsname name;
+   std::string version = "UNKNOWN";
+   if (uname(&name) == 0)
+   {
+      version = std::string(name.sysname) + " " + name.release + " " +
+         name.version + " " + name.machine;
+   }
+
+   bool success = Resource().InterfaceManager().SendVariableResponseMessageToSourcePort(
+      IONW_CONTROL_MSG_GET_SOC_SW_VERSION_STRING_RSP,
+      reinterpret_cast<const uint8_t*>(version.data()),
+      static_cast<uint32_t>(version.size()));
+
+   LogResponseSent(IONW_CONTROL_MSG_GET_SOC_SW_VERSION_STRING_RSP, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventGetSocTemperatureMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   return (SendTelemetryResponse(IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_RSP));
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventGetSocTemperatureLimitMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   return (SendTelemetryResponse(IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP));
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventGetSocVoltageMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   return (SendTelemetryResponse(IONW_CONTROL_MSG_GET_SOC_VOLTAGE_RSP));
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventGetSocLimitMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   return (SendTelemetryResponse(IONW_CONTROL_MSG_GET_SOC_LIMIT_RSP));
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventSubscribeMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   IONW_SUBSCRIBE_TYPE request;
+   IONW_SUBSCRIBE_RSP_TYPE response;
+
+   if (!IONWDecode(*msgPtr, request))
+   {
+      response.status = IONW_STATUS_MALFORMED;
+   }
+   else
+   {
+      m_TelemetrySubscriptions.Subscribe(
+            msgPtr->SourceIp(), msgPtr->SourcePort(), msgPtr->CompactResponse(), request, response);
+   }
+
+   auto message = IONWEncode(response);
+   bool success = Resource().InterfaceManager().SendResponseMessageToSourcePort(message.data(), message.size());
+
+   LogResponseSent(IONW_CONTROL_MSG_SUBSCRIBE_RSP, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventUnsubscribeMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   IONW_UNSUBSCRIBE_RSP_TYPE response;
+
+   if (!m_TelemetrySubscriptions.Unsubscribe(msgPtr->SourceIp(), msgPtr->SourcePort()))
+   {
+      response.status = IONW_STATUS_FAILED;
+   }
+
+   auto message = IONWEncode(response);
+   bool success = Resource().InterfaceManager().SendResponseMessageToSourcePort(message.data(), message.size());
+
+   LogResponseSent(IONW_CONTROL_MSG_UNSUBSCRIBE_RSP, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventGetTelemetryHistoryMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   IONW_GET_TELEMETRY_HISTORY_TYPE request;
+   IONW_GET_TELEMETRY_HISTORY_RSP_TYPE response;
+   GLTelemetrySampler& sampler = Resource().TelemetrySampler();
+   GL_TELEMETRY_RANGE_TYPE range;
+   uint64_t nowNs = GLTelemetrySampler::NowNs();
+
+   if (!IONWDecode(*msgPtr, request) || request.resolution > IONW_HISTORY_MINUTE)
+   {
+      response.status = IONW_STATUS_MALFORMED;
+   }
+   else if (!sampler.Active())
+   {
+      response.status = IONW_STATUS_UNAVAILABLE;
+   }
+   else
+   {
+      uint64_t fromNs = nowNs - std::min<uint64_t>(request.fromAgeMs * PRDMNanosecondsPerMs, nowNs);
+      uint64_t toNs = nowNs - std::min<uint64_t>(request.toAgeMs * PRDMNanosecondsPerMs, nowNs);
+      sampler.History().Range(
+            static_cast<GLTLHResolutionType>(request.resolution), fromNs, toNs, range);
+
+      response.resolution = request.resolution;
+      response.columns = (request.resolution == IONW_HISTORY_RAW) ? 1 : 3;
+      response.periodMs = PRDMHistoryPeriodMs[request.resolution];
+   }
+
+   // The range holds the zones, then the channels.
+   std::vector<IONW_TELEMETRY_METRIC_TYPE> metrics;
+   std::vector<uint32_t> columnIndexes;
+   for (uint32_t index = 0; index < range.zones + range.channels; index++)
+   {
+      IONW_TELEMETRY_METRIC_TYPE metric;
+      metric.telemetry = (index < range.zones) ? IONW_TELEMETRY_TEMPERATURE : IONW_TELEMETRY_VOLTAGE;
+      metric.sensor = static_cast<uint16_t>((index < range.zones) ? index : index - range.zones);
+      if ((request.telemetry & metric.telemetry) != 0)
+      {
+         metrics.push_back(metric);
+         columnIndexes.push_back(index);
+      }
+   }
+   response.metricCount = static_cast<uint16_t>(metrics.size());
+
+   // As many rows from firstRow as fit IONW_HISTORY_MAXIMUM_DATA_BYTES,
+   // at least one.
+   const uint32_t summaryBytes = IONWSchema<IONW_GET_TELEMETRY_HISTORY_RSP_TYPE>::dataBytes;
+   const uint32_t metricBytes = IONWSchema<IONW_TELEMETRY_METRIC_TYPE>::dataBytes;
+   const uint32_t headBytes = summaryBytes + static_cast<uint32_t>(metrics.size()) * metricBytes;
+   const uint32_t rowBytes = sizeof(uint32_t) +
+         static_cast<uint32_t>(metrics.size()) * response.columns * sizeof(int32_t);
+   uint32_t pageRows = std::max<uint32_t>((IONW_HISTORY_MAXIMUM_DATA_BYTES - headBytes) / rowBytes, 1);
+   uint32_t firstRow = std::min<uint32_t>(request.firstRow, range.rows);
+   uint32_t rows = std::min(range.rows - firstRow, pageRows);
+
+   response.firstRow = request.firstRow;
+   response.totalRows = static_cast<uint16_t>(range.rows);
+   response.rowCount = static_cast<uint16_t>(rows);
+
+   std::vector<uint8_t> data(headBytes + rows * rowBytes);
+   uint8_t* next = data.data();
+
+   IONWSchema<IONW_GET_TELEMETRY_HISTORY_RSP_TYPE>::Fields::Encode(response, next);
+   next += summaryBytes;
+
+   for (const IONW_TELEMETRY_METRIC_TYPE& metric : metrics)
+   {
+      IONWSchema<IONW_TELEMETRY_METRIC_TYPE>::Fields::Encode(metric, next);
+      next += metricBytes;
+   }
+
+   for (uint32_t row = firstRow; row < firstRow + rows; row++)
+   {
+      uint64_t ageNs = nowNs - std::min(range.timeNs[row], nowNs);
+      IONWWire<uint32_t>::Put(next, static_cast<uint32_t>(ageNs / PRDMNanosecondsPerMs));
+      next += sizeof(uint32_t);
+   }
+
+   // Raw rows have the value column only, kept in average.
+   const std::vector<int32_t>* columns[] = {&range.minimum, &range.maximum, &range.average};
+   for (uint32_t index : columnIndexes)
+   {
+      for (uint32_t column = 3 - response.columns; column < 3; column++)
+      {
+         const int32_t* values = columns[column]->data() + static_cast<size_t>(index) * range.rows;
+         for (uint32_t row = firstRow; row < firstRow + rows; row++)
+         {
+            IONWWire<int32_t>::Put(next, values[row]);
+            next += sizeof(int32_t);
+         }
+      }
+   }
+
+   bool success = Resource().InterfaceManager().SendVariableResponseMessageToSourcePort(
+      IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY_RSP,
+      data.data(),
+      static_cast<uint32_t>(data.size()));
+
+   LogResponseSent(IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY_RSP, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventClockSyncMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   GLTimeHelper& timeHelper = Resource().TimeHelper();
+   IONW_CLOCK_SYNC_TYPE request;
+   IONWDecode(*msgPtr, request);
+
+   // The receive time is an epoch time on CLOCK_REALTIME (kernel stamp) or
+   // on the helper's clock.  Only the time since the receive is taken from
+   // that clock, so serverRxNs and serverTxNs are both on the log timeline
+   // and an NTP step between them cannot bias the exchange.
+   IONW_CLOCK_SYNC_RSP_TYPE response;
+   response.sequence = request.sequence;
+   response.timelineEpochNs = timeHelper.GetTimelineEpochInNs();
+   uint64_t timelineNs = timeHelper.GetTimeInNs();
+   uint64_t receiveClockNs = msgPtr->KernelReceiveTime() ?
+         timeHelper.GetRealtimeInNs() : timeHelper.GetEpochTimeInNs();
+   uint64_t sinceReceiveNs = (receiveClockNs > msgPtr->ReceiveTimeNs()) ?
+         std::min(receiveClockNs - msgPtr->ReceiveTimeNs(), timelineNs) : 0;
+   response.serverRxNs = timelineNs - sinceReceiveNs;
+   if (msgPtr->KernelReceiveTime())
+   {
+      response.flags |= IONW_CLOCK_SYNC_FLAG_KERNEL_RX_TIME;
+   }
+
+   std::string client = msgPtr->SourceIp() + ":" + std::to_string(msgPtr->SourcePort());
+   PR_CLOCK_SYNC_SAMPLE_TYPE best;
+   uint32_t samples = 0;
+   if (m_ClockSyncFilter.FilterExchange(
+         client, request.sequence, request.previousRoundTripNs, response.serverRxNs, best, samples))
+   {
+      response.flags |= IONW_CLOCK_SYNC_FLAG_OFFSET_VALID;
+      response.offsetNs = best.offsetNs;
+      response.delayNs = static_cast<uint32_t>(std::min<uint64_t>(best.delayNs, UINT32_MAX));
+   }
+   response.samples = static_cast<uint8_t>(samples);
+
+   // Last thing before the send, the event log entry comes after it.
+   response.serverTxNs = timeHelper.GetTimeInNs();
+   auto message = IONWEncode(response);
+   bool success = Resource().InterfaceManager().SendResponseMessageToSourcePort(message.data(), message.size());
+
+   if (success)
+   {
+      m_ClockSyncFilter.RecordExchange(
+            client, request.sequence, request.clientTxNs, response.serverRxNs, response.serverTxNs);
+   }
+
+   LogResponseSent(IONW_CONTROL_MSG_CLOCK_SYNC_RSP, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventDumpCaptureMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   IONW_DUMP_CAPTURE_RSP_TYPE response;
+
+   if (msgPtr->SourceIp() != IOFRDumpControllerAddress)
+   {
+      response.status = IONW_STATUS_NOT_ALLOWED;
+
+      std::string errStr = "DumpCapture: not allowed from " + msgPtr->SourceIp();
+      Resource().ErrorLog().LogError(
+            ModuleId(),
+            errStr.c_str(),
+            GLEL_ERROR_LEVEL_1);
+   }
+   else if (!Resource().InterfaceManager().DumpCapture(response.datagrams))
+   {
+      response.status = IONW_STATUS_FAILED;
+   }
+
+   auto message = IONWEncode(response);
+   bool success = Resource().InterfaceManager().SendResponseMessageToSourcePort(message.data(), message.size());
+
+   LogResponseSent(IONW_CONTROL_MSG_DUMP_CAPTURE_RSP, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::EventBatchMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr)
+{
+   IONetworkControlInterfaceManager& interfaceManager = Resource().InterfaceManager();
+   const uint16_t entryBytes = IONWSchema<IONW_BATCH_ENTRY_TYPE>::dataBytes;
+   const uint16_t resultBytes = IONWSchema<IONW_BATCH_RSP_ENTRY_TYPE>::dataBytes;
+
+   IONW_BATCH_TYPE request;
+   if (!IONWDecode(*msgPtr, request))
+   {
+      Resource().ErrorLog().LogError(
+            ModuleId(),
+            "EventBatchMsgRcvdStateActive(): BATCH too short.",
+            GLEL_ERROR_LEVEL_1);
+      return (false);
+   }
+
+   const uint8_t* data = msgPtr->MessageData();
+   uint16_t dataBytes = msgPtr->DataBytes();
+   uint16_t offset = IONWSchema<IONW_BATCH_TYPE>::dataBytes;
+
+   // The result entries and response data blocks, behind the BATCH_RSP
+   // summary in a message no longer than the interface sends.
+   uint8_t results[m_theIoNwControlMessageMaximumDataBytes];
+   uint16_t resultsLimit = interfaceManager.MaximumMessageBytes() -
+         m_theIoNwControlMessageHeaderSizeBytes - IONWSchema<IONW_BATCH_RSP_TYPE>::dataBytes;
+   uint16_t resultsUsed = 0;
+   uint8_t command[m_theIoNwControlMessageMaximumLengthBytes];
+   IONW_BATCH_RSP_TYPE summary;
+
+   for (uint16_t index = 0;
+         index < request.commandCount && resultsUsed + resultBytes <= resultsLimit;
+         index++)
+   {
+      IONW_BATCH_ENTRY_TYPE entry;
+      IONW_BATCH_RSP_ENTRY_TYPE result;
+      bool malformed =
+            !IONWDecode(data + offset, dataBytes - offset, entry) ||
+            entry.dataBytes > dataBytes - offset - entryBytes;
+
+      result.requestId = entry.msgId;
+
+      if (malformed)
+      {
+         result.status = IONW_STATUS_MALFORMED;
+      }
+      else if (!AllowedInBatch(entry.msgId))
+      {
+         result.status = IONW_STATUS_NOT_ALLOWED;
+      }
+      else
+      {
+         // Run as if it came on its own, with the time and source of the
+         // BATCH, and keep the response it sends.
+         IONWEncodeHeader(entry.msgId, entry.dataBytes, command);
+         std::copy(
+               data + offset + entryBytes,
+               data + offset + entryBytes + entry.dataBytes,
+               command + m_theIoNwControlMessageHeaderSizeBytes);
+         IONetworkControlMessagePtr commandPtr = std::make_shared<IONetworkControlMessage>(
+               command, m_theIoNwControlMessageHeaderSizeBytes + entry.dataBytes);
+         commandPtr->SetReceiveTime(msgPtr->ReceiveTimeNs(), msgPtr->KernelReceiveTime());
+         commandPtr->SetSource(msgPtr->SourceIp(), msgPtr->SourcePort());
+
+         IO_RESPONSE_CAPTURE_TYPE capture;
+         capture.data = results + resultsUsed + resultBytes;
+         capture.capacity = resultsLimit - resultsUsed - resultBytes;
+
+         interfaceManager.SetResponseCapture(&capture);
+         result.status = ProcessMessageStateActive(commandPtr);
+         interfaceManager.SetResponseCapture(nullptr);
+
+         if (result.status == IONW_STATUS_SUCCESS && !capture.captured)
+         {
+            result.status = IONW_STATUS_FAILED;
+         }
+         else if (capture.truncated)
+         {
+            result.status = IONW_STATUS_TRUNCATED;
+         }
+         result.responseId = capture.msgId;
+         result.dataBytes = capture.dataBytes;
+      }
+
+      IONWSchema<IONW_BATCH_RSP_ENTRY_TYPE>::Fields::Encode(result, results + resultsUsed);
+      resultsUsed += resultBytes + result.dataBytes;
+
+      summary.commandCount++;
+      if (result.status != IONW_STATUS_SUCCESS)
+      {
+         summary.failedCount++;
+      }
+
+      // Where the next command starts is unknown past a malformed one.
+      if (malformed)
+      {
+         break;
+      }
+      offset += entryBytes + entry.dataBytes;
+   }
+
+   uint8_t response[m_theIoNwControlMessageMaximumLengthBytes];
+   uint16_t len = IONWEncodeWithTail(summary, results, resultsUsed, response);
+   bool success = interfaceManager.SendResponseMessageToSourcePort(response, len);
+
+   LogResponseSent(IONW_CONTROL_MSG_BATCH_RSP, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+bool PRProtocolDomainManager::SendTelemetryResponse(IONetworkControlMsgIds responseId)
+{
+   // From the sampler's last snapshot; no file system access here.
+   GL_TELEMETRY_SNAPSHOT_TYPE snapshot;
+   bool sampled = Resource().TelemetrySampler().Snapshot(snapshot);
+
+   uint8_t message[m_theIoNwControlMessageMaximumLengthBytes];
+   uint16_t len = PRTelemetrySubscriptions::EncodeTelemetry(responseId, snapshot, sampled, message);
+   bool success = Resource().InterfaceManager().SendResponseMessageToSourcePort(message, len);
+
+   LogResponseSent(responseId, success);
 
    return (success);
 }
@@ -251,11 +747,22 @@ bool PRProtocolDomainManager::EventRqstIntfMsgRcvdStateActive(std::shared_ptr<IO
 /******************************************************************************/
 bool PRProtocolDomainManager::SendResponseMessage(
       IONetworkControlMsgIds msgId,
-      std::array<uint8_t, m_theIoNwControlMessageFixedLengthBytes>& response,
+      uint8_t* response,
       uint8_t msglen)
 {
    bool success =
-      Resource().InterfaceManager().SendResponseMessageToSource(response.data(), msglen);
+      Resource().InterfaceManager().SendResponseMessageToSource(response, msglen);
+
+   LogResponseSent(msgId, success);
+
+   return (success);
+}
+
+/******************************************************************************/
+void PRProtocolDomainManager::LogResponseSent(
+      IONetworkControlMsgIds msgId,
+      bool success)
+{
    if (success)
    {
       std::string logStr =
@@ -276,8 +783,6 @@ bool PRProtocolDomainManager::SendResponseMessage(
          errStr.c_str(),
          GLEL_ERROR_LEVEL_1);
    }
-
-   return (success);
 }
 
 /******************************************************************************/
\ No newline at end of file
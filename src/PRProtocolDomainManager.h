@@ -27,6 +27,9 @@
 #include "GLConfigureDomains.h"
 #include "GLConfigureSystemModules.h"
 #include "IONetworkControlMessage.h"
+#include "PRClockSyncFilter.h"
+#include "PRTelemetryAlarms.h"
+#include "PRTelemetrySubscriptions.h"
 
 /******************************************************************************/
 /*                              D E F I N E S                                 */
@@ -75,17 +78,33 @@ class PRProtocolDomainManager
       void DeactivateProtocolManager();
       void ProcessMessage(
          std::shared_ptr<IONetworkControlMessage>& msgPtr);
-      void ProcessMessageStateActive(
+      IONetworkControlStatus ProcessMessageStateActive(
          std::shared_ptr<IONetworkControlMessage>& msgPtr);
 
       bool EventPingMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventTimestampedPingMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
       bool EventRqstIntfMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventGetSocSwVersionMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventGetSocTemperatureMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventGetSocTemperatureLimitMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventGetSocVoltageMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventGetSocLimitMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventClockSyncMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventBatchMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventDumpCaptureMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventSubscribeMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventUnsubscribeMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
+      bool EventGetTelemetryHistoryMsgRcvdStateActive(std::shared_ptr<IONetworkControlMessage>& msgPtr);
 
    private:
       bool SendResponseMessage(
          IONetworkControlMsgIds msgId,
-         std::array<uint8_t, m_theIoNwControlMessageFixedLengthBytes>& response,
+         uint8_t* response,
          uint8_t msglen);
+      bool SendTelemetryResponse(IONetworkControlMsgIds responseId);
+      void LogResponseSent(
+         IONetworkControlMsgIds msgId,
+         bool success);
       GLResourceMain& Resource();
       PrProtocolDomainManagerStateType State();
 
@@ -93,6 +112,9 @@ class PRProtocolDomainManager
       const GLCFModuleIds m_ModuleId;
       PrProtocolDomainManagerStateType m_State;
       GLResourceMain& m_ResourceMain;
+      PRClockSyncFilter m_ClockSyncFilter;
+      PRTelemetrySubscriptions m_TelemetrySubscriptions;
+      PRTelemetryAlarms m_TelemetryAlarms;
 };
 
 }
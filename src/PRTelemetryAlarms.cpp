@@ -0,0 +1,260 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file PRTelemetryAlarms.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the telemetry alarm engine.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <stdlib.h>
+
+#include "GLErrorLog.h"
+#include "GLResourceMain.h"
+#include "GLTimerWheel.h"
+#include "PRTelemetryAlarms.h"
+#include "PRTelemetrySubscriptions.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+typedef struct alarm_rule_struct
+{
+   IONetworkControlAlarmType alarm;
+   const char* name;
+   bool above;                         // raised above the limit, else below
+   uint32_t debounceSamples;
+} PR_ALARM_RULE_TYPE;
+
+// In IONetworkControlAlarmType order.  A critical trip is acted on at the
+// first sample.
+static const PR_ALARM_RULE_TYPE PRTARules[IONW_ALARM_TYPES] =
+{
+   {IONW_ALARM_TEMPERATURE_PASSIVE, "TEMPERATURE_PASSIVE", true, PRTADebounceSamples},
+   {IONW_ALARM_TEMPERATURE_CRITICAL, "TEMPERATURE_CRITICAL", true, 1},
+   {IONW_ALARM_VOLTAGE_LOW, "VOLTAGE_LOW", false, PRTADebounceSamples},
+   {IONW_ALARM_VOLTAGE_HIGH, "VOLTAGE_HIGH", true, PRTADebounceSamples},
+};
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static uint32_t RuleSensors(IONetworkControlAlarmType alarm, const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot)
+{
+   bool temperature = (alarm == IONW_ALARM_TEMPERATURE_PASSIVE || alarm == IONW_ALARM_TEMPERATURE_CRITICAL);
+
+   return std::min<uint32_t>(temperature ? snapshot.zoneCount : snapshot.channelCount, GLTLSMaximumSensors);
+}
+
+/******************************************************************************/
+static void RuleInputs(
+      IONetworkControlAlarmType alarm,
+      const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot,
+      uint32_t sensor,
+      int32_t& value,
+      int32_t& limit)
+{
+   switch (alarm)
+   {
+      case IONW_ALARM_TEMPERATURE_PASSIVE:
+         value = snapshot.temperatureMilliC[sensor];
+         limit = snapshot.passiveLimitMilliC[sensor];
+         break;
+
+      case IONW_ALARM_TEMPERATURE_CRITICAL:
+         value = snapshot.temperatureMilliC[sensor];
+         limit = snapshot.criticalLimitMilliC[sensor];
+         break;
+
+      case IONW_ALARM_VOLTAGE_LOW:
+         value = snapshot.voltageMilliV[sensor];
+         limit = snapshot.minimumMilliV[sensor];
+         break;
+
+      default:
+         value = snapshot.voltageMilliV[sensor];
+         limit = snapshot.maximumMilliV[sensor];
+         break;
+   }
+}
+
+/******************************************************************************/
+static int32_t Hysteresis(IONetworkControlAlarmType alarm, int32_t limit)
+{
+   if (alarm == IONW_ALARM_TEMPERATURE_PASSIVE || alarm == IONW_ALARM_TEMPERATURE_CRITICAL)
+   {
+      return (PRTATemperatureHysteresisMilliC);
+   }
+
+   return std::max<int32_t>(abs(limit) * PRTAVoltageHysteresisPercent / 100, 1);
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+PRTelemetryAlarms::PRTelemetryAlarms(GLResourceMain& resource, PRTelemetrySubscriptions& subscriptions)
+   :
+   m_ResourceMain(resource),
+   m_Subscriptions(subscriptions),
+   m_ActiveAlarms(0),
+   m_Edges(0),
+   m_FlushTimerId(GLTWInvalidTimerId)
+{
+}
+
+/******************************************************************************/
+PRTelemetryAlarms::~PRTelemetryAlarms()
+{
+   Stop();
+}
+
+/******************************************************************************/
+void PRTelemetryAlarms::Start()
+{
+   m_ResourceMain.TelemetrySampler().SetListener(this);
+}
+
+/******************************************************************************/
+void PRTelemetryAlarms::Stop()
+{
+   // Returns once the sampler thread is out of EventTelemetrySampled().
+   m_ResourceMain.TelemetrySampler().SetListener(nullptr);
+
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   if (m_FlushTimerId != GLTWInvalidTimerId)
+   {
+      m_ResourceMain.TimerWheel().Cancel(m_FlushTimerId);
+      m_FlushTimerId = GLTWInvalidTimerId;
+   }
+   m_Pending.clear();
+}
+
+/******************************************************************************/
+uint32_t PRTelemetryAlarms::ActiveAlarms()
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   return (m_ActiveAlarms);
+}
+
+/******************************************************************************/
+/*        T E L E M E T R Y  S A M P L E R  I N T F  M E T H O D S            */
+/******************************************************************************/
+void PRTelemetryAlarms::EventTelemetrySampled(const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   for (const PR_ALARM_RULE_TYPE& rule : PRTARules)
+   {
+      uint32_t sensors = RuleSensors(rule.alarm, snapshot);
+
+      for (uint32_t sensor = 0; sensor < sensors; sensor++)
+      {
+         PR_ALARM_STATE_TYPE& state = m_States[rule.alarm][sensor];
+         int32_t value;
+         int32_t limit;
+
+         RuleInputs(rule.alarm, snapshot, sensor, value, limit);
+         if (value == GLTLSNoValue || limit == GLTLSNoValue)
+         {
+            state.samples = 0;
+            continue;
+         }
+
+         int32_t hysteresis = Hysteresis(rule.alarm, limit);
+         bool beyond = rule.above ? (value >= limit) : (value <= limit);
+         bool inside = rule.above ? (value < limit - hysteresis) : (value > limit + hysteresis);
+
+         if (!(state.raised ? inside : beyond))
+         {
+            state.samples = 0;
+            continue;
+         }
+
+         if (++state.samples < rule.debounceSamples)
+         {
+            continue;
+         }
+
+         state.raised = !state.raised;
+         state.samples = 0;
+         Edge(rule.alarm, sensor, state.raised, value, limit);
+      }
+   }
+}
+
+/******************************************************************************/
+void PRTelemetryAlarms::Edge(
+      IONetworkControlAlarmType alarm,
+      uint32_t sensor,
+      bool raised,
+      int32_t value,
+      int32_t limit)
+{
+   m_ActiveAlarms = raised ? m_ActiveAlarms + 1 : m_ActiveAlarms - 1;
+
+   IONW_ALARM_NOTIFY_TYPE notify;
+   notify.sequence = ++m_Edges;
+   notify.alarm = static_cast<uint8_t>(alarm);
+   notify.sensor = static_cast<uint8_t>(sensor);
+   notify.state = raised ? IONW_ALARM_RAISED : IONW_ALARM_CLEARED;
+   notify.activeAlarms = static_cast<uint8_t>(std::min<uint32_t>(m_ActiveAlarms, UINT8_MAX));
+   notify.value = value;
+   notify.limit = limit;
+
+   std::string errStr = std::string("Alarm ") + (raised ? "raised: " : "cleared: ") +
+         PRTARules[alarm].name + " sensor " + std::to_string(sensor) +
+         " value " + std::to_string(value) + " limit " + std::to_string(limit);
+   m_ResourceMain.ErrorLog().LogError(
+         GLCF_PR_PROTOCOL_DOMAIN_MANAGER_ID,
+         errStr.c_str(),
+         GLEL_ERROR_LEVEL_1);
+
+   if (m_Pending.size() >= PRTAMaximumPendingEdges)
+   {
+      return;
+   }
+
+   m_Pending.push_back(notify);
+   if (m_FlushTimerId == GLTWInvalidTimerId)
+   {
+      m_FlushTimerId = m_ResourceMain.TimerWheel().Schedule(*this, 0, 0);
+   }
+}
+
+/******************************************************************************/
+/*               T I M E R  W H E E L  I N T F  M E T H O D S                 */
+/******************************************************************************/
+void PRTelemetryAlarms::EventTimerExpired(GLTimerId timerId, uint64_t)
+{
+   std::vector<IONW_ALARM_NOTIFY_TYPE> pending;
+
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (timerId != m_FlushTimerId)
+      {
+         return;
+      }
+      m_FlushTimerId = GLTWInvalidTimerId;
+      pending.swap(m_Pending);
+   }
+
+   for (const IONW_ALARM_NOTIFY_TYPE& notify : pending)
+   {
+      auto message = IONWEncode(notify);
+      m_Subscriptions.Notify(IONW_TELEMETRY_ALARMS, message.data(), static_cast<uint16_t>(message.size()));
+   }
+}
+
+/******************************************************************************/
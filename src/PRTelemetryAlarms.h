@@ -0,0 +1,118 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file PRTelemetryAlarms.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the telemetry alarm engine.  Every
+   sample of the telemetry sampler is checked, on the sampler thread,
+   against the limits in the same sample, one rule per IONW_ALARM_ type and
+   sensor:
+
+      TEMPERATURE_PASSIVE    temperature >= passive trip
+      TEMPERATURE_CRITICAL   temperature >= critical trip
+      VOLTAGE_LOW            voltage <= minimum
+      VOLTAGE_HIGH           voltage >= maximum
+
+   An alarm is raised after debounceSamples samples in a row beyond its
+   limit and cleared after as many samples back inside it by more than the
+   hysteresis, so a value resting on a limit does not chatter.  A sensor or
+   limit without a value leaves its alarm as it is.
+
+   Each raise and clear is logged to the error log at once and queued; a
+   one shot timer hands the queue to the thread driving the timer wheel,
+   which sends one ALARM_NOTIFY per edge to the IONW_TELEMETRY_ALARMS
+   subscribers.  The sampler thread never sends.
+*/
+/******************************************************************************/
+#ifndef pr_telemetry_alarms_h
+#define pr_telemetry_alarms_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <mutex>
+#include <vector>
+
+#include "GLTelemetrySampler.h"
+#include "GLTelemetrySamplerIntf.h"
+#include "GLTimerWheelIntf.h"
+#include "GLTypedefs.h"
+#include "IONetworkControlPayloads.h"
+
+namespace MDN
+{
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+const int32_t PRTATemperatureHysteresisMilliC = 2000;
+// Of the limit, at least 1 mV.
+const int32_t PRTAVoltageHysteresisPercent = 1;
+const uint32_t PRTADebounceSamples = 2;
+// Edges waiting for the wheel; later ones are dropped, the gap in the
+// ALARM_NOTIFY sequence shows it.
+const uint32_t PRTAMaximumPendingEdges = 64;
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+typedef struct alarm_state_struct
+{
+   bool raised = false;
+   uint32_t samples = 0;               // in a row toward the other state
+} PR_ALARM_STATE_TYPE;
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+class GLResourceMain;
+class PRTelemetrySubscriptions;
+
+class PRTelemetryAlarms : public GLTelemetrySamplerIntf, public GLTimerWheelIntf
+{
+   public:
+      PRTelemetryAlarms(GLResourceMain& resource, PRTelemetrySubscriptions& subscriptions);
+      ~PRTelemetryAlarms();
+
+      // Listens to the sampler; Stop() before the subscriptions go away.
+      void Start();
+      void Stop();
+      uint32_t ActiveAlarms();
+
+      // T E L E M E T R Y  S A M P L E R  I N T E R F A C E
+      void EventTelemetrySampled(const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot) override;
+
+      // T I M E R  W H E E L  I N T E R F A C E
+      void EventTimerExpired(GLTimerId timerId, uint64_t context) override;
+
+   private:
+      void Edge(
+            IONetworkControlAlarmType alarm,
+            uint32_t sensor,
+            bool raised,
+            int32_t value,
+            int32_t limit);
+
+      GLResourceMain& m_ResourceMain;
+      PRTelemetrySubscriptions& m_Subscriptions;
+      PR_ALARM_STATE_TYPE m_States[IONW_ALARM_TYPES][GLTLSMaximumSensors];
+      uint32_t m_ActiveAlarms;
+      uint32_t m_Edges;
+      std::vector<IONW_ALARM_NOTIFY_TYPE> m_Pending;
+      GLTimerId m_FlushTimerId;
+      std::mutex m_Mutex;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* pr_telemetry_alarms_h */
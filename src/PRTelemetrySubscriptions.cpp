@@ -0,0 +1,465 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file PRTelemetrySubscriptions.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the telemetry subscriptions.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <stdio.h>
+
+#include "GLErrorLog.h"
+#include "GLEventLog.h"
+#include "GLResourceMain.h"
+#include "GLTimeHelper.h"
+#include "GLTimerWheel.h"
+#include "IONetworkControlInterfaceManager.h"
+#include "PRTelemetrySubscriptions.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint64_t PRTSNanosecondsPerMs = 1000000;
+
+// The GET_SOC_ response of each IONW_TELEMETRY_ bit, in bit order.
+static const IONetworkControlMsgIds PRTSSectionResponseIds[PRTSSections] =
+{
+   IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_RSP,
+   IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP,
+   IONW_CONTROL_MSG_GET_SOC_VOLTAGE_RSP,
+   IONW_CONTROL_MSG_GET_SOC_LIMIT_RSP,
+};
+
+// Where sampleAgeMs sits in a GET_SOC_ response data block; it changes on
+// every push, so on-change comparisons leave it out.
+static const uint16_t PRTSSampleAgeIndex = 4;
+static const uint16_t PRTSSampleAgeBytes = 4;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+// A SoC telemetry response: the summary and entry(index) for each of count
+// sensors, or IONW_STATUS_UNAVAILABLE without a sample.  Returns the length.
+template <typename Payload, typename MakeEntry>
+static uint16_t EncodeSocTelemetry(
+      const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot,
+      bool sampled,
+      uint32_t count,
+      MakeEntry entry,
+      uint8_t* message)
+{
+   using Entry = decltype(entry(0));
+   const uint16_t entryBytes = IONWSchema<Entry>::dataBytes;
+   uint8_t entries[GLTLSMaximumSensors * entryBytes];
+   Payload summary;
+
+   if (!sampled)
+   {
+      summary.status = IONW_STATUS_UNAVAILABLE;
+      count = 0;
+   }
+   else
+   {
+      summary.sensorCount = static_cast<uint16_t>(count);
+      summary.sampleAgeMs = static_cast<uint32_t>(
+            (GLTelemetrySampler::NowNs() - snapshot.sampleTimeNs) / PRTSNanosecondsPerMs);
+   }
+
+   for (uint32_t index = 0; index < count; index++)
+   {
+      IONWSchema<Entry>::Fields::Encode(entry(index), entries + index * entryBytes);
+   }
+
+   return (IONWEncodeWithTail(summary, entries, static_cast<uint16_t>(count * entryBytes), message));
+}
+
+/******************************************************************************/
+static IONW_SOC_READING_TYPE Reading(int32_t value)
+{
+   IONW_SOC_READING_TYPE reading;
+   reading.value = value;
+   return (reading);
+}
+
+/******************************************************************************/
+static IONW_SOC_LIMITS_TYPE Limits(int32_t lower, int32_t upper)
+{
+   IONW_SOC_LIMITS_TYPE limits;
+   limits.lower = lower;
+   limits.upper = upper;
+   return (limits);
+}
+
+/******************************************************************************/
+// FNV-1a of a section data block without its sample age.
+static uint64_t SectionHash(const uint8_t* data, uint16_t dataBytes)
+{
+   uint64_t hash = 0xcbf29ce484222325ULL;
+
+   for (uint16_t index = 0; index < dataBytes; index++)
+   {
+      if (index >= PRTSSampleAgeIndex && index < PRTSSampleAgeIndex + PRTSSampleAgeBytes)
+      {
+         continue;
+      }
+      hash = (hash ^ data[index]) * 0x100000001b3ULL;
+   }
+
+   return (hash);
+}
+
+/******************************************************************************/
+static uint32_t ClampMs(uint32_t requestedMs, uint32_t defaultMs, uint32_t minimumMs, uint32_t maximumMs)
+{
+   if (requestedMs == 0)
+   {
+      return (defaultMs);
+   }
+
+   return (std::min(std::max(requestedMs, minimumMs), maximumMs));
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+PRTelemetrySubscriptions::PRTelemetrySubscriptions(GLResourceMain& resource)
+   :
+   m_ResourceMain(resource),
+   m_TickTimerId(GLTWInvalidTimerId)
+{
+}
+
+/******************************************************************************/
+PRTelemetrySubscriptions::~PRTelemetrySubscriptions()
+{
+   Clear();
+}
+
+/******************************************************************************/
+uint32_t PRTelemetrySubscriptions::Subscribers()
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   return static_cast<uint32_t>(m_Subscriptions.size());
+}
+
+/******************************************************************************/
+uint16_t PRTelemetrySubscriptions::EncodeTelemetry(
+      IONetworkControlMsgIds responseId,
+      const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot,
+      bool sampled,
+      uint8_t* message)
+{
+   switch (responseId)
+   {
+      case IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_RSP:
+         return (EncodeSocTelemetry<IONW_GET_SOC_TEMPERATURE_RSP_TYPE>(
+               snapshot, sampled, snapshot.zoneCount,
+               [&snapshot](uint32_t index)
+               {
+                  return Reading(snapshot.temperatureMilliC[index]);
+               },
+               message));
+
+      case IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP:
+         return (EncodeSocTelemetry<IONW_GET_SOC_TEMPERATURE_LIMIT_RSP_TYPE>(
+               snapshot, sampled, snapshot.zoneCount,
+               [&snapshot](uint32_t index)
+               {
+                  return Limits(snapshot.passiveLimitMilliC[index], snapshot.criticalLimitMilliC[index]);
+               },
+               message));
+
+      case IONW_CONTROL_MSG_GET_SOC_VOLTAGE_RSP:
+         return (EncodeSocTelemetry<IONW_GET_SOC_VOLTAGE_RSP_TYPE>(
+               snapshot, sampled, snapshot.channelCount,
+               [&snapshot](uint32_t index)
+               {
+                  return Reading(snapshot.voltageMilliV[index]);
+               },
+               message));
+
+      case IONW_CONTROL_MSG_GET_SOC_LIMIT_RSP:
+         return (EncodeSocTelemetry<IONW_GET_SOC_LIMIT_RSP_TYPE>(
+               snapshot, sampled, snapshot.channelCount,
+               [&snapshot](uint32_t index)
+               {
+                  return Limits(snapshot.minimumMilliV[index], snapshot.maximumMilliV[index]);
+               },
+               message));
+
+      default:
+         return (0);
+   }
+}
+
+/******************************************************************************/
+bool PRTelemetrySubscriptions::Subscribe(
+      const std::string& ipAddress,
+      uint16_t port,
+      bool compact,
+      const IONW_SUBSCRIBE_TYPE& request,
+      IONW_SUBSCRIBE_RSP_TYPE& granted)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   std::string client = ipAddress + ":" + std::to_string(port);
+   auto existing = m_Subscriptions.find(client);
+
+   granted.telemetry = request.telemetry & (IONW_TELEMETRY_ALL | IONW_TELEMETRY_ALARMS);
+   if (granted.telemetry == 0 ||
+      (existing == m_Subscriptions.end() && m_Subscriptions.size() >= PRTSMaximumSubscribers))
+   {
+      granted.status = IONW_STATUS_FAILED;
+      granted.telemetry = 0;
+      return (false);
+   }
+
+   granted.intervalMs = ClampMs(request.intervalMs, PRTSDefaultIntervalMs, PRTSMinimumIntervalMs, PRTSMaximumIntervalMs);
+   granted.leaseMs = ClampMs(request.leaseMs, PRTSDefaultLeaseMs, PRTSMinimumLeaseMs, PRTSMaximumLeaseMs);
+
+   uint64_t nowNs = m_ResourceMain.TimeHelper().GetTimeInNs();
+   PR_TELEMETRY_SUBSCRIPTION_TYPE& subscription = m_Subscriptions[client];
+   bool renewal = (existing != m_Subscriptions.end());
+
+   subscription.ipAddress = ipAddress;
+   subscription.port = port;
+   subscription.compact = compact;
+   subscription.flags = request.flags;
+   subscription.intervalNs = granted.intervalMs * PRTSNanosecondsPerMs;
+   subscription.leaseEndNs = nowNs + granted.leaseMs * PRTSNanosecondsPerMs;
+   if (!renewal || subscription.telemetry != granted.telemetry)
+   {
+      // The first push goes out on the next tick.
+      subscription.telemetry = granted.telemetry;
+      subscription.nextPushNs = nowNs;
+      subscription.pushedHash.fill(0);
+   }
+
+   if (m_TickTimerId == GLTWInvalidTimerId)
+   {
+      m_TickTimerId = m_ResourceMain.TimerWheel().Schedule(*this, PRTSTickNs, PRTSTickNs);
+   }
+
+   if (!renewal)
+   {
+      std::string logStr = "Subscribe: " + client;
+      m_ResourceMain.EventLog().LogEvent(
+            GLCF_PR_PROTOCOL_DOMAIN_MANAGER_ID,
+            logStr.c_str(),
+            GLEV_EVENT_LEVEL_1);
+   }
+
+   return (true);
+}
+
+/******************************************************************************/
+bool PRTelemetrySubscriptions::Unsubscribe(const std::string& ipAddress, uint16_t port)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   bool found = (m_Subscriptions.erase(ipAddress + ":" + std::to_string(port)) > 0);
+
+   if (m_Subscriptions.empty())
+   {
+      StopTick();
+   }
+
+   return (found);
+}
+
+/******************************************************************************/
+void PRTelemetrySubscriptions::Clear()
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   m_Subscriptions.clear();
+   StopTick();
+}
+
+/******************************************************************************/
+void PRTelemetrySubscriptions::Notify(uint16_t telemetry, const uint8_t* message, uint16_t len)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   uint64_t nowNs = m_ResourceMain.TimeHelper().GetTimeInNs();
+   uint8_t copy[m_theIoNwControlMessageMaximumLengthBytes];
+
+   std::copy(message, message + len, copy);
+   for (const auto& entry : m_Subscriptions)
+   {
+      const PR_TELEMETRY_SUBSCRIPTION_TYPE& subscription = entry.second;
+      if ((subscription.telemetry & telemetry) == 0 || subscription.leaseEndNs <= nowNs)
+      {
+         continue;
+      }
+
+      if (!m_ResourceMain.InterfaceManager().SendMessageToClient(
+            copy, len, subscription.ipAddress, subscription.port, subscription.compact))
+      {
+         std::string errStr = "Notify(): Send FAIL to " + entry.first;
+         m_ResourceMain.ErrorLog().LogError(
+               GLCF_PR_PROTOCOL_DOMAIN_MANAGER_ID,
+               errStr.c_str(),
+               GLEL_ERROR_LEVEL_1);
+      }
+   }
+}
+
+/******************************************************************************/
+void PRTelemetrySubscriptions::StopTick()
+{
+   if (m_TickTimerId != GLTWInvalidTimerId)
+   {
+      m_ResourceMain.TimerWheel().Cancel(m_TickTimerId);
+      m_TickTimerId = GLTWInvalidTimerId;
+   }
+}
+
+/******************************************************************************/
+/*               T I M E R  W H E E L  I N T F  M E T H O D S                 */
+/******************************************************************************/
+void PRTelemetrySubscriptions::EventTimerExpired(GLTimerId timerId, uint64_t)
+{
+   std::lock_guard<std::mutex> lock(m_Mutex);
+
+   if (timerId == m_TickTimerId)
+   {
+      PushDueUpdates();
+   }
+}
+
+/******************************************************************************/
+void PRTelemetrySubscriptions::PushDueUpdates()
+{
+   uint64_t nowNs = m_ResourceMain.TimeHelper().GetTimeInNs();
+
+   for (auto entry = m_Subscriptions.begin(); entry != m_Subscriptions.end();)
+   {
+      if (entry->second.leaseEndNs <= nowNs)
+      {
+         std::string logStr = "Subscription lease ended: " + entry->first;
+         m_ResourceMain.EventLog().LogEvent(
+               GLCF_PR_PROTOCOL_DOMAIN_MANAGER_ID,
+               logStr.c_str(),
+               GLEV_EVENT_LEVEL_1);
+         entry = m_Subscriptions.erase(entry);
+      }
+      else
+      {
+         ++entry;
+      }
+   }
+
+   if (m_Subscriptions.empty())
+   {
+      StopTick();
+      return;
+   }
+
+   // Each section is encoded once per tick, when the first subscriber due
+   // wants it.
+   GL_TELEMETRY_SNAPSHOT_TYPE snapshot;
+   bool sampled = false;
+   bool snapshotTaken = false;
+   uint8_t sections[PRTSSections][m_theIoNwControlMessageMaximumLengthBytes];
+   uint16_t sectionBytes[PRTSSections] = {};
+   uint64_t sectionHash[PRTSSections] = {};
+   bool sectionEncoded[PRTSSections] = {};
+   uint8_t tail[m_theIoNwControlMessageMaximumDataBytes];
+   uint8_t message[m_theIoNwControlMessageMaximumLengthBytes];
+   const uint16_t headerBytes = IONWSchema<IONW_TELEMETRY_SECTION_TYPE>::dataBytes;
+   const uint16_t tailLimit = m_ResourceMain.InterfaceManager().MaximumMessageBytes() -
+         m_theIoNwControlMessageHeaderSizeBytes - IONWSchema<IONW_TELEMETRY_PUSH_TYPE>::dataBytes;
+
+   for (auto& entry : m_Subscriptions)
+   {
+      PR_TELEMETRY_SUBSCRIPTION_TYPE& subscription = entry.second;
+      if (subscription.nextPushNs > nowNs || (subscription.telemetry & IONW_TELEMETRY_ALL) == 0)
+      {
+         continue;
+      }
+
+      // Next push an interval on, or an interval from now after a stall.
+      subscription.nextPushNs += subscription.intervalNs;
+      if (subscription.nextPushNs <= nowNs)
+      {
+         subscription.nextPushNs = nowNs + subscription.intervalNs;
+      }
+
+      if (!snapshotTaken)
+      {
+         sampled = m_ResourceMain.TelemetrySampler().Snapshot(snapshot);
+         snapshotTaken = true;
+      }
+
+      IONW_TELEMETRY_PUSH_TYPE push;
+      uint16_t tailBytes = 0;
+      bool changed = false;
+
+      for (uint32_t section = 0; section < PRTSSections; section++)
+      {
+         if ((subscription.telemetry & (1 << section)) == 0)
+         {
+            continue;
+         }
+
+         if (!sectionEncoded[section])
+         {
+            uint16_t len = EncodeTelemetry(PRTSSectionResponseIds[section], snapshot, sampled, sections[section]);
+            sectionBytes[section] = (len > m_theIoNwControlMessageHeaderSizeBytes) ?
+                  len - m_theIoNwControlMessageHeaderSizeBytes : 0;
+            sectionHash[section] = SectionHash(
+                  sections[section] + m_theIoNwControlMessageHeaderSizeBytes, sectionBytes[section]);
+            sectionEncoded[section] = true;
+         }
+
+         if (tailBytes + headerBytes + sectionBytes[section] > tailLimit)
+         {
+            break;
+         }
+
+         IONW_TELEMETRY_SECTION_TYPE header;
+         header.responseId = PRTSSectionResponseIds[section];
+         header.dataBytes = sectionBytes[section];
+         IONWSchema<IONW_TELEMETRY_SECTION_TYPE>::Fields::Encode(header, tail + tailBytes);
+         std::copy(
+               sections[section] + m_theIoNwControlMessageHeaderSizeBytes,
+               sections[section] + m_theIoNwControlMessageHeaderSizeBytes + sectionBytes[section],
+               tail + tailBytes + headerBytes);
+         tailBytes += headerBytes + sectionBytes[section];
+         push.sectionCount++;
+
+         changed = changed || (subscription.pushedHash[section] != sectionHash[section]);
+         subscription.pushedHash[section] = sectionHash[section];
+      }
+
+      if ((subscription.flags & IONW_SUBSCRIBE_FLAG_ON_CHANGE) != 0 && !changed)
+      {
+         continue;
+      }
+
+      push.sequence = ++subscription.pushes;
+      uint16_t len = IONWEncodeWithTail(push, tail, tailBytes, message);
+      if (!m_ResourceMain.InterfaceManager().SendMessageToClient(
+            message, len, subscription.ipAddress, subscription.port, subscription.compact))
+      {
+         std::string errStr = "PushDueUpdates(): Push FAIL to " + entry.first;
+         m_ResourceMain.ErrorLog().LogError(
+               GLCF_PR_PROTOCOL_DOMAIN_MANAGER_ID,
+               errStr.c_str(),
+               GLEL_ERROR_LEVEL_1);
+      }
+   }
+}
+
+/******************************************************************************/
@@ -0,0 +1,132 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file PRTelemetrySubscriptions.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the telemetry subscriptions.  A
+   client that SUBSCRIBEs gets TELEMETRY_PUSH messages instead of polling
+   the GET_SOC_ requests, so many clients watching the same values cost one
+   sample and one encoding per tick rather than one request each.
+
+   While any subscription is active one periodic timer of PRTSTickNs runs
+   on the timer wheel.  Each tick drops the subscriptions whose lease ran
+   out, copies the telemetry snapshot once, encodes each telemetry section
+   that some due subscriber wants once, and sends every due subscriber one
+   datagram with its sections, in the header format of its SUBSCRIBE.  An
+   on-change subscriber is skipped while its sections hold the same values
+   as in its last push.  Notify() sends a message, e.g. an ALARM_NOTIFY, to
+   the subscribers of a telemetry bit at once, outside the tick.
+*/
+/******************************************************************************/
+#ifndef pr_telemetry_subscriptions_h
+#define pr_telemetry_subscriptions_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "GLTelemetrySampler.h"
+#include "GLTimerWheelIntf.h"
+#include "GLTypedefs.h"
+#include "IONetworkControlPayloads.h"
+
+namespace MDN
+{
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+const uint64_t PRTSTickNs = 50000000;             // 50 ms
+const uint32_t PRTSMinimumIntervalMs = 50;
+const uint32_t PRTSMaximumIntervalMs = 60000;
+const uint32_t PRTSDefaultIntervalMs = 1000;
+const uint32_t PRTSMinimumLeaseMs = 1000;
+const uint32_t PRTSMaximumLeaseMs = 600000;
+const uint32_t PRTSDefaultLeaseMs = 30000;
+const uint32_t PRTSMaximumSubscribers = 64;
+// One per IONW_TELEMETRY_ bit.
+const uint32_t PRTSSections = 4;
+
+/******************************************************************************/
+/*                           D A T A  M O D E L S                             */
+/******************************************************************************/
+typedef struct telemetry_subscription_struct
+{
+   std::string ipAddress;
+   uint16_t port = 0;
+   bool compact = false;
+   uint16_t telemetry = 0;             // IONW_TELEMETRY_ bits
+   uint8_t flags = 0;                  // IONW_SUBSCRIBE_FLAG_ bits
+   uint64_t intervalNs = 0;
+   uint64_t nextPushNs = 0;
+   uint64_t leaseEndNs = 0;
+   uint32_t pushes = 0;
+   std::array<uint64_t, PRTSSections> pushedHash = {};   // on change only
+} PR_TELEMETRY_SUBSCRIPTION_TYPE;
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+class GLResourceMain;
+
+class PRTelemetrySubscriptions : public GLTimerWheelIntf
+{
+   public:
+      PRTelemetrySubscriptions(GLResourceMain& resource);
+      ~PRTelemetrySubscriptions();
+
+      // Adds or renews the subscription of the client at ipAddress:port and
+      // fills in the terms granted.  False when request selects no
+      // telemetry or PRTSMaximumSubscribers other clients hold one.
+      bool Subscribe(
+            const std::string& ipAddress,
+            uint16_t port,
+            bool compact,
+            const IONW_SUBSCRIBE_TYPE& request,
+            IONW_SUBSCRIBE_RSP_TYPE& granted);
+      bool Unsubscribe(const std::string& ipAddress, uint16_t port);
+      void Clear();
+      uint32_t Subscribers();
+
+      // Sends message to every subscriber of a telemetry bit, in the header
+      // format of its SUBSCRIBE.  Called on the thread driving the wheel.
+      void Notify(uint16_t telemetry, const uint8_t* message, uint16_t len);
+
+      // The GET_SOC_ response responseId from snapshot, into message; the
+      // one encoding for requests and pushes.  Returns the length.
+      static uint16_t EncodeTelemetry(
+            IONetworkControlMsgIds responseId,
+            const GL_TELEMETRY_SNAPSHOT_TYPE& snapshot,
+            bool sampled,
+            uint8_t* message);
+
+      // T I M E R  W H E E L  I N T E R F A C E
+      void EventTimerExpired(GLTimerId timerId, uint64_t context) override;
+
+   private:
+      void PushDueUpdates();
+      void StopTick();
+
+      GLResourceMain& m_ResourceMain;
+      std::map<std::string, PR_TELEMETRY_SUBSCRIPTION_TYPE> m_Subscriptions;
+      GLTimerId m_TickTimerId;
+      std::mutex m_Mutex;
+};
+
+}
+
+/******************************************************************************/
+
+#endif /* pr_telemetry_subscriptions_h */
@@ -0,0 +1,720 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkClient.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the implementation for the pipelined client of
+   libucrp-client.
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "IONetworkClient.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       C O N S T A N T S                                                    */
+/******************************************************************************/
+namespace
+{
+
+const int32_t IONCLInvalidFd = -1;
+const uint64_t IONCLNanosecondsPerMillisecond = 1000000ULL;
+const uint64_t IONCLNoDeadline = UINT64_MAX;
+// One more than the longest message, to see one that is too long.
+const uint32_t IONCLReceiveBufferBytes = m_theIoNwControlMessageMaximumLengthBytes + 1;
+
+}
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static IO_CLIENT_OPTIONS_TYPE ClampOptions(const IO_CLIENT_OPTIONS_TYPE& options)
+{
+   IO_CLIENT_OPTIONS_TYPE clamped = options;
+
+   clamped.window = std::min(std::max<uint16_t>(options.window, 1), IONCLMaximumWindow);
+
+   return (clamped);
+}
+
+/******************************************************************************/
+/*       I M P L E M E N T A T I O N                                          */
+/******************************************************************************/
+IONetworkClient::IONetworkClient(const IO_CLIENT_OPTIONS_TYPE& options)
+   :
+   m_Options(ClampOptions(options)),
+   m_State(IONCL_STATE_INACTIVE),
+   m_Sockfd(IONCLInvalidFd),
+   m_WakeFd(IONCLInvalidFd),
+   m_NextSequence(1),
+   m_ThreadWakeNs(IONCLNoDeadline),
+   m_StopRequested(false),
+   m_RequestsSent(0),
+   m_Retransmits(0),
+   m_Timeouts(0),
+   m_UnmatchedResponses(0),
+   m_ReceiveBuffers(IONCLBatchDatagrams * IONCLReceiveBufferBytes)
+{
+}
+
+/******************************************************************************/
+IONetworkClient::~IONetworkClient()
+{
+   Stop();
+}
+
+/******************************************************************************/
+bool IONetworkClient::Active()
+{
+   return (m_State == IONCL_STATE_ACTIVE);
+}
+
+/******************************************************************************/
+uint64_t IONetworkClient::RequestsSent()
+{
+   return m_RequestsSent.load();
+}
+
+/******************************************************************************/
+uint64_t IONetworkClient::Retransmits()
+{
+   return m_Retransmits.load();
+}
+
+/******************************************************************************/
+uint64_t IONetworkClient::Timeouts()
+{
+   return m_Timeouts.load();
+}
+
+/******************************************************************************/
+uint64_t IONetworkClient::UnmatchedResponses()
+{
+   return m_UnmatchedResponses.load();
+}
+
+/******************************************************************************/
+uint64_t IONetworkClient::NowNs()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/******************************************************************************/
+bool IONetworkClient::Start(const std::string& serverIpAddress, uint16_t serverPort)
+{
+   if (Active())
+   {
+      return (false);
+   }
+
+   struct sockaddr_in server;
+   memset(&server, 0, sizeof(server));
+   server.sin_family = AF_INET;
+   server.sin_port = htons(serverPort);
+   if (inet_pton(AF_INET, serverIpAddress.c_str(), &server.sin_addr) != 1)
+   {
+      return (false);
+   }
+
+   // Connected, so only the server's datagrams are received.
+   m_Sockfd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_IP);
+   m_WakeFd = eventfd(0, EFD_NONBLOCK);
+   if (m_Sockfd == IONCLInvalidFd || m_WakeFd == IONCLInvalidFd ||
+      connect(m_Sockfd, reinterpret_cast<struct sockaddr*>(&server), sizeof(server)) != 0)
+   {
+      if (m_Sockfd != IONCLInvalidFd)
+      {
+         close(m_Sockfd);
+      }
+      if (m_WakeFd != IONCLInvalidFd)
+      {
+         close(m_WakeFd);
+      }
+      m_Sockfd = IONCLInvalidFd;
+      m_WakeFd = IONCLInvalidFd;
+      return (false);
+   }
+
+   m_StopRequested = false;
+   m_State = IONCL_STATE_ACTIVE;
+   m_Thread = std::thread(&IONetworkClient::ClientThread, this);
+
+   return (true);
+}
+
+/******************************************************************************/
+void IONetworkClient::Stop()
+{
+   if (!Active())
+   {
+      return;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_StopRequested = true;
+   }
+   WakeClientThread();
+   m_WindowCondition.notify_all();
+   m_Thread.join();
+
+   std::vector<IO_CLIENT_COMPLETION_TYPE> completions;
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      while (!m_Pending.empty())
+      {
+         Complete(m_Pending.begin(), IONCL_RESULT_STOPPED, completions);
+      }
+   }
+   for (IO_CLIENT_COMPLETION_TYPE& completion : completions)
+   {
+      completion.callback(completion.response);
+   }
+   m_WindowCondition.notify_all();
+
+   close(m_Sockfd);
+   close(m_WakeFd);
+   m_Sockfd = IONCLInvalidFd;
+   m_WakeFd = IONCLInvalidFd;
+   m_State = IONCL_STATE_INACTIVE;
+}
+
+/******************************************************************************/
+bool IONetworkClient::Send(
+      uint16_t msgId,
+      const uint8_t* data,
+      uint16_t dataBytes,
+      IONetworkClientCallback callback)
+{
+   std::vector<IO_CLIENT_REQUEST_TYPE> requests(1);
+   requests[0].msgId = msgId;
+   requests[0].data.assign(data, data + dataBytes);
+
+   return (SendRequests(requests, [&callback](size_t) { return callback; }));
+}
+
+/******************************************************************************/
+IONetworkClientFuture IONetworkClient::Send(uint16_t msgId, const uint8_t* data, uint16_t dataBytes)
+{
+   auto promise = std::make_shared<std::promise<IO_CLIENT_RESPONSE_TYPE>>();
+   IONetworkClientFuture future = promise->get_future();
+
+   Send(msgId, data, dataBytes,
+         [promise](IO_CLIENT_RESPONSE_TYPE& response)
+         {
+            promise->set_value(std::move(response));
+         });
+
+   return future;
+}
+
+/******************************************************************************/
+bool IONetworkClient::SendBatch(
+      const std::vector<IO_CLIENT_REQUEST_TYPE>& requests,
+      IONetworkClientCallback callback)
+{
+   return (SendRequests(requests, [&callback](size_t) { return callback; }));
+}
+
+/******************************************************************************/
+std::vector<IONetworkClientFuture> IONetworkClient::SendBatch(
+      const std::vector<IO_CLIENT_REQUEST_TYPE>& requests)
+{
+   std::vector<std::shared_ptr<std::promise<IO_CLIENT_RESPONSE_TYPE>>> promises;
+   std::vector<IONetworkClientFuture> futures;
+
+   promises.reserve(requests.size());
+   futures.reserve(requests.size());
+   for (size_t index = 0; index < requests.size(); index++)
+   {
+      promises.push_back(std::make_shared<std::promise<IO_CLIENT_RESPONSE_TYPE>>());
+      futures.push_back(promises.back()->get_future());
+   }
+
+   SendRequests(requests,
+         [&promises](size_t index) -> IONetworkClientCallback
+         {
+            return [promise = promises[index]](IO_CLIENT_RESPONSE_TYPE& response)
+            {
+               promise->set_value(std::move(response));
+            };
+         });
+
+   return futures;
+}
+
+/******************************************************************************/
+bool IONetworkClient::SendRequests(
+      const std::vector<IO_CLIENT_REQUEST_TYPE>& requests,
+      const std::function<IONetworkClientCallback(size_t index)>& callbackFor)
+{
+   std::vector<IO_CLIENT_COMPLETION_TYPE> completions;
+   size_t next = 0;
+   bool success = true;
+
+   while (next < requests.size())
+   {
+      std::array<uint16_t, IONCLBatchDatagrams> sequences;
+      std::array<struct iovec, IONCLBatchDatagrams> iovs;
+      std::array<struct mmsghdr, IONCLBatchDatagrams> headers;
+      uint32_t count = 0;
+
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_WindowCondition.wait(lock,
+            [this] { return m_StopRequested || WindowOpen(); });
+
+      if (m_StopRequested || !Active())
+      {
+         lock.unlock();
+         for (; next < requests.size(); next++)
+         {
+            IO_CLIENT_RESPONSE_TYPE response;
+            response.requestId = requests[next].msgId;
+            callbackFor(next)(response);
+         }
+         return (false);
+      }
+
+      uint64_t nowNs = NowNs();
+      while (next < requests.size() && count < IONCLBatchDatagrams && WindowOpen())
+      {
+         const IO_CLIENT_REQUEST_TYPE& request = requests[next];
+         uint16_t sequence = AddPending(
+               request.msgId,
+               request.data.data(),
+               static_cast<uint16_t>(request.data.size()),
+               callbackFor(next),
+               nowNs);
+         std::vector<uint8_t>& message = m_Pending[sequence].message;
+
+         sequences[count] = sequence;
+         iovs[count].iov_base = message.data();
+         iovs[count].iov_len = message.size();
+         memset(&headers[count], 0, sizeof(headers[count]));
+         headers[count].msg_hdr.msg_iov = &iovs[count];
+         headers[count].msg_hdr.msg_iovlen = 1;
+         count++;
+         next++;
+      }
+
+      // Sent under the lock: the client thread must not complete, and so
+      // free, a message the kernel is still reading.
+      int sent = sendmmsg(m_Sockfd, headers.data(), count, 0);
+      uint32_t sentCount = (sent > 0) ? static_cast<uint32_t>(sent) : 0;
+      m_RequestsSent += sentCount;
+
+      for (uint32_t index = sentCount; index < count; index++)
+      {
+         Complete(m_Pending.find(sequences[index]), IONCL_RESULT_SEND_FAILED, completions);
+         success = false;
+      }
+
+      // The client thread sleeps until the earliest deadline it knew of.
+      if (nowNs + m_Options.timeoutMs * IONCLNanosecondsPerMillisecond < m_ThreadWakeNs)
+      {
+         WakeClientThread();
+      }
+   }
+
+   for (IO_CLIENT_COMPLETION_TYPE& completion : completions)
+   {
+      completion.callback(completion.response);
+   }
+
+   return (success);
+}
+
+/******************************************************************************/
+void IONetworkClient::Drain()
+{
+   std::unique_lock<std::mutex> lock(m_Mutex);
+   m_WindowCondition.wait(lock, [this] { return m_Pending.empty() || m_StopRequested; });
+}
+
+/******************************************************************************/
+bool IONetworkClient::WindowOpen()
+{
+   // Called with the mutex held.  The server tells a retransmit from a
+   // new request only within IONRCWindowSize sequences of the newest, so
+   // a request waiting to be retransmitted holds the numbering back.
+   uint16_t oldestBehind = 0;
+
+   for (const auto& pending : m_Pending)
+   {
+      oldestBehind = std::max(oldestBehind, static_cast<uint16_t>(m_NextSequence - pending.first));
+   }
+
+   return (m_Pending.size() < m_Options.window && oldestBehind + 1 < IONRCWindowSize);
+}
+
+/******************************************************************************/
+uint16_t IONetworkClient::NextSequence()
+{
+   // 0 tells the server the request is not numbered.
+   while (m_NextSequence == 0 || m_Pending.count(m_NextSequence) != 0)
+   {
+      m_NextSequence++;
+   }
+
+   return m_NextSequence++;
+}
+
+/******************************************************************************/
+void IONetworkClient::EncodeRequest(
+      uint16_t msgId,
+      const uint8_t* data,
+      uint16_t dataBytes,
+      uint16_t sequence,
+      std::vector<uint8_t>& message)
+{
+   if (m_Options.compact)
+   {
+      message.resize(IONWCompactHeaderSizeBytes + dataBytes);
+      IONWEncodeCompactHeader(msgId, dataBytes, sequence, message.data());
+      std::copy(data, data + dataBytes, message.data() + IONWCompactHeaderSizeBytes);
+   }
+   else
+   {
+      message.resize(m_theIoNwControlMessageHeaderSizeBytes + dataBytes);
+      IONWEncodeHeader(msgId, dataBytes, message.data());
+      IONWWire<uint16_t>::Put(message.data() + IONWHeaderReservedIndex, sequence);
+      std::copy(data, data + dataBytes, message.data() + m_theIoNwControlMessageHeaderSizeBytes);
+   }
+}
+
+/******************************************************************************/
+uint16_t IONetworkClient::AddPending(
+      uint16_t msgId,
+      const uint8_t* data,
+      uint16_t dataBytes,
+      IONetworkClientCallback callback,
+      uint64_t nowNs)
+{
+   uint16_t sequence = NextSequence();
+   IO_CLIENT_PENDING_TYPE& pending = m_Pending[sequence];
+
+   EncodeRequest(msgId, data, dataBytes, sequence, pending.message);
+   pending.requestId = msgId;
+   pending.attempts = 1;
+   pending.timeoutMs = m_Options.timeoutMs;
+   pending.sentNs = nowNs;
+   pending.deadlineNs = nowNs + pending.timeoutMs * IONCLNanosecondsPerMillisecond;
+   pending.callback = std::move(callback);
+
+   return sequence;
+}
+
+/******************************************************************************/
+void IONetworkClient::Complete(
+      std::map<uint16_t, IO_CLIENT_PENDING_TYPE>::iterator pending,
+      IONetworkClientResultType result,
+      std::vector<IO_CLIENT_COMPLETION_TYPE>& completions)
+{
+   IO_CLIENT_COMPLETION_TYPE completion;
+
+   completion.callback = std::move(pending->second.callback);
+   completion.response.result = result;
+   completion.response.requestId = pending->second.requestId;
+   completion.response.sequence = pending->first;
+   completion.response.attempts = pending->second.attempts;
+
+   completions.push_back(std::move(completion));
+   m_Pending.erase(pending);
+}
+
+/******************************************************************************/
+void IONetworkClient::WakeClientThread()
+{
+   uint64_t one = 1;
+
+   if (write(m_WakeFd, &one, sizeof(one)) < 0)
+   {
+      // Already signalled; the counter is not read yet.
+   }
+}
+
+/******************************************************************************/
+int32_t IONetworkClient::PollTimeoutMs(uint64_t nowNs)
+{
+   uint64_t earliestNs = IONCLNoDeadline;
+
+   for (const auto& pending : m_Pending)
+   {
+      earliestNs = std::min(earliestNs, pending.second.deadlineNs);
+   }
+   m_ThreadWakeNs = earliestNs;
+
+   if (earliestNs == IONCLNoDeadline)
+   {
+      return (-1);
+   }
+   if (earliestNs <= nowNs)
+   {
+      return (0);
+   }
+
+   // Rounded up, a deadline is never taken early.
+   return static_cast<int32_t>(
+         (earliestNs - nowNs + IONCLNanosecondsPerMillisecond - 1) / IONCLNanosecondsPerMillisecond);
+}
+
+/******************************************************************************/
+void IONetworkClient::ClientThread()
+{
+   while (true)
+   {
+      int32_t timeoutMs = 0;
+      {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         if (m_StopRequested)
+         {
+            break;
+         }
+         timeoutMs = PollTimeoutMs(NowNs());
+      }
+
+      struct pollfd pollFds[2];
+      pollFds[0].fd = m_Sockfd;
+      pollFds[0].events = POLLIN;
+      pollFds[1].fd = m_WakeFd;
+      pollFds[1].events = POLLIN;
+
+      if (poll(pollFds, 2, timeoutMs) < 0)
+      {
+         continue;
+      }
+
+      if ((pollFds[1].revents & POLLIN) != 0)
+      {
+         uint64_t count = 0;
+         if (read(m_WakeFd, &count, sizeof(count)) < 0)
+         {
+            // Nothing to read, woken by an earlier write.
+         }
+      }
+
+      std::vector<IO_CLIENT_COMPLETION_TYPE> completions;
+
+      if ((pollFds[0].revents & POLLIN) != 0)
+      {
+         ReceiveResponses(completions);
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(m_Mutex);
+         HandleTimeouts(NowNs(), completions);
+      }
+
+      // Callbacks run without the lock, they may send again.
+      for (IO_CLIENT_COMPLETION_TYPE& completion : completions)
+      {
+         completion.callback(completion.response);
+      }
+      if (!completions.empty())
+      {
+         m_WindowCondition.notify_all();
+      }
+   }
+}
+
+/******************************************************************************/
+void IONetworkClient::ReceiveResponses(std::vector<IO_CLIENT_COMPLETION_TYPE>& completions)
+{
+   std::array<struct iovec, IONCLBatchDatagrams> iovs;
+   std::array<struct mmsghdr, IONCLBatchDatagrams> headers;
+
+   while (true)
+   {
+      for (uint32_t index = 0; index < IONCLBatchDatagrams; index++)
+      {
+         iovs[index].iov_base = &m_ReceiveBuffers[index * IONCLReceiveBufferBytes];
+         iovs[index].iov_len = IONCLReceiveBufferBytes;
+         memset(&headers[index], 0, sizeof(headers[index]));
+         headers[index].msg_hdr.msg_iov = &iovs[index];
+         headers[index].msg_hdr.msg_iovlen = 1;
+      }
+
+      int received = recvmmsg(m_Sockfd, headers.data(), IONCLBatchDatagrams, MSG_DONTWAIT, nullptr);
+      if (received <= 0)
+      {
+         break;
+      }
+
+      uint64_t receiveNs = NowNs();
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      for (int index = 0; index < received; index++)
+      {
+         MatchResponse(
+               &m_ReceiveBuffers[index * IONCLReceiveBufferBytes],
+               static_cast<int32_t>(headers[index].msg_len),
+               receiveNs,
+               completions);
+      }
+
+      if (received < static_cast<int>(IONCLBatchDatagrams))
+      {
+         break;
+      }
+   }
+}
+
+/******************************************************************************/
+void IONetworkClient::MatchResponse(
+      const uint8_t* message,
+      int32_t len,
+      uint64_t receiveNs,
+      std::vector<IO_CLIENT_COMPLETION_TYPE>& completions)
+{
+   uint16_t msgId = 0;
+   uint16_t sequence = 0;
+   const uint8_t* data = nullptr;
+   int32_t dataBytes = 0;
+
+   if (IONWCompactMessage(message, len))
+   {
+      msgId = IONWWire<uint16_t>::Get(message + IONWCompactMsgIdIndex);
+      sequence = IONWWire<uint16_t>::Get(message + IONWCompactSequenceIndex);
+      data = message + IONWCompactHeaderSizeBytes;
+      dataBytes = len - IONWCompactHeaderSizeBytes;
+   }
+   else if (len >= m_theIoNwControlMessageHeaderSizeBytes &&
+      len <= m_theIoNwControlMessageMaximumLengthBytes &&
+      IONWWire<uint64_t>::Get(message) == m_theIoNetworkControlMsgHeaderSyncPattern)
+   {
+      msgId = IONWWire<uint16_t>::Get(message + IONWHeaderMsgIdIndex);
+      sequence = IONWWire<uint16_t>::Get(message + IONWHeaderReservedIndex);
+      data = message + m_theIoNwControlMessageHeaderSizeBytes;
+      dataBytes = len - m_theIoNwControlMessageHeaderSizeBytes;
+   }
+
+   auto pending = m_Pending.find(sequence);
+   if (data == nullptr || pending == m_Pending.end())
+   {
+      // Late answers to requests already timed out land here too.
+      m_UnmatchedResponses++;
+      return;
+   }
+
+   IO_CLIENT_PENDING_TYPE& request = pending->second;
+
+   if (msgId == IONW_CONTROL_MSG_SEGMENT_RSP)
+   {
+      IONW_SEGMENT_RSP_TYPE segment;
+      const uint16_t segmentHeaderBytes = IONWSchema<IONW_SEGMENT_RSP_TYPE>::dataBytes;
+      if (!IONWDecode(data, static_cast<uint16_t>(dataBytes), segment) || segment.segmentCount == 0)
+      {
+         m_UnmatchedResponses++;
+         return;
+      }
+
+      // Every segment but the last has the same length, and the last one
+      // has what the others leave of totalBytes; either gives the offset.
+      uint32_t segmentBytes = static_cast<uint32_t>(dataBytes - segmentHeaderBytes);
+      uint32_t fullSegmentBytes = (segment.segmentIndex + 1 < segment.segmentCount) ?
+            segmentBytes : (segment.totalBytes - segmentBytes) / std::max<uint32_t>(segment.segmentIndex, 1);
+      if (request.segmentSeen.empty())
+      {
+         request.segments.assign(segment.totalBytes, 0);
+         request.segmentSeen.assign(segment.segmentCount, false);
+      }
+      if (segment.segmentIndex >= request.segmentSeen.size() ||
+         request.segmentSeen[segment.segmentIndex])
+      {
+         return;
+      }
+
+      uint32_t offset = segment.segmentIndex * fullSegmentBytes;
+      if (offset + segmentBytes > request.segments.size())
+      {
+         m_UnmatchedResponses++;
+         return;
+      }
+      std::copy(data + segmentHeaderBytes, data + dataBytes, request.segments.begin() + offset);
+      request.segmentSeen[segment.segmentIndex] = true;
+
+      if (++request.segmentsReceived < segment.segmentCount)
+      {
+         return;
+      }
+
+      std::vector<uint8_t> whole = std::move(request.segments);
+      uint64_t sentNs = request.sentNs;
+      Complete(pending, IONCL_RESULT_SUCCESS, completions);
+      completions.back().response.msgId = segment.responseId;
+      completions.back().response.data = std::move(whole);
+      completions.back().response.roundTripNs = receiveNs - sentNs;
+      return;
+   }
+
+   uint64_t sentNs = request.sentNs;
+   Complete(pending, IONCL_RESULT_SUCCESS, completions);
+   completions.back().response.msgId = msgId;
+   completions.back().response.data.assign(data, data + dataBytes);
+   completions.back().response.roundTripNs = receiveNs - sentNs;
+}
+
+/******************************************************************************/
+void IONetworkClient::HandleTimeouts(uint64_t nowNs, std::vector<IO_CLIENT_COMPLETION_TYPE>& completions)
+{
+   auto pending = m_Pending.begin();
+
+   while (pending != m_Pending.end())
+   {
+      IO_CLIENT_PENDING_TYPE& request = pending->second;
+
+      if (request.deadlineNs > nowNs)
+      {
+         pending++;
+         continue;
+      }
+
+      if (request.attempts >= m_Options.attempts)
+      {
+         m_Timeouts++;
+         auto expired = pending++;
+         Complete(expired, IONCL_RESULT_TIMEOUT, completions);
+         continue;
+      }
+
+      // The same sequence number: the server answers a repeat from its
+      // replay cache.
+      request.attempts++;
+      request.timeoutMs = std::min(request.timeoutMs * 2, m_Options.maximumTimeoutMs);
+      request.sentNs = nowNs;
+      request.deadlineNs = nowNs + request.timeoutMs * IONCLNanosecondsPerMillisecond;
+      request.segments.clear();
+      request.segmentSeen.clear();
+      request.segmentsReceived = 0;
+      m_Retransmits++;
+
+      if (send(m_Sockfd, request.message.data(), request.message.size(), 0) < 0)
+      {
+         // Counted as an attempt; the next deadline tries again.
+      }
+      pending++;
+   }
+}
+
+/******************************************************************************/
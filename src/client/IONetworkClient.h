@@ -0,0 +1,289 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkClient.h
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the definitions for the pipelined client of
+   libucrp-client.  Requests are numbered and sent without waiting; up to
+   window of them are in flight at once.  A background thread matches the
+   responses to the requests by the sequence number the server echoes,
+   puts SEGMENT_RSP responses back together, and sends a request again
+   when its response is late, doubling the timeout each attempt.  The
+   server's replay cache answers a retransmitted request without running
+   it twice.
+
+   A request completes through a callback, run on the client thread, or a
+   future.  Messages are encoded with IONetworkControlCodec.h, the codec
+   the server uses:
+
+      IONetworkClient client;
+      client.Start("127.0.0.1");
+      IONW_PING_INTERFACE_TYPE ping;
+      ping.flags = IONW_PING_FLAG_TIMESTAMPS;
+      IO_CLIENT_RESPONSE_TYPE response = client.Send(ping).get();
+
+   PING_INTERFACE without IONW_PING_FLAG_TIMESTAMPS and
+   REQUEST_INTERFACE_CONTROL are answered on the server port, as the first
+   tools expected, and never reach this client; they time out.
+*/
+/******************************************************************************/
+#ifndef io_network_client_h
+#define io_network_client_h
+
+/******************************************************************************/
+/*                              I N C L U D E S                               */
+/******************************************************************************/
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "IONetworkControlPayloads.h"
+#include "IONetworkReplayCache.h"
+
+/******************************************************************************/
+/*                              T Y P E D E F S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef enum
+{
+   IONCL_STATE_INACTIVE,
+   IONCL_STATE_ACTIVE
+} IONetworkClientStateType;
+
+typedef enum
+{
+   IONCL_RESULT_SUCCESS,
+   IONCL_RESULT_TIMEOUT,         // no response to the last attempt
+   IONCL_RESULT_SEND_FAILED,
+   IONCL_RESULT_STOPPED          // the client stopped first
+} IONetworkClientResultType;
+
+}
+
+/******************************************************************************/
+/*                            C O N S T A N T S                               */
+/******************************************************************************/
+namespace MDN
+{
+
+const uint16_t IONCLDefaultServerPort = m_theIoNwControlInterfacePort;
+// The server replays a lost response only while it is among the last
+// IONRCCachedResponses it sent the client, so no more may be in flight.
+// Nor is a request sent while one still pending is IONRCWindowSize
+// sequences behind it: the server would drop that one's retransmits as
+// too old.
+const uint16_t IONCLMaximumWindow = IONRCCachedResponses;
+const uint16_t IONCLDefaultWindow = IONCLMaximumWindow;
+const uint32_t IONCLDefaultTimeoutMs = 100;
+const uint32_t IONCLDefaultMaximumTimeoutMs = 2000;
+const uint32_t IONCLDefaultAttempts = 4;
+// Datagrams per sendmmsg / recvmmsg call.
+const uint32_t IONCLBatchDatagrams = 32;
+
+}
+
+/******************************************************************************/
+/*                         D E C L A R A T I O N S                            */
+/******************************************************************************/
+namespace MDN
+{
+
+typedef struct client_options_struct
+{
+   uint16_t window = IONCLDefaultWindow;             // requests in flight
+   uint32_t timeoutMs = IONCLDefaultTimeoutMs;       // of the first attempt
+   uint32_t maximumTimeoutMs = IONCLDefaultMaximumTimeoutMs;
+   uint32_t attempts = IONCLDefaultAttempts;
+   bool compact = true;                              // version 2 header
+} IO_CLIENT_OPTIONS_TYPE;
+
+typedef struct client_response_struct
+{
+   IONetworkClientResultType result = IONCL_RESULT_STOPPED;
+   uint16_t requestId = 0;
+   uint16_t sequence = 0;
+   uint16_t msgId = 0;           // of a segmented response, its responseId
+   std::vector<uint8_t> data;    // the response data block
+   uint32_t attempts = 0;
+   uint64_t roundTripNs = 0;     // from the last attempt
+} IO_CLIENT_RESPONSE_TYPE;
+
+typedef struct client_request_struct
+{
+   uint16_t msgId = 0;
+   std::vector<uint8_t> data;
+} IO_CLIENT_REQUEST_TYPE;
+
+using IONetworkClientCallback = std::function<void(IO_CLIENT_RESPONSE_TYPE& response)>;
+using IONetworkClientFuture = std::future<IO_CLIENT_RESPONSE_TYPE>;
+
+typedef struct client_pending_struct
+{
+   std::vector<uint8_t> message;  // as sent, for the next attempt
+   uint16_t requestId = 0;
+   uint32_t attempts = 0;
+   uint32_t timeoutMs = 0;
+   uint64_t sentNs = 0;
+   uint64_t deadlineNs = 0;
+   IONetworkClientCallback callback;
+
+   // SEGMENT_RSP parts received so far.
+   std::vector<uint8_t> segments;
+   std::vector<bool> segmentSeen;
+   uint16_t segmentsReceived = 0;
+} IO_CLIENT_PENDING_TYPE;
+
+/******************************************************************************/
+class IONetworkClient
+{
+   public:
+      IONetworkClient(const IO_CLIENT_OPTIONS_TYPE& options = IO_CLIENT_OPTIONS_TYPE());
+      ~IONetworkClient();
+
+      bool Start(const std::string& serverIpAddress, uint16_t serverPort = IONCLDefaultServerPort);
+      // Requests still in flight complete with IONCL_RESULT_STOPPED.
+      void Stop();
+      bool Active();
+
+      // Sends a request; blocks while the window is full.  The callback runs
+      // on the client thread, also when the request fails, so a callback
+      // that sends must not fill the window.  False when the request was
+      // not sent; the callback has then run.
+      bool Send(
+            uint16_t msgId,
+            const uint8_t* data,
+            uint16_t dataBytes,
+            IONetworkClientCallback callback);
+      IONetworkClientFuture Send(uint16_t msgId, const uint8_t* data, uint16_t dataBytes);
+
+      template <typename Payload>
+      bool Send(const Payload& payload, IONetworkClientCallback callback);
+      template <typename Payload>
+      IONetworkClientFuture Send(const Payload& payload);
+
+      // Sends the requests IONCLBatchDatagrams to a system call; the
+      // callback runs once per request.
+      bool SendBatch(
+            const std::vector<IO_CLIENT_REQUEST_TYPE>& requests,
+            IONetworkClientCallback callback);
+      std::vector<IONetworkClientFuture> SendBatch(const std::vector<IO_CLIENT_REQUEST_TYPE>& requests);
+
+      // Waits until no request is in flight.
+      void Drain();
+
+      uint64_t RequestsSent();
+      uint64_t Retransmits();
+      uint64_t Timeouts();
+      uint64_t UnmatchedResponses();
+
+   private:
+      typedef struct completion_struct
+      {
+         IONetworkClientCallback callback;
+         IO_CLIENT_RESPONSE_TYPE response;
+      } IO_CLIENT_COMPLETION_TYPE;
+
+      void ClientThread();
+      bool WindowOpen();
+      uint16_t NextSequence();
+      void EncodeRequest(
+            uint16_t msgId,
+            const uint8_t* data,
+            uint16_t dataBytes,
+            uint16_t sequence,
+            std::vector<uint8_t>& message);
+      uint16_t AddPending(
+            uint16_t msgId,
+            const uint8_t* data,
+            uint16_t dataBytes,
+            IONetworkClientCallback callback,
+            uint64_t nowNs);
+      bool SendRequests(
+            const std::vector<IO_CLIENT_REQUEST_TYPE>& requests,
+            const std::function<IONetworkClientCallback(size_t index)>& callbackFor);
+      void ReceiveResponses(std::vector<IO_CLIENT_COMPLETION_TYPE>& completions);
+      void MatchResponse(
+            const uint8_t* message,
+            int32_t len,
+            uint64_t receiveNs,
+            std::vector<IO_CLIENT_COMPLETION_TYPE>& completions);
+      void HandleTimeouts(uint64_t nowNs, std::vector<IO_CLIENT_COMPLETION_TYPE>& completions);
+      int32_t PollTimeoutMs(uint64_t nowNs);
+      void Complete(
+            std::map<uint16_t, IO_CLIENT_PENDING_TYPE>::iterator pending,
+            IONetworkClientResultType result,
+            std::vector<IO_CLIENT_COMPLETION_TYPE>& completions);
+      void WakeClientThread();
+      static uint64_t NowNs();
+
+      const IO_CLIENT_OPTIONS_TYPE m_Options;
+      IONetworkClientStateType m_State;
+      int32_t m_Sockfd;
+      int32_t m_WakeFd;
+
+      std::map<uint16_t, IO_CLIENT_PENDING_TYPE> m_Pending;
+      uint16_t m_NextSequence;
+      uint64_t m_ThreadWakeNs;       // when the client thread wakes next
+      std::mutex m_Mutex;
+      std::condition_variable m_WindowCondition;
+
+      std::thread m_Thread;
+      bool m_StopRequested;
+
+      std::atomic<uint64_t> m_RequestsSent;
+      std::atomic<uint64_t> m_Retransmits;
+      std::atomic<uint64_t> m_Timeouts;
+      std::atomic<uint64_t> m_UnmatchedResponses;
+
+      // Owned by the client thread.
+      std::vector<uint8_t> m_ReceiveBuffers;
+};
+
+/******************************************************************************/
+/*                 T E M P L A T E  I M P L E M E N T A T I O N               */
+/******************************************************************************/
+template <typename Payload>
+bool IONetworkClient::Send(const Payload& payload, IONetworkClientCallback callback)
+{
+   using Schema = IONWCheckedSchema<Payload>;
+   std::array<uint8_t, Schema::dataBytes> data = {};
+
+   Schema::Fields::Encode(payload, data.data());
+
+   return (Send(static_cast<uint16_t>(Schema::msgId), data.data(), Schema::dataBytes, std::move(callback)));
+}
+
+/******************************************************************************/
+template <typename Payload>
+IONetworkClientFuture IONetworkClient::Send(const Payload& payload)
+{
+   using Schema = IONWCheckedSchema<Payload>;
+   std::array<uint8_t, Schema::dataBytes> data = {};
+
+   Schema::Fields::Encode(payload, data.data());
+
+   return (Send(static_cast<uint16_t>(Schema::msgId), data.data(), Schema::dataBytes));
+}
+
+}
+
+/******************************************************************************/
+
+#endif /* io_network_client_h */
@@ -57,6 +57,8 @@ int main()
       // In this mode we can shut down the app via a client SHUTDOWN command, or
       // by the the monitor thread calling m_GLResourceMainPtr->AppStop() by
       // exiting this conditional loop here {e.g. due to timeout}.
+      // The timer wheel is driven by the socket thread alone, as in the
+      // other modes; its callbacks use the transport.
       int seconds = 0;
       while (m_GLResourceMainPtr->Active())
       {
@@ -69,8 +71,9 @@ int main()
    else
    {
       // in GLRM_ONE_THREAD_MODE OR GLRM_TWO_THREADS_MODE this main thread is
-      // the socket thread.  It is blocked by ReceiveMessage in the UdpHelper,
-      // until the client sends a SHUTDOWN message. So nothing to do here.
+      // the socket thread.  It is blocked polling the UdpHelper socket and the
+      // timer wheel, until the client sends a SHUTDOWN message. So nothing to
+      // do here.
    }
 
    m_GLResourceMainPtr->AppStop();
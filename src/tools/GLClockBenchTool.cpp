@@ -0,0 +1,200 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLClockBenchTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-clockbench tool.  It
+   measures the cost of GLTimeHelper::GetTimeInNs() for every clock source,
+   checks that each source never steps back, and tracks how far each one
+   drifts from CLOCK_MONOTONIC over a run.
+
+   usage: ucrp-clockbench [-n calls] [-d seconds]
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <cstdint>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "GLTimeHelper.h"
+#include "GLTscClock.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint64_t GLCBDefaultCalls = 10000000;
+static const uint32_t GLCBDefaultDriftSeconds = 5;
+static const uint32_t GLCBDriftSampleIntervalUs = 100000;
+
+static const GLTHClockSourceType m_theClockSources[] =
+{
+   GLTH_CLOCK_SOURCE_REALTIME,
+   GLTH_CLOCK_SOURCE_MONOTONIC,
+   GLTH_CLOCK_SOURCE_MONOTONIC_COARSE,
+   GLTH_CLOCK_SOURCE_TSC,
+};
+static const uint32_t GLCBNumberOfSources =
+      sizeof(m_theClockSources) / sizeof(m_theClockSources[0]);
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef struct clock_bench_struct
+{
+   std::unique_ptr<GLTimeHelper> timeHelper;
+   uint64_t startNs;
+   uint64_t monotonicStartNs;
+   int64_t lastOffsetNs;
+   int64_t maximumOffsetNs;
+   uint64_t backwardSteps;
+} CLOCK_BENCH_TYPE;
+
+/******************************************************************************/
+static uint64_t MonotonicNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_MONOTONIC, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * GLTimeHelper::m_theNanosecondsPerSecond +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
+/******************************************************************************/
+static void MeasureCost(
+      CLOCK_BENCH_TYPE& bench,
+      GLTHClockSourceType source,
+      uint64_t calls)
+{
+   GLTimeHelper& timeHelper = *bench.timeHelper;
+   uint64_t previousNs = timeHelper.GetTimeInNs();
+   uint64_t startNs = MonotonicNs();
+
+   for (uint64_t call = 0; call < calls; call++)
+   {
+      uint64_t nowNs = timeHelper.GetTimeInNs();
+      if (nowNs < previousNs)
+      {
+         bench.backwardSteps++;
+      }
+      previousNs = nowNs;
+   }
+
+   uint64_t elapsedNs = MonotonicNs() - startNs;
+
+   // A source that is not available runs as the one it fell back to.
+   printf("%-24s as %-24s %8.2f ns/call  %lu backward steps\n",
+         GLTimeHelper::ClockSourceName(source),
+         GLTimeHelper::ClockSourceName(timeHelper.ClockSource()),
+         static_cast<double>(elapsedNs) / static_cast<double>(calls),
+         bench.backwardSteps);
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   uint64_t calls = GLCBDefaultCalls;
+   uint32_t driftSeconds = GLCBDefaultDriftSeconds;
+   int option;
+
+   while ((option = getopt(argc, argv, "n:d:h")) != -1)
+   {
+      switch (option)
+      {
+         case 'n':
+            calls = strtoull(optarg, nullptr, 10);
+            break;
+
+         case 'd':
+            driftSeconds = static_cast<uint32_t>(atoi(optarg));
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr, "usage: %s [-n calls] [-d seconds]\n", argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   GLTscClock* tscClock = GLTscClock::Instance();
+   if (tscClock != nullptr)
+   {
+      printf("Invariant TSC: %.3f MHz\n", static_cast<double>(tscClock->TicksPerSecond()) / 1e6);
+   }
+   else
+   {
+      printf("Invariant TSC: not available, TSC source uses CLOCK_MONOTONIC\n");
+   }
+
+   CLOCK_BENCH_TYPE benches[GLCBNumberOfSources];
+   for (uint32_t index = 0; index < GLCBNumberOfSources; index++)
+   {
+      CLOCK_BENCH_TYPE& bench = benches[index];
+      bench.timeHelper = std::make_unique<GLTimeHelper>(
+            GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START,
+            m_theClockSources[index]);
+      bench.lastOffsetNs = 0;
+      bench.maximumOffsetNs = 0;
+      bench.backwardSteps = 0;
+   }
+
+   printf("\nCost of GetTimeInNs() over %lu calls\n", calls);
+   for (uint32_t index = 0; index < GLCBNumberOfSources; index++)
+   {
+      MeasureCost(benches[index], m_theClockSources[index], calls);
+   }
+
+   printf("\nDrift against CLOCK_MONOTONIC over %u s\n", driftSeconds);
+   for (uint32_t index = 0; index < GLCBNumberOfSources; index++)
+   {
+      CLOCK_BENCH_TYPE& bench = benches[index];
+      bench.monotonicStartNs = MonotonicNs();
+      bench.startNs = bench.timeHelper->GetTimeInNs();
+   }
+
+   uint64_t samples = static_cast<uint64_t>(driftSeconds) * 1000000 / GLCBDriftSampleIntervalUs;
+   for (uint64_t sample = 0; sample < samples; sample++)
+   {
+      usleep(GLCBDriftSampleIntervalUs);
+
+      for (uint32_t index = 0; index < GLCBNumberOfSources; index++)
+      {
+         CLOCK_BENCH_TYPE& bench = benches[index];
+         int64_t elapsedNs = static_cast<int64_t>(bench.timeHelper->GetTimeInNs() - bench.startNs);
+         int64_t monotonicElapsedNs = static_cast<int64_t>(MonotonicNs() - bench.monotonicStartNs);
+
+         bench.lastOffsetNs = elapsedNs - monotonicElapsedNs;
+         if (llabs(bench.lastOffsetNs) > llabs(bench.maximumOffsetNs))
+         {
+            bench.maximumOffsetNs = bench.lastOffsetNs;
+         }
+      }
+   }
+
+   for (uint32_t index = 0; index < GLCBNumberOfSources; index++)
+   {
+      CLOCK_BENCH_TYPE& bench = benches[index];
+      printf("%-24s final offset %+10ld ns  worst offset %+10ld ns\n",
+            GLTimeHelper::ClockSourceName(m_theClockSources[index]),
+            bench.lastOffsetNs,
+            bench.maximumOffsetNs);
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
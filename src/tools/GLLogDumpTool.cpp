@@ -0,0 +1,154 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogDumpTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-logdump tool which recovers
+   the last entries from a memory mapped log ring file left behind by the
+   application, e.g. after a crash or a watchdog reset.
+
+   usage: ucrp-logdump [-n count] <ring file> [<ring file> ...]
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+#include "GLConfigureSystemModules.h"
+#include "GLLogRing.h"
+#include "GLTimeHelper.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+static const std::string& ModuleName(uint16_t moduleId)
+{
+   auto iter = m_theModuleNameMap.find(static_cast<GLCFModuleIds>(moduleId));
+   return (iter != m_theModuleNameMap.end()) ? iter->second : GLCFUnknownModuleName;
+}
+
+/******************************************************************************/
+static const char* SourceName(GLLRSourceType source)
+{
+   switch (source)
+   {
+      case GLLR_SOURCE_EVENT_LOG:
+         return "EVENT LOG";
+      case GLLR_SOURCE_ERROR_LOG:
+         return "ERROR LOG";
+      default:
+         return "UNKNOWN LOG";
+   }
+}
+
+/******************************************************************************/
+static bool DumpRingFile(const std::string& path, uint64_t maxEntries)
+{
+   GLLogRing ring;
+   char timeStamp[GLTHTimeStampBufferSize];
+
+   if (!ring.MapFileReadOnly(path))
+   {
+      fprintf(stderr, "ERROR: %s is not a valid log ring file.\n", path.c_str());
+      return (false);
+   }
+
+   auto entries = ring.RecoverEntries();
+   size_t first = 0;
+   if (maxEntries > 0 && entries->size() > maxEntries)
+   {
+      first = entries->size() - maxEntries;
+   }
+
+   printf("\n\n***** %s: %s *****\n", SourceName(ring.Source()), path.c_str());
+   printf("capacity %u, generation %lu, next sequence %lu, recovered %zu\n\n",
+         ring.Capacity(),
+         ring.Generation(),
+         ring.NextSequence(),
+         entries->size());
+
+   uint64_t generation = 0;
+   for (size_t index = first; index < entries->size(); index++)
+   {
+      GLLogRingEntry& entry = (*entries)[index];
+      if (entry.m_Generation != generation)
+      {
+         generation = entry.m_Generation;
+         printf("----- generation %lu -----\n", generation);
+      }
+
+      GLTimeHelper::FormatNsIntoTimeStampUs(entry.m_TimeStampNs, timeStamp, sizeof(timeStamp));
+      printf("%10lu  %-28s %-45s L%u  %s\n",
+            entry.m_Sequence,
+            timeStamp,
+            ModuleName(entry.m_ModuleId).c_str(),
+            entry.m_Level,
+            entry.m_Text.c_str());
+   }
+
+   // Gaps inside the recovered range are records that were torn by the crash.
+   if (!entries->empty())
+   {
+      uint64_t span = entries->back().m_Sequence - entries->front().m_Sequence + 1;
+      if (span > entries->size())
+      {
+         printf("\n%lu record(s) missing or torn.\n", span - entries->size());
+      }
+   }
+
+   return (true);
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   uint64_t maxEntries = 0;
+   int option;
+
+   while ((option = getopt(argc, argv, "n:h")) != -1)
+   {
+      switch (option)
+      {
+         case 'n':
+            maxEntries = strtoull(optarg, nullptr, 10);
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr, "usage: %s [-n count] <ring file> [<ring file> ...]\n", argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   if (optind >= argc)
+   {
+      fprintf(stderr, "usage: %s [-n count] <ring file> [<ring file> ...]\n", argv[0]);
+      return 1;
+   }
+
+   int result = 0;
+   for (int index = optind; index < argc; index++)
+   {
+      if (!DumpRingFile(argv[index], maxEntries))
+      {
+         result = 1;
+      }
+   }
+
+   return result;
+}
+
+/******************************************************************************/
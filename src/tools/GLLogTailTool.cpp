@@ -0,0 +1,275 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLLogTailTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-tail tool.  It attaches read
+   only to the event / error log rings the server publishes in POSIX shared
+   memory and follows new entries as they are logged.
+
+   usage: ucrp-tail [-e | -r] [-m module] [-l level] [-n backlog] [-o]
+      -e          event log only
+      -r          error log only
+      -m module   module id or part of the module name
+      -l level    only entries at this level
+      -n backlog  entries already in the ring to show first (default 10)
+      -o          print the backlog and exit, do not follow
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+#include "GLConfigureSystemModules.h"
+#include "GLErrorLog.h"
+#include "GLEventLog.h"
+#include "GLLogRing.h"
+#include "GLTimeHelper.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint32_t GLTLPollIntervalUs = 20000;
+static const int32_t GLTLAnyLevel = -1;
+
+/******************************************************************************/
+/*       G L O B A L  V A R S                                                 */
+/******************************************************************************/
+static volatile sig_atomic_t m_StopRequested = 0;
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef struct tail_filter_struct
+{
+   std::string module;
+   int32_t level = GLTLAnyLevel;
+} TAIL_FILTER_TYPE;
+
+typedef struct tail_source_struct
+{
+   const char* tag;
+   std::string name;
+   GLLogRing ring;
+   uint64_t nextSequence = 0;
+   uint64_t lostEntries = 0;
+} TAIL_SOURCE_TYPE;
+
+/******************************************************************************/
+static void SignalHandler(int)
+{
+   m_StopRequested = 1;
+}
+
+/******************************************************************************/
+static const std::string& ModuleName(uint16_t moduleId)
+{
+   auto iter = m_theModuleNameMap.find(static_cast<GLCFModuleIds>(moduleId));
+   return (iter != m_theModuleNameMap.end()) ? iter->second : GLCFUnknownModuleName;
+}
+
+/******************************************************************************/
+static bool FilterMatch(TAIL_FILTER_TYPE& filter, GLLogRingEntry& entry)
+{
+   if (filter.level != GLTLAnyLevel && entry.m_Level != filter.level)
+   {
+      return (false);
+   }
+
+   if (!filter.module.empty())
+   {
+      char* end = nullptr;
+      unsigned long moduleId = strtoul(filter.module.c_str(), &end, 0);
+      if (end != nullptr && *end == '\0')
+      {
+         return (entry.m_ModuleId == moduleId);
+      }
+
+      std::string name = ModuleName(entry.m_ModuleId);
+      std::string wanted = filter.module;
+      std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+      std::transform(wanted.begin(), wanted.end(), wanted.begin(), ::toupper);
+      return (name.find(wanted) != std::string::npos);
+   }
+
+   return (true);
+}
+
+/******************************************************************************/
+static void PrintEntry(TAIL_SOURCE_TYPE& source, GLLogRingEntry& entry)
+{
+   char timeStamp[GLTHTimeStampBufferSize];
+
+   GLTimeHelper::FormatNsIntoTimeStampUs(entry.m_TimeStampNs, timeStamp, sizeof(timeStamp));
+   printf("%s %-28s %-45s L%u  %s\n",
+         source.tag,
+         timeStamp,
+         ModuleName(entry.m_ModuleId).c_str(),
+         entry.m_Level,
+         entry.m_Text.c_str());
+}
+
+/******************************************************************************/
+static bool FollowSource(TAIL_SOURCE_TYPE& source, TAIL_FILTER_TYPE& filter)
+{
+   bool printed = false;
+
+   if (!source.ring.Mapped() &&
+      !source.ring.MapSharedMemoryReadOnly(source.name))
+   {
+      return (printed);
+   }
+
+   uint64_t nextSequence = source.ring.NextSequence();
+   uint64_t capacity = source.ring.Capacity();
+
+   if (nextSequence < source.nextSequence)
+   {
+      // The segment was recreated by a new server instance.
+      source.nextSequence = 0;
+   }
+
+   if (nextSequence - source.nextSequence > capacity)
+   {
+      source.lostEntries += nextSequence - source.nextSequence - capacity;
+      source.nextSequence = nextSequence - capacity;
+   }
+
+   while (source.nextSequence < nextSequence)
+   {
+      GLLogRingEntry entry;
+      if (source.ring.ReadRecord(source.nextSequence, entry))
+      {
+         if (FilterMatch(filter, entry))
+         {
+            PrintEntry(source, entry);
+            printed = true;
+         }
+      }
+      else
+      {
+         // Overwritten by the server while we were reading it.
+         source.lostEntries++;
+      }
+      source.nextSequence++;
+   }
+
+   return (printed);
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   bool followEvents = true;
+   bool followErrors = true;
+   bool follow = true;
+   uint64_t backlog = 10;
+   TAIL_FILTER_TYPE filter;
+   int option;
+
+   while ((option = getopt(argc, argv, "erm:l:n:oh")) != -1)
+   {
+      switch (option)
+      {
+         case 'e':
+            followErrors = false;
+            break;
+
+         case 'r':
+            followEvents = false;
+            break;
+
+         case 'm':
+            filter.module = optarg;
+            break;
+
+         case 'l':
+            filter.level = atoi(optarg);
+            break;
+
+         case 'n':
+            backlog = strtoull(optarg, nullptr, 10);
+            break;
+
+         case 'o':
+            follow = false;
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr,
+                  "usage: %s [-e | -r] [-m module] [-l level] [-n backlog] [-o]\n",
+                  argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   struct sigaction action;
+   std::memset(&action, 0, sizeof(action));
+   action.sa_handler = SignalHandler;
+   sigaction(SIGINT, &action, nullptr);
+   sigaction(SIGTERM, &action, nullptr);
+
+   TAIL_SOURCE_TYPE sources[2];
+   sources[0].tag = "EVNT";
+   sources[0].name = GLEVSharedLogName;
+   sources[1].tag = "ERR ";
+   sources[1].name = GLELSharedLogName;
+   bool enabled[2] = {followEvents, followErrors};
+
+   for (int index = 0; index < 2; index++)
+   {
+      if (enabled[index] && sources[index].ring.MapSharedMemoryReadOnly(sources[index].name))
+      {
+         uint64_t nextSequence = sources[index].ring.NextSequence();
+         sources[index].nextSequence = (nextSequence > backlog) ? nextSequence - backlog : 0;
+      }
+   }
+
+   do
+   {
+      for (int index = 0; index < 2; index++)
+      {
+         if (enabled[index])
+         {
+            FollowSource(sources[index], filter);
+         }
+      }
+      fflush(stdout);
+
+      if (follow)
+      {
+         usleep(GLTLPollIntervalUs);
+      }
+   } while (follow && !m_StopRequested);
+
+   for (int index = 0; index < 2; index++)
+   {
+      if (enabled[index] && sources[index].lostEntries > 0)
+      {
+         fprintf(stderr, "%s: %lu entries overwritten before they were read.\n",
+               sources[index].name.c_str(),
+               sources[index].lostEntries);
+      }
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
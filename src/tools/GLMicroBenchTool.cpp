@@ -0,0 +1,357 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLMicroBenchTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-bench tool.  It times the
+   hot path components one at a time and reports, for each, the cost in ns
+   per operation and the heap allocations per operation, so a regression
+   can be pinned on one component.  Allocations are counted by replacing
+   the global operator new in this executable.
+
+   The components run inside a simulated GLResourceMain, as in ucrp-sim:
+   virtual clock, in-memory transport, logs that are not published.  The
+   virtual clock does not move, so the "repeated" log benchmarks hit the
+   repeat filter on every call; the "distinct" ones format a new text per
+   call and include that snprintf.  Multi-threaded benchmarks report the
+   cost per operation seen by each thread.
+
+      validate         IONetworkControlMessage::ValidateReceivedMessage
+      decode           the IONetworkControlMessage constructor
+      name             IONetworkControlMessage::MessageName
+      event            GLEventLog::LogEvent, 1 to -t threads
+      error            GLErrorLog::LogError, 1 to -t threads
+      time             GLTimeHelper::GetTimeInNs
+      timestamp        GLTimeHelper::ConvertNsIntoTimeStampUs
+      dispatch         PRProtocolDomainManager::ProcessMessage
+      receive          a datagram through ProcessReceivedMessages
+
+   usage: ucrp-bench [-n operations] [-t threads] [-b filter]
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "GLErrorLog.h"
+#include "GLEventLog.h"
+#include "GLResourceMain.h"
+#include "GLTimeHelper.h"
+#include "GLVirtualClock.h"
+#include "IONetworkControlCodec.h"
+#include "IONetworkControlInterfaceManager.h"
+#include "IONetworkControlMessage.h"
+#include "IONetworkControlPayloads.h"
+#include "IONetworkMemoryTransport.h"
+#include "PRProtocolDomainManager.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint64_t GLMBDefaultOperations = 100000;
+static const uint32_t GLMBDefaultMaximumThreads = 4;
+static const char* GLMBSourceIp = "127.0.0.1";
+static const uint64_t GLMBNanosecondsPerSecond = 1000000000;
+
+/******************************************************************************/
+/*       A L L O C A T I O N  C O U N T I N G                                 */
+/******************************************************************************/
+static std::atomic<uint64_t> m_theAllocations(0);
+
+void* operator new(size_t size)
+{
+   m_theAllocations.fetch_add(1, std::memory_order_relaxed);
+
+   void* memory = malloc((size > 0) ? size : 1);
+   if (memory == nullptr)
+   {
+      throw std::bad_alloc();
+   }
+
+   return (memory);
+}
+
+void* operator new[](size_t size)
+{
+   return (operator new(size));
+}
+
+void operator delete(void* memory) noexcept
+{
+   free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+   free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+   free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+   free(memory);
+}
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef struct bench_options_struct
+{
+   uint64_t operations = GLMBDefaultOperations;
+   uint32_t maximumThreads = GLMBDefaultMaximumThreads;
+   std::string filter;
+} BENCH_OPTIONS_TYPE;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static uint64_t MonotonicNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_MONOTONIC, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * GLMBNanosecondsPerSecond +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
+/******************************************************************************/
+// Keeps the compiler from dropping a result that is otherwise unused.
+template <typename Value>
+static void KeepResult(const Value& value)
+{
+   asm volatile("" : : "g"(&value) : "memory");
+}
+
+/******************************************************************************/
+// Runs operation(thread, index) operations times on each of threads
+// threads, started together, and prints ns and allocations per operation.
+template <typename Operation>
+static void Run(
+      const BENCH_OPTIONS_TYPE& options,
+      const char* name,
+      uint32_t threads,
+      Operation operation)
+{
+   if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos)
+   {
+      return;
+   }
+
+   std::atomic<uint32_t> ready(0);
+   std::atomic<bool> go(false);
+   std::vector<uint64_t> elapsedNs(threads, 0);
+   std::vector<std::thread> workers;
+
+   auto worker = [&](uint32_t thread)
+   {
+      ready++;
+      while (!go.load())
+      {
+      }
+
+      uint64_t startNs = MonotonicNs();
+      for (uint64_t index = 0; index < options.operations; index++)
+      {
+         operation(thread, index);
+      }
+      elapsedNs[thread] = MonotonicNs() - startNs;
+   };
+
+   for (uint32_t thread = 1; thread < threads; thread++)
+   {
+      workers.emplace_back(worker, thread);
+   }
+   while (ready.load() + 1 < threads)
+   {
+   }
+
+   uint64_t allocationsBefore = m_theAllocations.load();
+   go = true;
+   worker(0);
+   for (std::thread& thread : workers)
+   {
+      thread.join();
+   }
+   uint64_t allocations = m_theAllocations.load() - allocationsBefore;
+
+   uint64_t totalNs = 0;
+   for (uint64_t threadNs : elapsedNs)
+   {
+      totalNs += threadNs;
+   }
+
+   double totalOperations = static_cast<double>(options.operations) * threads;
+   printf("%-28s %3u %12.1f %12.2f\n",
+         name,
+         threads,
+         static_cast<double>(totalNs) / totalOperations,
+         static_cast<double>(allocations) / totalOperations);
+}
+
+/******************************************************************************/
+static void RunLogBenchmarks(const BENCH_OPTIONS_TYPE& options, GLResourceMain& resource)
+{
+   GLEventLog& eventLog = resource.EventLog();
+   GLErrorLog& errorLog = resource.ErrorLog();
+
+   for (uint32_t threads = 1; threads <= options.maximumThreads; threads *= 2)
+   {
+      Run(options, "event repeated", threads, [&](uint32_t, uint64_t)
+      {
+         eventLog.LogEvent(GLCF_NON_SYSTEM_MODULE_ID, "bench event", GL_EVENT_LEVEL_DEFAULT);
+      });
+      Run(options, "event distinct", threads, [&](uint32_t thread, uint64_t index)
+      {
+         char text[GLEVEEventMaximumLengthChars];
+         snprintf(text, sizeof(text), "bench event %u %lu", thread, index);
+         eventLog.LogEvent(GLCF_NON_SYSTEM_MODULE_ID, text, GL_EVENT_LEVEL_DEFAULT);
+      });
+      Run(options, "error repeated", threads, [&](uint32_t, uint64_t)
+      {
+         errorLog.LogError(GLCF_NON_SYSTEM_MODULE_ID, "bench error", GL_ERROR_LEVEL_DEFAULT);
+      });
+      Run(options, "error distinct", threads, [&](uint32_t thread, uint64_t index)
+      {
+         char text[GLELErrorMaximumLengthChars];
+         snprintf(text, sizeof(text), "bench error %u %lu", thread, index);
+         errorLog.LogError(GLCF_NON_SYSTEM_MODULE_ID, text, GL_ERROR_LEVEL_DEFAULT);
+      });
+   }
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   BENCH_OPTIONS_TYPE options;
+   int option;
+
+   while ((option = getopt(argc, argv, "n:t:b:h")) != -1)
+   {
+      switch (option)
+      {
+         case 'n':
+            options.operations = std::max<uint64_t>(1, strtoull(optarg, nullptr, 10));
+            break;
+
+         case 't':
+            options.maximumThreads = std::max<uint32_t>(1, static_cast<uint32_t>(atoi(optarg)));
+            break;
+
+         case 'b':
+            options.filter = optarg;
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr, "usage: %s [-n operations] [-t threads] [-b filter]\n", argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   GLVirtualClock virtualClock;
+   auto transportPtr = std::make_unique<IONetworkMemoryTransport>();
+   IONetworkMemoryTransport& transport = *transportPtr;
+   GLResourceMain resource(virtualClock, std::move(transportPtr));
+
+   resource.AppStart();
+
+   auto ping = IONWEncode(IONW_PING_INTERFACE_TYPE());
+   auto compactPing = IONWEncodeCompact(IONW_PING_INTERFACE_TYPE(), 0);
+   int32_t pingBytes = static_cast<int32_t>(ping.size());
+   int32_t compactPingBytes = static_cast<int32_t>(compactPing.size());
+
+   printf("%-28s %3s %12s %12s\n", "benchmark", "thr", "ns/op", "allocs/op");
+
+   Run(options, "validate v1", 1, [&](uint32_t, uint64_t)
+   {
+      KeepResult(IONetworkControlMessage::ValidateReceivedMessage(ping.data(), pingBytes));
+   });
+   Run(options, "validate v2", 1, [&](uint32_t, uint64_t)
+   {
+      KeepResult(IONetworkControlMessage::ValidateReceivedMessage(compactPing.data(), compactPingBytes));
+   });
+   Run(options, "decode v1", 1, [&](uint32_t, uint64_t)
+   {
+      IONetworkControlMessage message(ping.data(), pingBytes);
+      KeepResult(message);
+   });
+   Run(options, "decode v2", 1, [&](uint32_t, uint64_t)
+   {
+      IONetworkControlMessage message(compactPing.data(), compactPingBytes);
+      KeepResult(message);
+   });
+   Run(options, "name", 1, [&](uint32_t, uint64_t index)
+   {
+      uint16_t msgId = static_cast<uint16_t>(index % (IONW_CONTROL_MSG_BATCH + 1));
+      KeepResult(IONetworkControlMessage::MessageName(msgId));
+   });
+
+   GLTimeHelper& timeHelper = resource.TimeHelper();
+   GLTimeHelper wallClock(GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START, GLTH_CLOCK_SOURCE_MONOTONIC);
+   Run(options, "time virtual", 1, [&](uint32_t, uint64_t)
+   {
+      KeepResult(timeHelper.GetTimeInNs());
+   });
+   Run(options, "time monotonic", 1, [&](uint32_t, uint64_t)
+   {
+      KeepResult(wallClock.GetTimeInNs());
+   });
+   Run(options, "timestamp", 1, [&](uint32_t, uint64_t index)
+   {
+      KeepResult(timeHelper.ConvertNsIntoTimeStampUs(index * 1000));
+   });
+
+   RunLogBenchmarks(options, resource);
+
+   // The handlers answer through the memory transport; its queue is emptied
+   // as it goes so that it does not start dropping.
+   IO_MEMORY_DATAGRAM_TYPE datagram;
+   auto pingMessage = std::make_shared<IONetworkControlMessage>(ping.data(), pingBytes);
+   pingMessage->SetSource(GLMBSourceIp, SOCKUDP_NULL_PORT);
+   Run(options, "dispatch ping", 1, [&](uint32_t, uint64_t)
+   {
+      resource.ProtocolManager().ProcessMessage(pingMessage);
+      while (transport.TakeSentMessage(datagram))
+      {
+      }
+   });
+   Run(options, "receive ping", 1, [&](uint32_t, uint64_t)
+   {
+      transport.InjectMessage(ping.data(), pingBytes, GLMBSourceIp);
+      resource.InterfaceManager().ProcessReceivedMessages();
+      while (transport.TakeSentMessage(datagram))
+      {
+      }
+   });
+
+   resource.AppStop();
+
+   return 0;
+}
+
+/******************************************************************************/
@@ -0,0 +1,232 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLRemoteLogCollectorTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-logcollector tool.  It
+   receives the frames sent by the GLRemoteLogShipper, prints the entries and
+   reports lost frames / entries from the frame and entry sequence numbers.
+
+   usage: ucrp-logcollector [-p port] [-q]
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <arpa/inet.h>
+#include <csignal>
+#include <cstring>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "GLConfigureSystemModules.h"
+#include "GLRemoteLogShipper.h"
+#include "GLTimeHelper.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*       G L O B A L  V A R S                                                 */
+/******************************************************************************/
+static volatile sig_atomic_t m_StopRequested = 0;
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef struct collector_stats_struct
+{
+   uint64_t frames = 0;
+   uint64_t entries = 0;
+   uint64_t lostFrames = 0;
+   uint64_t lostEntries = 0;
+   uint64_t droppedEntries = 0;
+   uint64_t badFrames = 0;
+   bool first = true;
+   uint32_t expectedFrameSequence = 0;
+   uint32_t expectedEntrySequence = 0;
+} COLLECTOR_STATS_TYPE;
+
+/******************************************************************************/
+static void SignalHandler(int)
+{
+   m_StopRequested = 1;
+}
+
+/******************************************************************************/
+static uint64_t ReadBigEndian(const uint8_t* location, uint32_t bytes)
+{
+   uint64_t value = 0;
+   while (bytes-- > 0)
+   {
+      value = (value << 8) | *location++;
+   }
+   return value;
+}
+
+/******************************************************************************/
+static const std::string& ModuleName(uint16_t moduleId)
+{
+   auto iter = m_theModuleNameMap.find(static_cast<GLCFModuleIds>(moduleId));
+   return (iter != m_theModuleNameMap.end()) ? iter->second : GLCFUnknownModuleName;
+}
+
+/******************************************************************************/
+static void ProcessFrame(
+      const uint8_t* frame,
+      size_t len,
+      COLLECTOR_STATS_TYPE& stats,
+      bool quiet)
+{
+   if (len < GLRLFrameHeaderSizeBytes ||
+      ReadBigEndian(&frame[0], 2) != GLRLFrameMagic ||
+      frame[2] != GLRLFrameVersion)
+   {
+      stats.badFrames++;
+      return;
+   }
+
+   uint32_t frameSequence = ReadBigEndian(&frame[4], 4);
+   uint32_t entrySequence = ReadBigEndian(&frame[8], 4);
+   uint16_t entryCount = ReadBigEndian(&frame[12], 2);
+   uint16_t dropped = ReadBigEndian(&frame[14], 2);
+
+   if (!stats.first)
+   {
+      stats.lostFrames += static_cast<uint32_t>(frameSequence - stats.expectedFrameSequence);
+      stats.lostEntries += static_cast<uint32_t>(entrySequence - stats.expectedEntrySequence);
+   }
+   stats.first = false;
+   stats.expectedFrameSequence = frameSequence + 1;
+   stats.expectedEntrySequence = entrySequence + entryCount;
+   stats.frames++;
+   stats.droppedEntries += dropped;
+
+   size_t offset = GLRLFrameHeaderSizeBytes;
+   for (uint16_t index = 0; index < entryCount; index++)
+   {
+      if (offset + GLRLEntryHeaderSizeBytes > len)
+      {
+         stats.badFrames++;
+         return;
+      }
+
+      uint64_t ts = ReadBigEndian(&frame[offset], 8);
+      uint16_t moduleId = ReadBigEndian(&frame[offset + 8], 2);
+      uint8_t source = frame[offset + 10];
+      uint8_t level = frame[offset + 11];
+      uint8_t textLength = frame[offset + 12];
+      offset += GLRLEntryHeaderSizeBytes;
+
+      if (offset + textLength > len)
+      {
+         stats.badFrames++;
+         return;
+      }
+
+      if (!quiet)
+      {
+         char timeStamp[GLTHTimeStampBufferSize];
+         GLTimeHelper::FormatNsIntoTimeStampUs(ts, timeStamp, sizeof(timeStamp));
+         printf("%10u  %-28s %-45s %s L%u  %.*s\n",
+               entrySequence + index,
+               timeStamp,
+               ModuleName(moduleId).c_str(),
+               (source == GLRL_SOURCE_ERROR_LOG) ? "ERR " : "EVNT",
+               level,
+               textLength,
+               reinterpret_cast<const char*>(&frame[offset]));
+      }
+      offset += textLength;
+      stats.entries++;
+   }
+
+   if (dropped > 0 && !quiet)
+   {
+      printf("*** sender dropped %u entries ***\n", dropped);
+   }
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   uint16_t port = GLRLCollectorPort;
+   bool quiet = false;
+   int option;
+
+   while ((option = getopt(argc, argv, "p:qh")) != -1)
+   {
+      switch (option)
+      {
+         case 'p':
+            port = static_cast<uint16_t>(atoi(optarg));
+            break;
+
+         case 'q':
+            quiet = true;
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr, "usage: %s [-p port] [-q]\n", argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   int sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+   struct sockaddr_in addr;
+   std::memset(&addr, 0, sizeof(addr));
+   addr.sin_family = AF_INET;
+   addr.sin_addr.s_addr = htonl(INADDR_ANY);
+   addr.sin_port = htons(port);
+
+   if (sockfd < 0 || bind(sockfd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+   {
+      fprintf(stderr, "ERROR: cannot bind collector port %u.\n", port);
+      return 1;
+   }
+
+   struct sigaction action;
+   std::memset(&action, 0, sizeof(action));
+   action.sa_handler = SignalHandler;
+   sigaction(SIGINT, &action, nullptr);
+   sigaction(SIGTERM, &action, nullptr);
+
+   printf("ucrp-logcollector listening on port %u\n", port);
+
+   COLLECTOR_STATS_TYPE stats;
+   uint8_t frame[65536];
+
+   while (!m_StopRequested)
+   {
+      ssize_t len = recv(sockfd, frame, sizeof(frame), 0);
+      if (len > 0)
+      {
+         ProcessFrame(frame, static_cast<size_t>(len), stats, quiet);
+         fflush(stdout);
+      }
+   }
+
+   printf("\nframes %lu, entries %lu, lost frames %lu, lost entries %lu, "
+         "sender dropped %lu, bad frames %lu\n",
+         stats.frames,
+         stats.entries,
+         stats.lostFrames,
+         stats.lostEntries,
+         stats.droppedEntries,
+         stats.badFrames);
+
+   close(sockfd);
+   return 0;
+}
+
+/******************************************************************************/
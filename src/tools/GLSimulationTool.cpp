@@ -0,0 +1,335 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file GLSimulationTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-sim tool.  It runs a
+   GLResourceMain on a virtual clock and an in-memory transport and feeds it
+   a command stream, either generated or read from a script.  Virtual time
+   only moves to each command's scheduled time, so the log timestamps,
+   timer expiries and responses of a run are the same on every replay; the
+   response checksum printed at the end shows that.  The wall clock cost of
+   processing each command is measured separately.
+
+   Script lines are "<time_us> <message_id> [source_ip]", time relative to
+   the start of the run and not decreasing, message id in decimal or 0x hex.
+   '#' starts a comment.
+
+   usage: ucrp-sim [-n commands] [-i interval_us] [-m message_id]
+                   [-s script] [-x speed] [-v]
+      -n commands     generated commands (default 100000)
+      -i interval_us  virtual time between generated commands (default 100)
+      -m message_id   generated message id (default PING_INTERFACE)
+      -s script       replay this script instead of generating commands
+      -x speed        pace against the wall clock at this multiple of
+                      virtual time, 0 runs as fast as possible (default 0)
+      -v              print the event and error logs at the end
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "GLErrorLog.h"
+#include "GLEventLog.h"
+#include "GLResourceMain.h"
+#include "GLTimeHelper.h"
+#include "GLTimerWheel.h"
+#include "GLVirtualClock.h"
+#include "IONetworkControlCodec.h"
+#include "IONetworkControlInterfaceManager.h"
+#include "IONetworkControlMessage.h"
+#include "IONetworkMemoryTransport.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const uint64_t GLSMDefaultCommands = 100000;
+static const uint64_t GLSMDefaultIntervalUs = 100;
+static const char* GLSMDefaultSourceIp = "127.0.0.1";
+static const uint64_t GLSMChecksumOffsetBasis = 0xcbf29ce484222325ULL;
+static const uint64_t GLSMChecksumPrime = 0x100000001b3ULL;
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef struct sim_command_struct
+{
+   uint64_t timeNs;
+   uint16_t messageId;
+   std::string sourceIp;
+} SIM_COMMAND_TYPE;
+
+typedef struct sim_result_struct
+{
+   uint64_t commands = 0;
+   uint64_t responses = 0;
+   uint64_t checksum = GLSMChecksumOffsetBasis;
+   std::vector<uint32_t> processingNs;
+} SIM_RESULT_TYPE;
+
+/******************************************************************************/
+static bool ReadScript(const char* path, std::vector<SIM_COMMAND_TYPE>& commands)
+{
+   FILE* file = fopen(path, "r");
+
+   if (file == nullptr)
+   {
+      fprintf(stderr, "cannot open %s\n", path);
+      return (false);
+   }
+
+   char line[256];
+   uint32_t lineNumber = 0;
+   uint64_t previousNs = 0;
+   bool success = true;
+
+   while (success && fgets(line, sizeof(line), file) != nullptr)
+   {
+      lineNumber++;
+
+      char* comment = strchr(line, '#');
+      if (comment != nullptr)
+      {
+         *comment = '\0';
+      }
+
+      unsigned long long timeUs;
+      unsigned int messageId;
+      char sourceIp[64] = {0};
+      int fields = sscanf(line, "%llu %i %63s", &timeUs, &messageId, sourceIp);
+
+      if (fields <= 0)
+      {
+         continue;
+      }
+
+      SIM_COMMAND_TYPE command;
+      command.timeNs = static_cast<uint64_t>(timeUs) * 1000;
+      command.messageId = static_cast<uint16_t>(messageId);
+      command.sourceIp = (fields == 3) ? sourceIp : GLSMDefaultSourceIp;
+
+      if (fields < 2 || messageId > UINT16_MAX || command.timeNs < previousNs)
+      {
+         fprintf(stderr, "%s:%u: bad command\n", path, lineNumber);
+         success = false;
+      }
+
+      previousNs = command.timeNs;
+      commands.push_back(command);
+   }
+
+   fclose(file);
+
+   return (success);
+}
+
+/******************************************************************************/
+static void BuildCommand(uint16_t messageId, uint8_t* message)
+{
+   // The id comes from the command line or a script, so only the header is
+   // known; every request data block is zero here.
+   IONWEncodeHeader(messageId, m_theIONwControlMessageDataBytesBlockSizeBytes, message);
+}
+
+/******************************************************************************/
+static void RunCommand(
+      GLResourceMain& resource,
+      GLVirtualClock& virtualClock,
+      IONetworkMemoryTransport& transport,
+      GLTimeHelper& wallClock,
+      const SIM_COMMAND_TYPE& command,
+      SIM_RESULT_TYPE& result)
+{
+   uint8_t message[m_theIoNwControlMessageFixedLengthBytes];
+
+   virtualClock.SetTimeInNs(command.timeNs);
+   resource.TimerWheel().Advance();
+
+   BuildCommand(command.messageId, message);
+   transport.InjectMessage(message, m_theIoNwControlMessageFixedLengthBytes, command.sourceIp);
+
+   uint64_t startNs = wallClock.GetTimeInNs();
+   resource.InterfaceManager().ProcessReceivedMessages();
+   result.processingNs.push_back(static_cast<uint32_t>(
+         std::min<uint64_t>(wallClock.GetTimeInNs() - startNs, UINT32_MAX)));
+   result.commands++;
+
+   // The checksum covers what was sent and when, in virtual time.
+   IO_MEMORY_DATAGRAM_TYPE datagram;
+   while (transport.TakeSentMessage(datagram))
+   {
+      uint64_t nowNs = virtualClock.GetTimeInNs();
+
+      for (uint32_t index = 0; index < sizeof(nowNs); index++)
+      {
+         result.checksum = (result.checksum ^ ((nowNs >> (index * 8)) & 0xff)) * GLSMChecksumPrime;
+      }
+      for (int32_t index = 0; index < datagram.len; index++)
+      {
+         result.checksum = (result.checksum ^ datagram.data[index]) * GLSMChecksumPrime;
+      }
+      result.responses++;
+   }
+}
+
+/******************************************************************************/
+static uint32_t Percentile(std::vector<uint32_t>& samples, double fraction)
+{
+   if (samples.empty())
+   {
+      return 0;
+   }
+
+   size_t index = std::min(
+         static_cast<size_t>(fraction * static_cast<double>(samples.size())),
+         samples.size() - 1);
+   std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+
+   return samples[index];
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   uint64_t commandCount = GLSMDefaultCommands;
+   uint64_t intervalUs = GLSMDefaultIntervalUs;
+   uint16_t messageId = IONW_CONTROL_MSG_PING_INTERFACE;
+   const char* scriptPath = nullptr;
+   double speed = 0.0;
+   bool verbose = false;
+   int option;
+
+   while ((option = getopt(argc, argv, "n:i:m:s:x:vh")) != -1)
+   {
+      switch (option)
+      {
+         case 'n':
+            commandCount = strtoull(optarg, nullptr, 10);
+            break;
+
+         case 'i':
+            intervalUs = strtoull(optarg, nullptr, 10);
+            break;
+
+         case 'm':
+            messageId = static_cast<uint16_t>(strtoul(optarg, nullptr, 0));
+            break;
+
+         case 's':
+            scriptPath = optarg;
+            break;
+
+         case 'x':
+            speed = atof(optarg);
+            break;
+
+         case 'v':
+            verbose = true;
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr,
+                  "usage: %s [-n commands] [-i interval_us] [-m message_id] "
+                  "[-s script] [-x speed] [-v]\n",
+                  argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   std::vector<SIM_COMMAND_TYPE> script;
+   if (scriptPath != nullptr)
+   {
+      if (!ReadScript(scriptPath, script))
+      {
+         return 1;
+      }
+      commandCount = script.size();
+   }
+
+   GLVirtualClock virtualClock;
+   auto transportPtr = std::make_unique<IONetworkMemoryTransport>();
+   IONetworkMemoryTransport& transport = *transportPtr;
+   GLResourceMain resource(virtualClock, std::move(transportPtr));
+   GLTimeHelper wallClock(GLTH_TIMESTAMP_MODE_FROM_SYSTEM_START, GLTH_CLOCK_SOURCE_MONOTONIC);
+   SIM_RESULT_TYPE result;
+
+   result.processingNs.reserve(commandCount);
+
+   // Returns at once: the memory transport is driven from this loop.
+   resource.AppStart();
+
+   uint64_t wallStartNs = wallClock.GetTimeInNs();
+
+   for (uint64_t index = 0; index < commandCount && transport.Active(); index++)
+   {
+      SIM_COMMAND_TYPE generated;
+      if (scriptPath == nullptr)
+      {
+         generated.timeNs = index * intervalUs * 1000;
+         generated.messageId = messageId;
+         generated.sourceIp = GLSMDefaultSourceIp;
+      }
+      const SIM_COMMAND_TYPE& command = (scriptPath == nullptr) ? generated : script[index];
+
+      if (speed > 0.0)
+      {
+         uint64_t dueNs = wallStartNs + static_cast<uint64_t>(static_cast<double>(command.timeNs) / speed);
+         uint64_t nowNs = wallClock.GetTimeInNs();
+         if (dueNs > nowNs)
+         {
+            usleep(static_cast<useconds_t>((dueNs - nowNs) / 1000));
+         }
+      }
+
+      RunCommand(resource, virtualClock, transport, wallClock, command, result);
+   }
+
+   uint64_t wallNs = wallClock.GetTimeInNs() - wallStartNs;
+   uint64_t virtualNs = virtualClock.GetTimeInNs();
+
+   resource.AppStop();
+
+   printf("Simulated %lu commands over %.3f s virtual time in %.3f s (%.0f commands/s)\n",
+         result.commands,
+         static_cast<double>(virtualNs) / 1e9,
+         static_cast<double>(wallNs) / 1e9,
+         (wallNs > 0) ? static_cast<double>(result.commands) * 1e9 / static_cast<double>(wallNs) : 0.0);
+   printf("Responses %lu, dropped %lu, checksum 0x%016lx\n",
+         result.responses,
+         transport.MessagesDropped(),
+         result.checksum);
+   printf("Processing per command: p50 %u ns  p99 %u ns  p99.9 %u ns  max %u ns\n",
+         Percentile(result.processingNs, 0.50),
+         Percentile(result.processingNs, 0.99),
+         Percentile(result.processingNs, 0.999),
+         Percentile(result.processingNs, 1.0));
+
+   if (verbose)
+   {
+      resource.EventLog().PrintEventLogEntries();
+      resource.ErrorLog().PrintErrorLogEntries();
+   }
+
+   return 0;
+}
+
+/******************************************************************************/
@@ -0,0 +1,467 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkLoadGenTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-loadgen tool.  It drives
+   a running server with libucrp-client, one client per -c, for -d seconds
+   and reports the throughput it achieved, the requests lost (no response
+   after the client's last attempt) and the latency percentiles.
+
+   With -r the clients together send rate requests per second on a fixed
+   schedule, whether or not responses keep up (open loop).  Latency is then
+   taken from the time a request was due, not the time it went out, so a
+   full window or a stalled server shows up as latency instead of a lower
+   send rate.  With -r 0 every client sends as fast as its window allows
+   (closed loop), which measures capacity.  -w is at most
+   IONCLMaximumWindow, the responses the server caches per client, so a
+   lost response can still be replayed.
+
+   The message mix is a list of name:weight pairs, picked at random per
+   request:
+
+      ping       PING_INTERFACE with IONW_PING_FLAG_TIMESTAMPS
+      version    GET_SOC_SW_VERSION_STRING
+      clock      CLOCK_SYNC
+
+   Only requests answered on the client's own port can be measured.  -f
+   csv and -f json print one record per run, to collect across builds.
+
+   usage: ucrp-loadgen [-a address] [-p port] [-c clients] [-r rate]
+                       [-d seconds] [-w window] [-m mix] [-f format] [-1]
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "IONetworkClient.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const char* IOLGDefaultAddress = "127.0.0.1";
+static const uint32_t IOLGDefaultClients = 1;
+static const uint32_t IOLGDefaultRate = 1000;
+static const uint32_t IOLGDefaultDurationSec = 5;
+static const char* IOLGDefaultMix = "ping:1";
+static const uint64_t IOLGNanosecondsPerSecond = 1000000000;
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef enum
+{
+   IOLG_MSG_PING,
+   IOLG_MSG_VERSION,
+   IOLG_MSG_CLOCK
+} IOLoadGenMsgType;
+
+typedef enum
+{
+   IOLG_FORMAT_TEXT,
+   IOLG_FORMAT_CSV,
+   IOLG_FORMAT_JSON
+} IOLoadGenFormatType;
+
+typedef struct loadgen_mix_struct
+{
+   IOLoadGenMsgType msg;
+   const char* name;
+   uint16_t responseId;
+   uint32_t weight;
+} IO_LOADGEN_MIX_TYPE;
+
+// Written by one client's thread through the callbacks; read after Stop().
+typedef struct loadgen_client_struct
+{
+   std::unique_ptr<IONetworkClient> client;
+   std::vector<int64_t> latencyNs;
+   uint64_t sent = 0;
+   uint64_t completed = 0;
+   uint64_t lost = 0;
+   uint64_t unexpected = 0;      // answered with another message id
+} IO_LOADGEN_CLIENT_TYPE;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static uint64_t SteadyTimeNs()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/******************************************************************************/
+static uint64_t RealtimeNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_REALTIME, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * IOLGNanosecondsPerSecond +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
+/******************************************************************************/
+// Parses "ping:80,version:10,clock:10".
+static bool ParseMix(const std::string& text, std::vector<IO_LOADGEN_MIX_TYPE>& mix)
+{
+   static const IO_LOADGEN_MIX_TYPE known[] =
+   {
+      {IOLG_MSG_PING, "ping", IONW_CONTROL_MSG_PING_INTERFACE_RSP, 0},
+      {IOLG_MSG_VERSION, "version", IONW_CONTROL_MSG_GET_SOC_SW_VERSION_STRING_RSP, 0},
+      {IOLG_MSG_CLOCK, "clock", IONW_CONTROL_MSG_CLOCK_SYNC_RSP, 0},
+   };
+   size_t start = 0;
+
+   mix.clear();
+   while (start < text.size())
+   {
+      size_t end = text.find(',', start);
+      if (end == std::string::npos)
+      {
+         end = text.size();
+      }
+
+      std::string item = text.substr(start, end - start);
+      size_t colon = item.find(':');
+      std::string name = item.substr(0, colon);
+      uint32_t weight = (colon == std::string::npos) ? 1 :
+            static_cast<uint32_t>(strtoul(item.c_str() + colon + 1, nullptr, 10));
+
+      const IO_LOADGEN_MIX_TYPE* entry = std::find_if(
+            std::begin(known), std::end(known),
+            [&name](const IO_LOADGEN_MIX_TYPE& k) { return name == k.name; });
+      if (entry == std::end(known))
+      {
+         fprintf(stderr, "unknown message %s in mix\n", name.c_str());
+         return (false);
+      }
+
+      if (weight > 0)
+      {
+         mix.push_back(*entry);
+         mix.back().weight = weight;
+      }
+      start = end + 1;
+   }
+
+   return (!mix.empty());
+}
+
+/******************************************************************************/
+static std::string MixString(const std::vector<IO_LOADGEN_MIX_TYPE>& mix)
+{
+   std::string text;
+
+   for (const IO_LOADGEN_MIX_TYPE& entry : mix)
+   {
+      text += (text.empty() ? "" : ",") + std::string(entry.name) + ":" + std::to_string(entry.weight);
+   }
+
+   return (text);
+}
+
+/******************************************************************************/
+static void SendOne(
+      IO_LOADGEN_CLIENT_TYPE& state,
+      const IO_LOADGEN_MIX_TYPE& entry,
+      uint64_t dueNs)
+{
+   uint16_t responseId = entry.responseId;
+   IONetworkClientCallback callback =
+         [&state, dueNs, responseId](IO_CLIENT_RESPONSE_TYPE& response)
+   {
+      if (response.result != IONCL_RESULT_SUCCESS)
+      {
+         state.lost++;
+      }
+      else if (response.msgId != responseId)
+      {
+         state.unexpected++;
+      }
+      else
+      {
+         state.latencyNs.push_back(static_cast<int64_t>(SteadyTimeNs() - dueNs));
+         state.completed++;
+      }
+   };
+
+   switch (entry.msg)
+   {
+      case IOLG_MSG_PING:
+      {
+         IONW_PING_INTERFACE_TYPE ping;
+         ping.clientTxNs = RealtimeNs();
+         ping.sequence = static_cast<uint32_t>(state.sent);
+         ping.flags = IONW_PING_FLAG_TIMESTAMPS;
+         state.client->Send(ping, std::move(callback));
+         break;
+      }
+
+      case IOLG_MSG_VERSION:
+         state.client->Send(IONW_CONTROL_MSG_GET_SOC_SW_VERSION_STRING, nullptr, 0, std::move(callback));
+         break;
+
+      case IOLG_MSG_CLOCK:
+      {
+         IONW_CLOCK_SYNC_TYPE sync;
+         sync.clientTxNs = RealtimeNs();
+         sync.sequence = static_cast<uint16_t>(state.sent);
+         state.client->Send(sync, std::move(callback));
+         break;
+      }
+   }
+
+   state.sent++;
+}
+
+/******************************************************************************/
+// Sends until endNs; every intervalNs when paced, else as the window allows.
+static void SenderThread(
+      IO_LOADGEN_CLIENT_TYPE& state,
+      const std::vector<IO_LOADGEN_MIX_TYPE>& mix,
+      uint32_t seed,
+      uint64_t startNs,
+      uint64_t endNs,
+      uint64_t intervalNs)
+{
+   std::vector<uint32_t> weights;
+   for (const IO_LOADGEN_MIX_TYPE& entry : mix)
+   {
+      weights.push_back(entry.weight);
+   }
+
+   std::mt19937 generator(seed);
+   std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+   uint64_t dueNs = startNs;
+
+   while (true)
+   {
+      uint64_t nowNs = SteadyTimeNs();
+
+      if (intervalNs > 0)
+      {
+         if (dueNs >= endNs)
+         {
+            break;
+         }
+         if (dueNs > nowNs)
+         {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(dueNs - nowNs));
+         }
+      }
+      else
+      {
+         if (nowNs >= endNs)
+         {
+            break;
+         }
+         dueNs = nowNs;
+      }
+
+      SendOne(state, mix[pick(generator)], dueNs);
+      dueNs += intervalNs;
+   }
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   const char* address = IOLGDefaultAddress;
+   uint16_t port = IONCLDefaultServerPort;
+   uint32_t clients = IOLGDefaultClients;
+   uint32_t rate = IOLGDefaultRate;
+   uint32_t durationSec = IOLGDefaultDurationSec;
+   std::string mixText = IOLGDefaultMix;
+   IOLoadGenFormatType format = IOLG_FORMAT_TEXT;
+   IO_CLIENT_OPTIONS_TYPE options;
+   int option;
+
+   while ((option = getopt(argc, argv, "a:p:c:r:d:w:m:f:1h")) != -1)
+   {
+      switch (option)
+      {
+         case 'a':
+            address = optarg;
+            break;
+
+         case 'p':
+            port = static_cast<uint16_t>(atoi(optarg));
+            break;
+
+         case 'c':
+            clients = std::max<uint32_t>(1, static_cast<uint32_t>(strtoul(optarg, nullptr, 10)));
+            break;
+
+         case 'r':
+            rate = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+         case 'd':
+            durationSec = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+         case 'w':
+            options.window = static_cast<uint16_t>(std::min<unsigned long>(
+                  std::max<unsigned long>(1, strtoul(optarg, nullptr, 10)), IONCLMaximumWindow));
+            break;
+
+         case 'm':
+            mixText = optarg;
+            break;
+
+         case 'f':
+            format = (std::string(optarg) == "csv") ? IOLG_FORMAT_CSV :
+                  (std::string(optarg) == "json") ? IOLG_FORMAT_JSON : IOLG_FORMAT_TEXT;
+            break;
+
+         case '1':
+            options.compact = false;
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr,
+                  "usage: %s [-a address] [-p port] [-c clients] [-r rate] [-d seconds] "
+                  "[-w window] [-m mix] [-f text|csv|json] [-1]\n",
+                  argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   std::vector<IO_LOADGEN_MIX_TYPE> mix;
+   if (!ParseMix(mixText, mix))
+   {
+      return 1;
+   }
+
+   std::vector<IO_LOADGEN_CLIENT_TYPE> states(clients);
+   for (IO_LOADGEN_CLIENT_TYPE& state : states)
+   {
+      state.client = std::make_unique<IONetworkClient>(options);
+      if (!state.client->Start(address, port))
+      {
+         fprintf(stderr, "cannot start a client for %s:%u\n", address, port);
+         return 1;
+      }
+   }
+
+   // Each client takes its share of the rate, offset so that the clients
+   // do not all send at the same instant.
+   uint64_t intervalNs = (rate > 0) ?
+         IOLGNanosecondsPerSecond * clients / rate : 0;
+   uint64_t startNs = SteadyTimeNs();
+   uint64_t endNs = startNs + durationSec * IOLGNanosecondsPerSecond;
+   std::vector<std::thread> senders;
+
+   for (uint32_t index = 0; index < clients; index++)
+   {
+      senders.emplace_back(SenderThread, std::ref(states[index]), std::cref(mix), index + 1,
+            startNs + intervalNs * index / clients, endNs, intervalNs);
+   }
+   for (std::thread& sender : senders)
+   {
+      sender.join();
+   }
+
+   uint64_t sent = 0;
+   uint64_t completed = 0;
+   uint64_t lost = 0;
+   uint64_t unexpected = 0;
+   uint64_t retransmits = 0;
+   std::vector<int64_t> latencyNs;
+
+   for (IO_LOADGEN_CLIENT_TYPE& state : states)
+   {
+      state.client->Drain();
+      state.client->Stop();
+      sent += state.sent;
+      completed += state.completed;
+      lost += state.lost;
+      unexpected += state.unexpected;
+      retransmits += state.client->Retransmits();
+      latencyNs.insert(latencyNs.end(), state.latencyNs.begin(), state.latencyNs.end());
+   }
+
+   // Throughput is over the sending period; responses drained after it
+   // count toward the total.
+   double elapsedSec = static_cast<double>(endNs - startNs) / 1.0e9;
+   double throughput = static_cast<double>(completed) / elapsedSec;
+   double lossPercent = (sent > 0) ? 100.0 * static_cast<double>(lost) / static_cast<double>(sent) : 0.0;
+
+   std::sort(latencyNs.begin(), latencyNs.end());
+   auto at = [&latencyNs](double fraction)
+   {
+      if (latencyNs.empty())
+      {
+         return 0.0;
+      }
+      size_t index = std::min(
+            static_cast<size_t>(fraction * static_cast<double>(latencyNs.size())),
+            latencyNs.size() - 1);
+      return static_cast<double>(latencyNs[index]) / 1000.0;
+   };
+
+   std::string mixString = MixString(mix);
+
+   switch (format)
+   {
+      case IOLG_FORMAT_CSV:
+         printf("clients,window,rate,duration_s,mix,sent,completed,lost,unexpected,retransmits,"
+               "throughput_rps,loss_pct,p50_us,p90_us,p99_us,p999_us,max_us\n");
+         printf("%u,%u,%u,%u,\"%s\",%lu,%lu,%lu,%lu,%lu,%.1f,%.3f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+               clients, options.window, rate, durationSec, mixString.c_str(),
+               sent, completed, lost, unexpected, retransmits, throughput, lossPercent,
+               at(0.50), at(0.90), at(0.99), at(0.999), at(1.0));
+         break;
+
+      case IOLG_FORMAT_JSON:
+         printf("{\"clients\": %u, \"window\": %u, \"rate\": %u, \"duration_s\": %u, \"mix\": \"%s\", "
+               "\"sent\": %lu, \"completed\": %lu, \"lost\": %lu, \"unexpected\": %lu, "
+               "\"retransmits\": %lu, \"throughput_rps\": %.1f, \"loss_pct\": %.3f, "
+               "\"latency_us\": {\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"p999\": %.1f, "
+               "\"max\": %.1f}}\n",
+               clients, options.window, rate, durationSec, mixString.c_str(),
+               sent, completed, lost, unexpected, retransmits, throughput, lossPercent,
+               at(0.50), at(0.90), at(0.99), at(0.999), at(1.0));
+         break;
+
+      case IOLG_FORMAT_TEXT:
+         printf("%u clients, window %u, %s, %u s, mix %s\n",
+               clients, options.window,
+               (rate > 0) ? (std::to_string(rate) + " requests/s").c_str() : "closed loop",
+               durationSec, mixString.c_str());
+         printf("%lu sent, %lu completed, %lu lost (%.3f%%), %lu unexpected, %lu retransmits\n",
+               sent, completed, lost, lossPercent, unexpected, retransmits);
+         printf("throughput %.1f responses/s\n", throughput);
+         printf("latency    p50 %10.1f  p90 %10.1f  p99 %10.1f  p99.9 %10.1f  max %10.1f us\n",
+               at(0.50), at(0.90), at(0.99), at(0.999), at(1.0));
+         break;
+   }
+
+   return (lost == 0 && unexpected == 0) ? 0 : 1;
+}
+
+/******************************************************************************/
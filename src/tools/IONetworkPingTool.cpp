@@ -0,0 +1,460 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkPingTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-ping tool.  It sends
+   timestamped PING_INTERFACE messages and takes four times per probe: its
+   own send time t1, the server's receive time t2 and transmit time t3 from
+   the PING_INTERFACE_RSP, and its own kernel receive time t4.  From these
+   it reports
+
+      rtt         t4 - t1
+      server      t3 - t2, time spent inside the server
+      network     rtt - server
+      asymmetry   (t2 - t1) - (t4 - t3), outbound minus inbound one-way
+                  time; it includes twice the clock offset between the
+                  hosts, so it is only meaningful with synchronized clocks
+
+   With -s it runs CLOCK_SYNC exchanges instead.  Each exchange gives an
+   offset (server timeline minus this host's CLOCK_REALTIME) and a delay;
+   the lowest delay sample is the best one, on this side and, over the last
+   exchanges, on the server.  A server log timestamp T is this host's time
+   T - offset.
+
+   With -2 the requests, and so the responses, use the compact header of
+   format version 2.
+
+   usage: ucrp-ping [-a address] [-p port] [-c count] [-i interval_ms]
+                    [-w timeout_ms] [-q] [-s] [-2]
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "IONetworkControlMessages.h"
+#include "IONetworkControlPayloads.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const char* IOPTDefaultAddress = "127.0.0.1";
+static const int32_t IOPTDefaultPort = m_theIoNwControlInterfacePort;
+static const uint32_t IOPTDefaultCount = 100;
+static const uint32_t IOPTDefaultIntervalMs = 10;
+static const uint32_t IOPTDefaultTimeoutMs = 1000;
+static const uint64_t IOPTNanosecondsPerSecond = 1000000000;
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef struct ping_samples_struct
+{
+   std::vector<int64_t> rttNs;
+   std::vector<int64_t> serverNs;
+   std::vector<int64_t> networkNs;
+   std::vector<int64_t> asymmetryNs;
+   uint32_t kernelStamped = 0;
+} PING_SAMPLES_TYPE;
+
+/******************************************************************************/
+static uint64_t RealtimeNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_REALTIME, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * IOPTNanosecondsPerSecond +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
+/******************************************************************************/
+// Waits for the response to sequence; earlier, late responses are skipped.
+template <typename Response>
+static bool ReceiveResponse(
+      int sockfd,
+      uint32_t sequence,
+      uint32_t timeoutMs,
+      Response& response,
+      uint64_t& receiveTimeNs)
+{
+   uint64_t deadlineNs = RealtimeNs() + static_cast<uint64_t>(timeoutMs) * 1000000;
+   uint8_t message[m_theIoNwControlMessageMaximumLengthBytes];
+
+   while (true)
+   {
+      uint64_t nowNs = RealtimeNs();
+      if (nowNs >= deadlineNs)
+      {
+         return (false);
+      }
+
+      struct pollfd pfd = {sockfd, POLLIN, 0};
+      if (poll(&pfd, 1, static_cast<int>((deadlineNs - nowNs) / 1000000) + 1) <= 0)
+      {
+         continue;
+      }
+
+      char control[CMSG_SPACE(sizeof(struct timespec))];
+      struct iovec iov = {message, sizeof(message)};
+      struct msghdr msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+
+      ssize_t len = recvmsg(sockfd, &msg, 0);
+      receiveTimeNs = RealtimeNs();
+
+      for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+      {
+         if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+         {
+            struct timespec stamp;
+            memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+            receiveTimeNs = static_cast<uint64_t>(stamp.tv_sec) * IOPTNanosecondsPerSecond +
+                  static_cast<uint64_t>(stamp.tv_nsec);
+         }
+      }
+
+      if (IONWDecodeMessage(message, static_cast<int32_t>(len), response) &&
+         response.sequence == sequence)
+      {
+         return (true);
+      }
+   }
+}
+
+/******************************************************************************/
+template <typename Request>
+static bool SendRequest(int sockfd, const Request& request, uint16_t sequence, bool compact)
+{
+   ssize_t sent = 0;
+
+   if (compact)
+   {
+      auto message = IONWEncodeCompact(request, sequence);
+      sent = send(sockfd, message.data(), message.size(), 0);
+   }
+   else
+   {
+      auto message = IONWEncode(request);
+      sent = send(sockfd, message.data(), message.size(), 0);
+   }
+
+   if (sent < 0)
+   {
+      perror("send");
+      return (false);
+   }
+
+   return (true);
+}
+
+/******************************************************************************/
+static int RunClockSync(
+      int sockfd,
+      uint32_t count,
+      uint32_t intervalMs,
+      uint32_t timeoutMs,
+      bool quiet,
+      bool compact)
+{
+   uint32_t previousRoundTripNs = 0;
+   uint32_t received = 0;
+   bool haveBest = false;
+   int64_t bestOffsetNs = 0;
+   int64_t bestDelayNs = 0;
+   bool serverOffsetValid = false;
+   int64_t serverOffsetNs = 0;
+   uint32_t serverDelayNs = 0;
+   uint64_t timelineEpochNs = 0;
+
+   for (uint32_t index = 0; index < count; index++)
+   {
+      IONW_CLOCK_SYNC_TYPE request;
+      IONW_CLOCK_SYNC_RSP_TYPE response;
+      uint16_t sequence = static_cast<uint16_t>(index);
+      uint64_t t4 = 0;
+
+      request.sequence = sequence;
+      request.previousRoundTripNs = previousRoundTripNs;
+      request.clientTxNs = RealtimeNs();
+      uint64_t t1 = request.clientTxNs;
+
+      if (!SendRequest(sockfd, request, static_cast<uint16_t>(sequence), compact))
+      {
+         return 1;
+      }
+
+      previousRoundTripNs = 0;
+
+      if (ReceiveResponse(sockfd, sequence, timeoutMs, response, t4))
+      {
+         uint64_t t2 = response.serverRxNs;
+         uint64_t t3 = response.serverTxNs;
+
+         int64_t offset = (static_cast<int64_t>(t2 - t1) + static_cast<int64_t>(t3 - t4)) / 2;
+         int64_t delay = static_cast<int64_t>(t4 - t1) - static_cast<int64_t>(t3 - t2);
+
+         if (!haveBest || delay < bestDelayNs)
+         {
+            bestOffsetNs = offset;
+            bestDelayNs = delay;
+            haveBest = true;
+         }
+
+         serverOffsetValid = (response.flags & IONW_CLOCK_SYNC_FLAG_OFFSET_VALID) != 0;
+         serverOffsetNs = response.offsetNs;
+         serverDelayNs = response.delayNs;
+         timelineEpochNs = response.timelineEpochNs;
+         previousRoundTripNs = static_cast<uint32_t>(std::min<uint64_t>(t4 - t1, UINT32_MAX));
+         received++;
+
+         if (!quiet)
+         {
+            printf("seq=%u delay=%.1f us offset=%ld ns", sequence,
+                  static_cast<double>(delay) / 1000.0, offset);
+            if (serverOffsetValid)
+            {
+               printf("  server best of %u: delay=%.1f us offset=%ld ns",
+                     response.samples,
+                     static_cast<double>(serverDelayNs) / 1000.0, serverOffsetNs);
+            }
+            printf("\n");
+         }
+      }
+      else if (!quiet)
+      {
+         printf("seq=%u timeout\n", sequence);
+      }
+
+      if (intervalMs > 0 && index + 1 < count)
+      {
+         usleep(intervalMs * 1000);
+      }
+   }
+
+   printf("\n%u sent, %u received, %u lost\n", count, received, count - received);
+
+   if (haveBest)
+   {
+      // Where this host puts the timeline's zero, against where the server
+      // puts it: the difference is how far apart the two wall clocks are.
+      printf("best offset %ld ns at delay %.1f us\n",
+            bestOffsetNs, static_cast<double>(bestDelayNs) / 1000.0);
+      if (serverOffsetValid)
+      {
+         printf("server filtered offset %ld ns at delay %.1f us\n",
+               serverOffsetNs, static_cast<double>(serverDelayNs) / 1000.0);
+      }
+      printf("server timeline epoch %lu ns, on this clock %ld ns, difference %+.1f us\n",
+            timelineEpochNs, -bestOffsetNs,
+            static_cast<double>(-bestOffsetNs - static_cast<int64_t>(timelineEpochNs)) / 1000.0);
+   }
+
+   return (received == count) ? 0 : 1;
+}
+
+/******************************************************************************/
+static void PrintPercentiles(const char* name, std::vector<int64_t>& samples)
+{
+   if (samples.empty())
+   {
+      return;
+   }
+
+   std::sort(samples.begin(), samples.end());
+
+   auto at = [&samples](double fraction)
+   {
+      size_t index = std::min(
+            static_cast<size_t>(fraction * static_cast<double>(samples.size())),
+            samples.size() - 1);
+      return static_cast<double>(samples[index]) / 1000.0;
+   };
+
+   printf("%-10s min %10.1f  p50 %10.1f  p90 %10.1f  p99 %10.1f  max %10.1f us\n",
+         name, at(0.0), at(0.50), at(0.90), at(0.99), at(1.0));
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   const char* address = IOPTDefaultAddress;
+   int32_t port = IOPTDefaultPort;
+   uint32_t count = IOPTDefaultCount;
+   uint32_t intervalMs = IOPTDefaultIntervalMs;
+   uint32_t timeoutMs = IOPTDefaultTimeoutMs;
+   bool quiet = false;
+   bool clockSync = false;
+   bool compact = false;
+   int option;
+
+   while ((option = getopt(argc, argv, "a:p:c:i:w:qs2h")) != -1)
+   {
+      switch (option)
+      {
+         case 'a':
+            address = optarg;
+            break;
+
+         case 'p':
+            port = atoi(optarg);
+            break;
+
+         case 'c':
+            count = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+         case 'i':
+            intervalMs = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+         case 'w':
+            timeoutMs = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+         case 'q':
+            quiet = true;
+            break;
+
+         case 's':
+            clockSync = true;
+            break;
+
+         case '2':
+            compact = true;
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr,
+                  "usage: %s [-a address] [-p port] [-c count] [-i interval_ms] "
+                  "[-w timeout_ms] [-q] [-s] [-2]\n",
+                  argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   struct sockaddr_in server;
+   memset(&server, 0, sizeof(server));
+   server.sin_family = AF_INET;
+   server.sin_port = htons(static_cast<uint16_t>(port));
+   if (inet_pton(AF_INET, address, &server.sin_addr) != 1)
+   {
+      fprintf(stderr, "bad address %s\n", address);
+      return 1;
+   }
+
+   int sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+   int enable = 1;
+   if (sockfd < 0 ||
+      setsockopt(sockfd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0 ||
+      connect(sockfd, reinterpret_cast<struct sockaddr*>(&server), sizeof(server)) != 0)
+   {
+      perror("socket");
+      return 1;
+   }
+
+   if (clockSync)
+   {
+      int result = RunClockSync(sockfd, count, intervalMs, timeoutMs, quiet, compact);
+      close(sockfd);
+      return result;
+   }
+
+   PING_SAMPLES_TYPE samples;
+   uint32_t received = 0;
+
+   for (uint32_t sequence = 0; sequence < count; sequence++)
+   {
+      IONW_PING_INTERFACE_TYPE request;
+      IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE response;
+      uint64_t t4 = 0;
+
+      request.sequence = sequence;
+      request.flags = IONW_PING_FLAG_TIMESTAMPS;
+      request.clientTxNs = RealtimeNs();
+      uint64_t t1 = request.clientTxNs;
+
+      if (!SendRequest(sockfd, request, static_cast<uint16_t>(sequence), compact))
+      {
+         return 1;
+      }
+
+      if (ReceiveResponse(sockfd, sequence, timeoutMs, response, t4))
+      {
+         uint64_t t2 = response.serverRxNs;
+         uint64_t t3 = response.serverTxNs;
+
+         int64_t rtt = static_cast<int64_t>(t4 - t1);
+         int64_t server = static_cast<int64_t>(t3 - t2);
+         int64_t asymmetry = static_cast<int64_t>(t2 - t1) - static_cast<int64_t>(t4 - t3);
+
+         samples.rttNs.push_back(rtt);
+         samples.serverNs.push_back(server);
+         samples.networkNs.push_back(rtt - server);
+         samples.asymmetryNs.push_back(asymmetry);
+         if ((response.flags & IONW_PING_FLAG_KERNEL_RX_TIME) != 0)
+         {
+            samples.kernelStamped++;
+         }
+         received++;
+
+         if (!quiet)
+         {
+            printf("seq=%u rtt=%.1f us server=%.1f us network=%.1f us asymmetry=%+.1f us\n",
+                  sequence,
+                  static_cast<double>(rtt) / 1000.0,
+                  static_cast<double>(server) / 1000.0,
+                  static_cast<double>(rtt - server) / 1000.0,
+                  static_cast<double>(asymmetry) / 1000.0);
+         }
+      }
+      else if (!quiet)
+      {
+         printf("seq=%u timeout\n", sequence);
+      }
+
+      if (intervalMs > 0 && sequence + 1 < count)
+      {
+         usleep(intervalMs * 1000);
+      }
+   }
+
+   close(sockfd);
+
+   printf("\n%u sent, %u received, %u lost, %u with kernel receive time at the server\n",
+         count, received, count - received, samples.kernelStamped);
+   PrintPercentiles("rtt", samples.rttNs);
+   PrintPercentiles("server", samples.serverNs);
+   PrintPercentiles("network", samples.networkNs);
+   PrintPercentiles("asymmetry", samples.asymmetryNs);
+
+   return (received == count) ? 0 : 1;
+}
+
+/******************************************************************************/
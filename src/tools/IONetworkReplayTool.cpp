@@ -0,0 +1,1218 @@
+/******************************************************************************/
+/*  UDP Command Response Protocol Server                                      */
+/*  Copyright © 2023 Mark Nispel                                              */
+/*  All rights reserved                                                       */
+/*  Unauthorized use, distribution or duplication is                          */
+/*  strictly prohibited without written authorization.                        */
+/******************************************************************************/
+/**
+   @file IONetworkReplayTool.cpp
+   @author Mark Nispel
+   @date Oct 18, 2026
+   @version 1.0
+   @brief FILE NOTES:
+   This file contains the main method of the ucrp-replay tool.  It records
+   the commands clients send to a server, with their timing and the
+   responses they got, into a trace file, and replays a trace against a
+   server to benchmark it with real traffic.
+
+   Recording, one of:
+
+      -i capture.pcap -o trace.ucrt
+            from a pcap file: the server's flight recorder dump, or a
+            tcpdump capture (raw IP, Ethernet or Linux cooked link types)
+      -l listen_port -o trace.ucrt [-d seconds]
+            as a proxy: clients send to listen_port, each one is forwarded
+            to the server from a socket of its own, until -d seconds pass
+            or SIGINT
+
+   A datagram with a message id below 0x8000 is a command; one above is a
+   response and belongs to the latest command from the host it goes to.
+   Responses sent to the fixed server port (the first tools' replies) are
+   kept in the trace but cannot be received on replay.  The shutdown
+   commands, telemetry pushes and alarm notifications are left out of a
+   trace, and ignored on replay.
+
+   Replay, with -t trace.ucrt or -t capture.pcap: every recorded client
+   gets a socket of its own and sends its commands, as recorded, at their
+   recorded offsets divided by -x speed (1 as recorded, 0 as fast as the
+   window allows).  Each response received is matched to the oldest
+   command of that client still waiting for that message id (and header
+   sequence, when numbered) and compared with the recorded one, except
+   the fields that differ on every run: server times, clock offsets,
+   transfer ids, datagram counts, sensor readings and their age.  A
+   GET_TELEMETRY_HISTORY_RSP holds as many rows as the server has kept and
+   is compared by its status alone.  It reports the latency, command sent
+   to last response, and every difference found.
+
+   The trace file is big endian:
+
+      "UCRT" u32, version u16, client count u16,
+      per client: IPv4 address u32, port u16
+      per command: offset from the first command in us u32, client u16,
+         length u16, command bytes, response count u8,
+         per response: flags u8 (1: sent to the server port), length u16,
+            response bytes
+
+   usage: ucrp-replay -i capture.pcap -o trace.ucrt [-p port]
+          ucrp-replay -l listen_port -o trace.ucrt [-a address] [-p port]
+                      [-d seconds]
+          ucrp-replay -t trace [-a address] [-p port] [-x speed]
+                      [-w timeout_ms] [-n window] [-v]
+*/
+/******************************************************************************/
+/*       I N C L U D E S                                                      */
+/******************************************************************************/
+#include <algorithm>
+#include <arpa/inet.h>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "IONetworkControlCodec.h"
+#include "IONetworkControlMessage.h"
+#include "IONetworkControlMessages.h"
+#include "IONetworkControlPayloads.h"
+
+using namespace MDN;
+
+/******************************************************************************/
+/*                        C O N S T A N T S                                   */
+/******************************************************************************/
+static const char* IORPDefaultAddress = "127.0.0.1";
+static const uint16_t IORPDefaultPort = m_theIoNwControlInterfacePort;
+static const uint32_t IORPDefaultTimeoutMs = 1000;
+static const uint32_t IORPDefaultWindow = 64;
+static const uint32_t IORPTraceMagic = 0x55435254;   // "UCRT"
+static const uint16_t IORPTraceVersion = 1;
+static const uint8_t IORPResponseToServerPort = 0x01;
+static const uint16_t IORPFirstResponseId = 0x8000;
+static const uint32_t IORPDiffsShown = 20;
+static const uint64_t IORPNanosecondsPerSecond = 1000000000;
+
+// pcap
+static const uint32_t IORPPcapMagicMicroseconds = 0xa1b2c3d4;
+static const uint32_t IORPPcapMagicNanoseconds = 0xa1b23c4d;
+static const uint32_t IORPLinkTypeEthernet = 1;
+static const uint32_t IORPLinkTypeRaw = 101;
+static const uint32_t IORPLinkTypeLinuxCooked = 113;
+static const uint32_t IORPLinkTypeIpv4 = 228;
+static const uint32_t IORPLinkTypeLinuxCooked2 = 276;
+static const uint8_t IORPIpProtocolUdp = 17;
+
+/******************************************************************************/
+/*       G L O B A L  V A R S                                                 */
+/******************************************************************************/
+static volatile sig_atomic_t m_StopRequested = 0;
+
+/******************************************************************************/
+/*       D E C L A R A T I O N S                                              */
+/******************************************************************************/
+typedef struct trace_response_struct
+{
+   uint8_t flags = 0;
+   std::vector<uint8_t> message;
+} TRACE_RESPONSE_TYPE;
+
+typedef struct trace_command_struct
+{
+   uint64_t offsetNs = 0;
+   uint16_t client = 0;
+   std::vector<uint8_t> message;
+   std::vector<TRACE_RESPONSE_TYPE> responses;
+} TRACE_COMMAND_TYPE;
+
+typedef struct trace_client_struct
+{
+   uint32_t address = 0;         // host byte order
+   uint16_t port = 0;
+} TRACE_CLIENT_TYPE;
+
+typedef struct trace_struct
+{
+   std::vector<TRACE_CLIENT_TYPE> clients;
+   std::vector<TRACE_COMMAND_TYPE> commands;
+} TRACE_TYPE;
+
+// A replayed command waiting for responses.
+typedef struct replay_pending_struct
+{
+   uint32_t command;
+   uint64_t sentNs;
+   std::vector<const TRACE_RESPONSE_TYPE*> expected;
+} REPLAY_PENDING_TYPE;
+
+typedef struct replay_result_struct
+{
+   uint64_t commandsSent = 0;
+   uint64_t commandsVerified = 0;    // every response received and equal
+   uint64_t commandsDiffering = 0;
+   uint64_t commandsIncomplete = 0;  // a response missing
+   uint64_t responsesUnverifiable = 0;
+   uint64_t responsesUnexpected = 0;
+   std::vector<int64_t> latencyNs;
+   std::vector<std::string> diffs;
+} REPLAY_RESULT_TYPE;
+
+/******************************************************************************/
+/*       L O C A L  F U N C T I O N S                                         */
+/******************************************************************************/
+static void SignalHandler(int)
+{
+   m_StopRequested = 1;
+}
+
+/******************************************************************************/
+static uint64_t MonotonicNs()
+{
+   struct timespec tm;
+
+   clock_gettime(CLOCK_MONOTONIC, &tm);
+
+   return static_cast<uint64_t>(tm.tv_sec) * IORPNanosecondsPerSecond +
+         static_cast<uint64_t>(tm.tv_nsec);
+}
+
+/******************************************************************************/
+static uint64_t ReadBigEndian(const uint8_t* location, uint32_t bytes)
+{
+   uint64_t value = 0;
+   while (bytes-- > 0)
+   {
+      value = (value << 8) | *location++;
+   }
+   return value;
+}
+
+/******************************************************************************/
+static void AppendBigEndian(std::vector<uint8_t>& bytes, uint64_t value, uint32_t count)
+{
+   while (count > 0)
+   {
+      count--;
+      bytes.push_back(static_cast<uint8_t>(value >> (count * 8)));
+   }
+}
+
+/******************************************************************************/
+static bool ControlMessage(const uint8_t* message, size_t len)
+{
+   if (IONWCompactMessage(message, static_cast<int32_t>(len)))
+   {
+      return (true);
+   }
+
+   return (len >= m_theIoNwControlMessageHeaderSizeBytes &&
+         ReadBigEndian(message, m_theSyncPatternSizeBytes) == m_theIoNetworkControlMsgHeaderSyncPattern);
+}
+
+/******************************************************************************/
+static uint16_t MessageId(const std::vector<uint8_t>& message)
+{
+   bool compact = IONWCompactMessage(message.data(), static_cast<int32_t>(message.size()));
+   return static_cast<uint16_t>(ReadBigEndian(
+         &message[compact ? IONWCompactMsgIdIndex : IONWHeaderMsgIdIndex], 2));
+}
+
+/******************************************************************************/
+static uint16_t Sequence(const std::vector<uint8_t>& message)
+{
+   bool compact = IONWCompactMessage(message.data(), static_cast<int32_t>(message.size()));
+   return static_cast<uint16_t>(ReadBigEndian(
+         &message[compact ? IONWCompactSequenceIndex : IONWHeaderReservedIndex], 2));
+}
+
+/******************************************************************************/
+static uint32_t HeaderBytes(const std::vector<uint8_t>& message)
+{
+   return IONWCompactMessage(message.data(), static_cast<int32_t>(message.size())) ?
+         IONWCompactHeaderSizeBytes : m_theIoNwControlMessageHeaderSizeBytes;
+}
+
+/******************************************************************************/
+// Adds a datagram seen at timeNs to trace: a command starts a new entry, a
+// response joins the latest command from the host it goes to.
+static void AddDatagram(
+      TRACE_TYPE& trace,
+      std::map<uint64_t, uint16_t>& clientIndex,
+      std::map<uint32_t, uint32_t>& latestByHost,
+      std::map<uint64_t, uint32_t>& latestByClient,
+      uint64_t& firstNs,
+      uint64_t timeNs,
+      uint32_t sourceAddress,
+      uint16_t sourcePort,
+      uint32_t destinationAddress,
+      uint16_t destinationPort,
+      uint16_t serverPort,
+      const uint8_t* payload,
+      size_t len)
+{
+   if (!ControlMessage(payload, len))
+   {
+      return;
+   }
+
+   std::vector<uint8_t> message(payload, payload + len);
+   uint16_t msgId = MessageId(message);
+
+   // Pushes and alarms answer no command and come on their own schedule.
+   if (msgId == IONW_CONTROL_MSG_SHUTDOWN_INTERFACE || msgId == IONW_CONTROL_MSG_REQUEST_APP_SHUTDOWN ||
+      msgId == IONW_CONTROL_MSG_TELEMETRY_PUSH || msgId == IONW_CONTROL_MSG_ALARM_NOTIFY)
+   {
+      return;
+   }
+
+   if (msgId < IORPFirstResponseId)
+   {
+      uint64_t key = (static_cast<uint64_t>(sourceAddress) << 16) | sourcePort;
+      auto client = clientIndex.find(key);
+      if (client == clientIndex.end())
+      {
+         TRACE_CLIENT_TYPE newClient;
+         newClient.address = sourceAddress;
+         newClient.port = sourcePort;
+         trace.clients.push_back(newClient);
+         client = clientIndex.emplace(key, static_cast<uint16_t>(trace.clients.size() - 1)).first;
+      }
+
+      if (trace.commands.empty())
+      {
+         firstNs = timeNs;
+      }
+
+      TRACE_COMMAND_TYPE command;
+      command.offsetNs = (timeNs > firstNs) ? timeNs - firstNs : 0;
+      command.client = client->second;
+      command.message = std::move(message);
+      trace.commands.push_back(std::move(command));
+
+      latestByHost[sourceAddress] = static_cast<uint32_t>(trace.commands.size());
+      latestByClient[key] = static_cast<uint32_t>(trace.commands.size());
+      return;
+   }
+
+   uint32_t commandNumber = 0;
+   TRACE_RESPONSE_TYPE response;
+   response.message = std::move(message);
+
+   if (destinationPort == serverPort)
+   {
+      response.flags = IORPResponseToServerPort;
+      commandNumber = latestByHost[destinationAddress];
+   }
+   else
+   {
+      commandNumber = latestByClient[(static_cast<uint64_t>(destinationAddress) << 16) | destinationPort];
+   }
+
+   if (commandNumber > 0)
+   {
+      trace.commands[commandNumber - 1].responses.push_back(std::move(response));
+   }
+}
+
+/******************************************************************************/
+static bool ReadPcap(const char* path, uint16_t serverPort, TRACE_TYPE& trace)
+{
+   FILE* file = fopen(path, "rb");
+
+   if (file == nullptr)
+   {
+      fprintf(stderr, "cannot open %s\n", path);
+      return (false);
+   }
+
+   uint32_t header[6];
+   if (fread(header, sizeof(header), 1, file) != 1 ||
+      (header[0] != IORPPcapMagicMicroseconds && header[0] != IORPPcapMagicNanoseconds))
+   {
+      fprintf(stderr, "%s: not a pcap file in this host's byte order\n", path);
+      fclose(file);
+      return (false);
+   }
+
+   uint32_t fractionNs = (header[0] == IORPPcapMagicNanoseconds) ? 1 : 1000;
+   uint32_t linkType = header[5] & 0xffff;
+   uint32_t linkBytes = 0;
+
+   switch (linkType)
+   {
+      case IORPLinkTypeEthernet:
+         linkBytes = 14;
+         break;
+
+      case IORPLinkTypeRaw:
+      case IORPLinkTypeIpv4:
+         linkBytes = 0;
+         break;
+
+      case IORPLinkTypeLinuxCooked:
+         linkBytes = 16;
+         break;
+
+      case IORPLinkTypeLinuxCooked2:
+         linkBytes = 20;
+         break;
+
+      default:
+         fprintf(stderr, "%s: link type %u not supported\n", path, linkType);
+         fclose(file);
+         return (false);
+   }
+
+   std::map<uint64_t, uint16_t> clientIndex;
+   std::map<uint32_t, uint32_t> latestByHost;
+   std::map<uint64_t, uint32_t> latestByClient;
+   uint64_t firstNs = 0;
+   uint32_t record[4];
+   std::vector<uint8_t> packet;
+
+   while (fread(record, sizeof(record), 1, file) == 1)
+   {
+      packet.resize(record[2]);
+      if (record[2] > 0 && fread(packet.data(), record[2], 1, file) != 1)
+      {
+         break;
+      }
+
+      // IPv4 UDP only.
+      if (packet.size() < linkBytes + 28)
+      {
+         continue;
+      }
+      const uint8_t* ip = packet.data() + linkBytes;
+      uint32_t ipHeaderBytes = (ip[0] & 0x0f) * 4;
+      if ((ip[0] >> 4) != 4 || ip[9] != IORPIpProtocolUdp ||
+         packet.size() < linkBytes + ipHeaderBytes + 8)
+      {
+         continue;
+      }
+      const uint8_t* udp = ip + ipHeaderBytes;
+      size_t udpBytes = ReadBigEndian(&udp[4], 2);
+      size_t available = packet.size() - linkBytes - ipHeaderBytes;
+      if (udpBytes < 8 || udpBytes > available)
+      {
+         continue;
+      }
+
+      uint64_t timeNs = static_cast<uint64_t>(record[0]) * IORPNanosecondsPerSecond +
+            static_cast<uint64_t>(record[1]) * fractionNs;
+
+      AddDatagram(trace, clientIndex, latestByHost, latestByClient, firstNs, timeNs,
+            static_cast<uint32_t>(ReadBigEndian(&ip[12], 4)),
+            static_cast<uint16_t>(ReadBigEndian(&udp[0], 2)),
+            static_cast<uint32_t>(ReadBigEndian(&ip[16], 4)),
+            static_cast<uint16_t>(ReadBigEndian(&udp[2], 2)),
+            serverPort,
+            udp + 8,
+            udpBytes - 8);
+   }
+
+   fclose(file);
+
+   return (true);
+}
+
+/******************************************************************************/
+static bool WriteTrace(const char* path, const TRACE_TYPE& trace)
+{
+   std::vector<uint8_t> bytes;
+
+   AppendBigEndian(bytes, IORPTraceMagic, 4);
+   AppendBigEndian(bytes, IORPTraceVersion, 2);
+   AppendBigEndian(bytes, trace.clients.size(), 2);
+   for (const TRACE_CLIENT_TYPE& client : trace.clients)
+   {
+      AppendBigEndian(bytes, client.address, 4);
+      AppendBigEndian(bytes, client.port, 2);
+   }
+
+   for (const TRACE_COMMAND_TYPE& command : trace.commands)
+   {
+      AppendBigEndian(bytes, std::min<uint64_t>(command.offsetNs / 1000, UINT32_MAX), 4);
+      AppendBigEndian(bytes, command.client, 2);
+      AppendBigEndian(bytes, command.message.size(), 2);
+      bytes.insert(bytes.end(), command.message.begin(), command.message.end());
+
+      size_t responses = std::min<size_t>(command.responses.size(), UINT8_MAX);
+      AppendBigEndian(bytes, responses, 1);
+      for (size_t index = 0; index < responses; index++)
+      {
+         const TRACE_RESPONSE_TYPE& response = command.responses[index];
+         AppendBigEndian(bytes, response.flags, 1);
+         AppendBigEndian(bytes, response.message.size(), 2);
+         bytes.insert(bytes.end(), response.message.begin(), response.message.end());
+      }
+   }
+
+   FILE* file = fopen(path, "wb");
+   if (file == nullptr)
+   {
+      fprintf(stderr, "cannot open %s\n", path);
+      return (false);
+   }
+
+   bool success = (fwrite(bytes.data(), bytes.size(), 1, file) == 1);
+   success = (fclose(file) == 0) && success;
+
+   return (success);
+}
+
+/******************************************************************************/
+static bool ReadTrace(const char* path, TRACE_TYPE& trace)
+{
+   FILE* file = fopen(path, "rb");
+
+   if (file == nullptr)
+   {
+      fprintf(stderr, "cannot open %s\n", path);
+      return (false);
+   }
+
+   std::vector<uint8_t> bytes;
+   uint8_t buffer[4096];
+   size_t read;
+   while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+   {
+      bytes.insert(bytes.end(), buffer, buffer + read);
+   }
+   fclose(file);
+
+   size_t offset = 0;
+   auto take = [&bytes, &offset](uint32_t count, uint64_t& value)
+   {
+      if (offset + count > bytes.size())
+      {
+         return (false);
+      }
+      value = ReadBigEndian(&bytes[offset], count);
+      offset += count;
+      return (true);
+   };
+   auto takeMessage = [&bytes, &offset](uint64_t len, std::vector<uint8_t>& message)
+   {
+      if (offset + len > bytes.size())
+      {
+         return (false);
+      }
+      message.assign(bytes.begin() + offset, bytes.begin() + offset + len);
+      offset += len;
+      return (true);
+   };
+
+   uint64_t magic = 0;
+   uint64_t version = 0;
+   uint64_t clients = 0;
+   if (!take(4, magic) || !take(2, version) || !take(2, clients) ||
+      magic != IORPTraceMagic || version != IORPTraceVersion)
+   {
+      fprintf(stderr, "%s: not a version %u trace\n", path, IORPTraceVersion);
+      return (false);
+   }
+
+   for (uint64_t index = 0; index < clients; index++)
+   {
+      uint64_t address = 0;
+      uint64_t port = 0;
+      if (!take(4, address) || !take(2, port))
+      {
+         fprintf(stderr, "%s: truncated\n", path);
+         return (false);
+      }
+      TRACE_CLIENT_TYPE client;
+      client.address = static_cast<uint32_t>(address);
+      client.port = static_cast<uint16_t>(port);
+      trace.clients.push_back(client);
+   }
+
+   while (offset < bytes.size())
+   {
+      TRACE_COMMAND_TYPE command;
+      uint64_t offsetUs = 0;
+      uint64_t client = 0;
+      uint64_t len = 0;
+      uint64_t responses = 0;
+
+      if (!take(4, offsetUs) || !take(2, client) || !take(2, len) ||
+         !takeMessage(len, command.message) || !take(1, responses) ||
+         client >= trace.clients.size() || len < IONWCompactHeaderSizeBytes)
+      {
+         fprintf(stderr, "%s: bad command %zu\n", path, trace.commands.size());
+         return (false);
+      }
+      command.offsetNs = offsetUs * 1000;
+      command.client = static_cast<uint16_t>(client);
+
+      for (uint64_t index = 0; index < responses; index++)
+      {
+         TRACE_RESPONSE_TYPE response;
+         uint64_t flags = 0;
+         if (!take(1, flags) || !take(2, len) || !takeMessage(len, response.message) ||
+            len < IONWCompactHeaderSizeBytes)
+         {
+            fprintf(stderr, "%s: bad response of command %zu\n", path, trace.commands.size());
+            return (false);
+         }
+         response.flags = static_cast<uint8_t>(flags);
+         command.responses.push_back(std::move(response));
+      }
+
+      trace.commands.push_back(std::move(command));
+   }
+
+   return (true);
+}
+
+/******************************************************************************/
+static bool ReadTraceOrPcap(const char* path, uint16_t serverPort, TRACE_TYPE& trace)
+{
+   FILE* file = fopen(path, "rb");
+   uint32_t magic = 0;
+
+   if (file != nullptr)
+   {
+      if (fread(&magic, sizeof(magic), 1, file) != 1)
+      {
+         magic = 0;
+      }
+      fclose(file);
+   }
+
+   if (magic == IORPPcapMagicMicroseconds || magic == IORPPcapMagicNanoseconds)
+   {
+      return (ReadPcap(path, serverPort, trace));
+   }
+
+   return (ReadTrace(path, trace));
+}
+
+/******************************************************************************/
+// Marks the data bytes of a response that change from run to run.  Offsets
+// are into the data block.
+static void MarkVolatile(uint16_t msgId, const uint8_t* data, size_t dataBytes, std::vector<bool>& mask)
+{
+   auto mark = [&mask, dataBytes](size_t from, size_t to)
+   {
+      for (size_t index = from; index < std::min(to, dataBytes); index++)
+      {
+         mask[index] = true;
+      }
+   };
+
+   switch (msgId)
+   {
+      case IONW_CONTROL_MSG_PING_INTERFACE_RSP:
+      {
+         // Server receive and transmit times, the last two fields.
+         using Schema = IONWSchema<IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE>;
+         mark(Schema::Fields::OffsetOf<&IONW_TIMESTAMPED_PING_INTERFACE_RSP_TYPE::serverRxNs>(),
+               Schema::dataBytes);
+         break;
+      }
+
+      case IONW_CONTROL_MSG_CLOCK_SYNC_RSP:
+      {
+         // Times, offset, delay, timeline epoch: all from the receive time on.
+         using Schema = IONWSchema<IONW_CLOCK_SYNC_RSP_TYPE>;
+         mark(Schema::Fields::OffsetOf<&IONW_CLOCK_SYNC_RSP_TYPE::serverRxNs>(),
+               Schema::dataBytes);
+         break;
+      }
+
+      case IONW_CONTROL_MSG_SEGMENT_RSP:
+         mark(2, 4);          // transfer id
+         break;
+
+      case IONW_CONTROL_MSG_DUMP_CAPTURE_RSP:
+         mark(2, 6);          // datagrams written
+         break;
+
+      case IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_RSP:
+      case IONW_CONTROL_MSG_GET_SOC_VOLTAGE_RSP:
+         mark(4, dataBytes);  // sample age, readings
+         break;
+
+      case IONW_CONTROL_MSG_GET_SOC_TEMPERATURE_LIMIT_RSP:
+      case IONW_CONTROL_MSG_GET_SOC_LIMIT_RSP:
+         mark(4, 8);          // sample age
+         break;
+
+      case IONW_CONTROL_MSG_BATCH_RSP:
+      {
+         // Each entry's response data is compared as if sent on its own.
+         size_t offset = IONWSchema<IONW_BATCH_RSP_TYPE>::dataBytes;
+         const size_t entryBytes = IONWSchema<IONW_BATCH_RSP_ENTRY_TYPE>::dataBytes;
+         while (offset + entryBytes <= dataBytes)
+         {
+            uint16_t responseId = static_cast<uint16_t>(ReadBigEndian(&data[offset + 2], 2));
+            size_t entryDataBytes = ReadBigEndian(&data[offset + 4], 2);
+            offset += entryBytes;
+            if (offset + entryDataBytes > dataBytes)
+            {
+               break;
+            }
+
+            std::vector<bool> entryMask(entryDataBytes, false);
+            MarkVolatile(responseId, &data[offset], entryDataBytes, entryMask);
+            for (size_t index = 0; index < entryDataBytes; index++)
+            {
+               mask[offset + index] = entryMask[index];
+            }
+            offset += entryDataBytes;
+         }
+         break;
+      }
+
+      default:
+         break;
+   }
+}
+
+/******************************************************************************/
+// Empty when received equals recorded outside the volatile fields.
+static std::string CompareResponse(
+      const std::vector<uint8_t>& recorded,
+      const uint8_t* received,
+      size_t len)
+{
+   char text[160];
+   uint32_t headerBytes = HeaderBytes(recorded);
+
+   if (MessageId(recorded) == IONW_CONTROL_MSG_GET_TELEMETRY_HISTORY_RSP)
+   {
+      size_t statusBytes = IONWWire<uint16_t>::size;
+      if (len < headerBytes + statusBytes || recorded.size() < headerBytes + statusBytes ||
+         !std::equal(received + headerBytes, received + headerBytes + statusBytes, recorded.begin() + headerBytes))
+      {
+         return ("status differs");
+      }
+      return ("");
+   }
+
+   if (len != recorded.size())
+   {
+      snprintf(text, sizeof(text), "length %zu, recorded %zu", len, recorded.size());
+      return (text);
+   }
+
+   std::vector<bool> mask(len, false);
+   std::vector<bool> dataMask(len - headerBytes, false);
+
+   MarkVolatile(MessageId(recorded), received + headerBytes, len - headerBytes, dataMask);
+   std::copy(dataMask.begin(), dataMask.end(), mask.begin() + headerBytes);
+
+   uint32_t differing = 0;
+   size_t first = 0;
+   for (size_t index = 0; index < len; index++)
+   {
+      if (!mask[index] && received[index] != recorded[index])
+      {
+         if (differing == 0)
+         {
+            first = index;
+         }
+         differing++;
+      }
+   }
+
+   if (differing == 0)
+   {
+      return ("");
+   }
+
+   snprintf(text, sizeof(text), "%u bytes differ, first at %zu: 0x%02x, recorded 0x%02x",
+         differing, first, received[first], recorded[first]);
+   return (text);
+}
+
+/******************************************************************************/
+static int OpenSocket(const char* address, uint16_t port, struct sockaddr_in& server)
+{
+   memset(&server, 0, sizeof(server));
+   server.sin_family = AF_INET;
+   server.sin_port = htons(port);
+   if (inet_pton(AF_INET, address, &server.sin_addr) != 1)
+   {
+      fprintf(stderr, "bad address %s\n", address);
+      return (-1);
+   }
+
+   int sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+   if (sockfd < 0 || connect(sockfd, reinterpret_cast<struct sockaddr*>(&server), sizeof(server)) != 0)
+   {
+      perror("socket");
+      if (sockfd >= 0)
+      {
+         close(sockfd);
+      }
+      return (-1);
+   }
+
+   return (sockfd);
+}
+
+/******************************************************************************/
+static int RecordProxy(
+      const char* address,
+      uint16_t port,
+      uint16_t listenPort,
+      uint32_t durationSec,
+      const char* tracePath)
+{
+   struct sockaddr_in server;
+   struct sockaddr_in listenAddr;
+
+   memset(&listenAddr, 0, sizeof(listenAddr));
+   listenAddr.sin_family = AF_INET;
+   listenAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+   listenAddr.sin_port = htons(listenPort);
+
+   int listenFd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+   if (listenFd < 0 || bind(listenFd, reinterpret_cast<struct sockaddr*>(&listenAddr), sizeof(listenAddr)) != 0)
+   {
+      perror("bind");
+      return 1;
+   }
+
+   signal(SIGINT, SignalHandler);
+   signal(SIGTERM, SignalHandler);
+
+   TRACE_TYPE trace;
+   std::map<uint64_t, uint16_t> clientIndex;
+   std::map<uint32_t, uint32_t> latestByHost;
+   std::map<uint64_t, uint32_t> latestByClient;
+   uint64_t firstNs = 0;
+
+   // One upstream socket per client, so the server tells them apart.
+   std::vector<struct pollfd> pollFds = {{listenFd, POLLIN, 0}};
+   std::vector<struct sockaddr_in> clientAddrs = {listenAddr};
+   std::map<uint64_t, size_t> upstreamByClient;
+   uint8_t message[m_theIoNwControlMessageMaximumLengthBytes + 1];
+   uint64_t endNs = (durationSec > 0) ?
+         MonotonicNs() + static_cast<uint64_t>(durationSec) * IORPNanosecondsPerSecond : UINT64_MAX;
+
+   printf("recording on port %u for %s:%u, SIGINT stops\n", listenPort, address, port);
+
+   while (!m_StopRequested && MonotonicNs() < endNs)
+   {
+      if (poll(pollFds.data(), pollFds.size(), 100) <= 0)
+      {
+         continue;
+      }
+
+      uint64_t nowNs = MonotonicNs();
+
+      if ((pollFds[0].revents & POLLIN) != 0)
+      {
+         struct sockaddr_in source;
+         socklen_t sourceLen = sizeof(source);
+         ssize_t len = recvfrom(listenFd, message, sizeof(message), 0,
+               reinterpret_cast<struct sockaddr*>(&source), &sourceLen);
+         if (len > 0)
+         {
+            uint32_t sourceAddress = ntohl(source.sin_addr.s_addr);
+            uint16_t sourcePort = ntohs(source.sin_port);
+            uint64_t key = (static_cast<uint64_t>(sourceAddress) << 16) | sourcePort;
+
+            auto upstream = upstreamByClient.find(key);
+            if (upstream == upstreamByClient.end())
+            {
+               int upstreamFd = OpenSocket(address, port, server);
+               if (upstreamFd < 0)
+               {
+                  continue;
+               }
+               pollFds.push_back({upstreamFd, POLLIN, 0});
+               clientAddrs.push_back(source);
+               upstream = upstreamByClient.emplace(key, pollFds.size() - 1).first;
+            }
+
+            AddDatagram(trace, clientIndex, latestByHost, latestByClient, firstNs, nowNs,
+                  sourceAddress, sourcePort, 0, port, port, message, static_cast<size_t>(len));
+            send(pollFds[upstream->second].fd, message, static_cast<size_t>(len), 0);
+         }
+      }
+
+      for (size_t index = 1; index < pollFds.size(); index++)
+      {
+         if ((pollFds[index].revents & POLLIN) == 0)
+         {
+            continue;
+         }
+
+         ssize_t len = recv(pollFds[index].fd, message, sizeof(message), 0);
+         if (len > 0)
+         {
+            const struct sockaddr_in& client = clientAddrs[index];
+            AddDatagram(trace, clientIndex, latestByHost, latestByClient, firstNs, nowNs,
+                  0, port, ntohl(client.sin_addr.s_addr), ntohs(client.sin_port), port,
+                  message, static_cast<size_t>(len));
+            sendto(listenFd, message, static_cast<size_t>(len), 0,
+                  reinterpret_cast<const struct sockaddr*>(&client), sizeof(client));
+         }
+      }
+   }
+
+   for (struct pollfd& pfd : pollFds)
+   {
+      close(pfd.fd);
+   }
+
+   printf("%zu commands from %zu clients\n", trace.commands.size(), trace.clients.size());
+
+   return WriteTrace(tracePath, trace) ? 0 : 1;
+}
+
+/******************************************************************************/
+static bool MatchResponse(
+      std::deque<REPLAY_PENDING_TYPE>& pending,
+      const uint8_t* message,
+      size_t len,
+      uint64_t receiveNs,
+      REPLAY_RESULT_TYPE& result,
+      std::vector<bool>& differing)
+{
+   if (!ControlMessage(message, len))
+   {
+      return (false);
+   }
+
+   std::vector<uint8_t> received(message, message + len);
+   uint16_t msgId = MessageId(received);
+   uint16_t sequence = Sequence(received);
+
+   for (auto entry = pending.begin(); entry != pending.end(); ++entry)
+   {
+      for (auto expected = entry->expected.begin(); expected != entry->expected.end(); ++expected)
+      {
+         const std::vector<uint8_t>& recorded = (*expected)->message;
+         if (MessageId(recorded) != msgId || Sequence(recorded) != sequence)
+         {
+            continue;
+         }
+
+         std::string diff = CompareResponse(recorded, message, len);
+         if (!diff.empty())
+         {
+            differing[entry->command] = true;
+            result.diffs.push_back("command " + std::to_string(entry->command) + " " +
+                  IONetworkControlMessage::MessageName(msgId) + ": " + diff);
+         }
+
+         entry->expected.erase(expected);
+         if (entry->expected.empty())
+         {
+            result.latencyNs.push_back(static_cast<int64_t>(receiveNs - entry->sentNs));
+            if (differing[entry->command])
+            {
+               result.commandsDiffering++;
+            }
+            else
+            {
+               result.commandsVerified++;
+            }
+            pending.erase(entry);
+         }
+         return (true);
+      }
+   }
+
+   return (false);
+}
+
+/******************************************************************************/
+static void PrintPercentiles(std::vector<int64_t>& samples)
+{
+   if (samples.empty())
+   {
+      return;
+   }
+
+   std::sort(samples.begin(), samples.end());
+
+   auto at = [&samples](double fraction)
+   {
+      size_t index = std::min(
+            static_cast<size_t>(fraction * static_cast<double>(samples.size())),
+            samples.size() - 1);
+      return static_cast<double>(samples[index]) / 1000.0;
+   };
+
+   printf("latency    min %10.1f  p50 %10.1f  p90 %10.1f  p99 %10.1f  p99.9 %10.1f  max %10.1f us\n",
+         at(0.0), at(0.50), at(0.90), at(0.99), at(0.999), at(1.0));
+}
+
+/******************************************************************************/
+static int Replay(
+      const TRACE_TYPE& trace,
+      const char* address,
+      uint16_t port,
+      double speed,
+      uint32_t timeoutMs,
+      uint32_t window,
+      bool verbose)
+{
+   struct sockaddr_in server;
+   std::vector<struct pollfd> pollFds;
+   std::vector<std::deque<REPLAY_PENDING_TYPE>> pending(trace.clients.size());
+   std::vector<bool> differing(trace.commands.size(), false);
+   REPLAY_RESULT_TYPE result;
+   uint8_t message[m_theIoNwControlMessageMaximumLengthBytes + 1];
+   uint64_t timeoutNs = static_cast<uint64_t>(timeoutMs) * 1000000;
+   size_t outstanding = 0;
+
+   for (size_t index = 0; index < trace.clients.size(); index++)
+   {
+      int sockfd = OpenSocket(address, port, server);
+      if (sockfd < 0)
+      {
+         return 1;
+      }
+      pollFds.push_back({sockfd, POLLIN, 0});
+   }
+
+   uint64_t startNs = MonotonicNs();
+   size_t next = 0;
+
+   while (next < trace.commands.size() || outstanding > 0)
+   {
+      uint64_t nowNs = MonotonicNs();
+
+      // Send what is due; flat out, only while the window has room.
+      while (next < trace.commands.size())
+      {
+         const TRACE_COMMAND_TYPE& command = trace.commands[next];
+         uint64_t dueNs = startNs + ((speed > 0.0) ?
+               static_cast<uint64_t>(static_cast<double>(command.offsetNs) / speed) : 0);
+         if (dueNs > nowNs || (speed <= 0.0 && outstanding >= window))
+         {
+            break;
+         }
+
+         send(pollFds[command.client].fd, command.message.data(), command.message.size(), 0);
+         result.commandsSent++;
+
+         REPLAY_PENDING_TYPE entry;
+         entry.command = static_cast<uint32_t>(next);
+         entry.sentNs = MonotonicNs();
+         for (const TRACE_RESPONSE_TYPE& response : command.responses)
+         {
+            if ((response.flags & IORPResponseToServerPort) != 0)
+            {
+               result.responsesUnverifiable++;
+            }
+            else
+            {
+               entry.expected.push_back(&response);
+            }
+         }
+         if (!entry.expected.empty())
+         {
+            pending[command.client].push_back(std::move(entry));
+            outstanding++;
+         }
+         next++;
+      }
+
+      // Give up on commands waiting longer than the timeout.
+      for (std::deque<REPLAY_PENDING_TYPE>& clientPending : pending)
+      {
+         while (!clientPending.empty() && nowNs > clientPending.front().sentNs + timeoutNs)
+         {
+            result.commandsIncomplete++;
+            result.diffs.push_back("command " + std::to_string(clientPending.front().command) + ": " +
+                  std::to_string(clientPending.front().expected.size()) + " responses missing");
+            clientPending.pop_front();
+            outstanding--;
+         }
+      }
+
+      int waitMs = 1;
+      if (next < trace.commands.size() && speed > 0.0)
+      {
+         uint64_t dueNs = startNs + static_cast<uint64_t>(
+               static_cast<double>(trace.commands[next].offsetNs) / speed);
+         waitMs = (dueNs > nowNs) ? static_cast<int>(std::min<uint64_t>((dueNs - nowNs) / 1000000, 10)) : 0;
+      }
+
+      if (poll(pollFds.data(), pollFds.size(), waitMs) <= 0)
+      {
+         continue;
+      }
+
+      for (size_t index = 0; index < pollFds.size(); index++)
+      {
+         if ((pollFds[index].revents & POLLIN) == 0)
+         {
+            continue;
+         }
+
+         ssize_t len = recv(pollFds[index].fd, message, sizeof(message), MSG_DONTWAIT);
+         if (len <= 0)
+         {
+            continue;
+         }
+
+         size_t before = pending[index].size();
+         std::vector<uint8_t> received(message, message + len);
+         if (ControlMessage(message, static_cast<size_t>(len)) &&
+            (MessageId(received) == IONW_CONTROL_MSG_TELEMETRY_PUSH ||
+            MessageId(received) == IONW_CONTROL_MSG_ALARM_NOTIFY))
+         {
+            continue;
+         }
+         if (!MatchResponse(pending[index], message, static_cast<size_t>(len),
+               MonotonicNs(), result, differing))
+         {
+            result.responsesUnexpected++;
+         }
+         outstanding -= before - pending[index].size();
+      }
+   }
+
+   double elapsedSec = static_cast<double>(MonotonicNs() - startNs) / 1.0e9;
+
+   for (struct pollfd& pfd : pollFds)
+   {
+      close(pfd.fd);
+   }
+
+   printf("%lu commands from %zu clients in %.3f s (%.0f commands/s)\n",
+         result.commandsSent, trace.clients.size(), elapsedSec,
+         static_cast<double>(result.commandsSent) / elapsedSec);
+   printf("%lu verified, %lu differing, %lu incomplete, %lu responses to the server port not checked, "
+         "%lu unexpected responses\n",
+         result.commandsVerified, result.commandsDiffering, result.commandsIncomplete,
+         result.responsesUnverifiable, result.responsesUnexpected);
+   PrintPercentiles(result.latencyNs);
+
+   size_t shown = verbose ? result.diffs.size() : std::min<size_t>(result.diffs.size(), IORPDiffsShown);
+   for (size_t index = 0; index < shown; index++)
+   {
+      printf("  %s\n", result.diffs[index].c_str());
+   }
+   if (shown < result.diffs.size())
+   {
+      printf("  ... %zu more, -v shows all\n", result.diffs.size() - shown);
+   }
+
+   return (result.commandsDiffering == 0 && result.commandsIncomplete == 0) ? 0 : 1;
+}
+
+/******************************************************************************/
+int main(int argc, char* argv[])
+{
+   const char* address = IORPDefaultAddress;
+   uint16_t port = IORPDefaultPort;
+   const char* pcapPath = nullptr;
+   const char* outputPath = nullptr;
+   const char* tracePath = nullptr;
+   uint16_t listenPort = 0;
+   uint32_t durationSec = 0;
+   double speed = 1.0;
+   uint32_t timeoutMs = IORPDefaultTimeoutMs;
+   uint32_t window = IORPDefaultWindow;
+   bool verbose = false;
+   int option;
+
+   while ((option = getopt(argc, argv, "a:p:i:o:l:d:t:x:w:n:vh")) != -1)
+   {
+      switch (option)
+      {
+         case 'a':
+            address = optarg;
+            break;
+
+         case 'p':
+            port = static_cast<uint16_t>(atoi(optarg));
+            break;
+
+         case 'i':
+            pcapPath = optarg;
+            break;
+
+         case 'o':
+            outputPath = optarg;
+            break;
+
+         case 'l':
+            listenPort = static_cast<uint16_t>(atoi(optarg));
+            break;
+
+         case 'd':
+            durationSec = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+         case 't':
+            tracePath = optarg;
+            break;
+
+         case 'x':
+            speed = atof(optarg);
+            break;
+
+         case 'w':
+            timeoutMs = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+            break;
+
+         case 'n':
+            window = std::max<uint32_t>(1, static_cast<uint32_t>(strtoul(optarg, nullptr, 10)));
+            break;
+
+         case 'v':
+            verbose = true;
+            break;
+
+         case 'h':
+         default:
+            fprintf(stderr,
+                  "usage: %s -i capture.pcap -o trace.ucrt [-p port]\n"
+                  "       %s -l listen_port -o trace.ucrt [-a address] [-p port] [-d seconds]\n"
+                  "       %s -t trace [-a address] [-p port] [-x speed] [-w timeout_ms] "
+                  "[-n window] [-v]\n",
+                  argv[0], argv[0], argv[0]);
+            return (option == 'h') ? 0 : 1;
+      }
+   }
+
+   if (pcapPath != nullptr && outputPath != nullptr)
+   {
+      TRACE_TYPE trace;
+      if (!ReadPcap(pcapPath, port, trace) || !WriteTrace(outputPath, trace))
+      {
+         return 1;
+      }
+      printf("%zu commands from %zu clients\n", trace.commands.size(), trace.clients.size());
+      return 0;
+   }
+
+   if (listenPort != 0 && outputPath != nullptr)
+   {
+      return RecordProxy(address, port, listenPort, durationSec, outputPath);
+   }
+
+   if (tracePath != nullptr)
+   {
+      TRACE_TYPE trace;
+      if (!ReadTraceOrPcap(tracePath, port, trace))
+      {
+         return 1;
+      }
+      return Replay(trace, address, port, speed, timeoutMs, window, verbose);
+   }
+
+   fprintf(stderr, "nothing to do, -h for usage\n");
+   return 1;
+}
+
+/******************************************************************************/